@@ -36,6 +36,10 @@
 #include "ns3/ipv4-global-routing-helper.h"
 #include "ns3/packet-sink.h"
 #include "ns3/yans-wifi-channel.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/arp-cache.h"
+#include <cmath>
 
 // This is a simple example in order to show how to configure an IEEE 802.11ax Wi-Fi network.
 //
@@ -51,6 +55,12 @@
 //    |     |
 //   n1     n2
 //
+// With --nStations, the access point serves several stations placed on a circle of
+// radius distance around it, and sends each of them a flow; the offered load is shared
+// between the stations, and the goodput is the sum of the goodputs of the stations.
+// A large BSS, for example --nStations=200 --mcs=5 --frequency=2.4 --simulationTime=0.5,
+// is a benchmark for the per-station state of the access point.
+//
 //Packets in this simulation aren't marked with a QosTag so they are considered
 //belonging to BestEffort Access Class (AC_BE).
 
@@ -58,6 +68,31 @@ using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("he-wifi-network");
 
+/**
+ * Add permanent ARP entries for the access point in the stations, and for the
+ * stations in the access point, so that the flows of a large BSS do not wait for
+ * ARP requests and replies lost in the contention.
+ *
+ * \param apNode the access point
+ * \param staNodes the stations
+ */
+void
+PopulateArpCache (Ptr<Node> apNode, NodeContainer staNodes)
+{
+  Ptr<Ipv4L3Protocol> apIpv4 = apNode->GetObject<Ipv4L3Protocol> ();
+  Ptr<Ipv4Interface> apInterface = apIpv4->GetInterface (1);
+  for (NodeContainer::Iterator i = staNodes.Begin (); i != staNodes.End (); ++i)
+    {
+      Ptr<Ipv4Interface> staInterface = (*i)->GetObject<Ipv4L3Protocol> ()->GetInterface (1);
+      ArpCache::Entry *entry = apInterface->GetArpCache ()->Add (staInterface->GetAddress (0).GetLocal ());
+      entry->SetMacAddress (staInterface->GetDevice ()->GetAddress ());
+      entry->MarkPermanent ();
+      entry = staInterface->GetArpCache ()->Add (apInterface->GetAddress (0).GetLocal ());
+      entry->SetMacAddress (apInterface->GetDevice ()->GetAddress ());
+      entry->MarkPermanent ();
+    }
+}
+
 int main (int argc, char *argv[])
 {
   bool udp = true;
@@ -69,6 +104,7 @@ int main (int argc, char *argv[])
   int mcs = -1; // -1 indicates an unset value
   double minExpectedThroughput = 0;
   double maxExpectedThroughput = 0;
+  uint32_t nStations = 1;
 
   CommandLine cmd;
   cmd.AddValue ("frequency", "Whether working in the 2.4 or 5.0 GHz band (other values gets rejected)", frequency);
@@ -80,6 +116,7 @@ int main (int argc, char *argv[])
   cmd.AddValue ("mcs", "if set, limit testing to a specific MCS (0-11)", mcs);
   cmd.AddValue ("minExpectedThroughput", "if set, simulation fails if the lowest throughput is below this value", minExpectedThroughput);
   cmd.AddValue ("maxExpectedThroughput", "if set, simulation fails if the highest throughput is above this value", maxExpectedThroughput);
+  cmd.AddValue ("nStations", "Number of stations served by the access point", nStations);
   cmd.Parse (argc,argv);
 
   if (useRts)
@@ -121,7 +158,7 @@ int main (int argc, char *argv[])
                 }
 
               NodeContainer wifiStaNode;
-              wifiStaNode.Create (1);
+              wifiStaNode.Create (nStations);
               NodeContainer wifiApNode;
               wifiApNode.Create (1);
 
@@ -176,7 +213,11 @@ int main (int argc, char *argv[])
               Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
 
               positionAlloc->Add (Vector (0.0, 0.0, 0.0));
-              positionAlloc->Add (Vector (distance, 0.0, 0.0));
+              for (uint32_t i = 0; i < nStations; i++)
+                {
+                  double angle = 2 * M_PI * i / nStations;
+                  positionAlloc->Add (Vector (distance * std::cos (angle), distance * std::sin (angle), 0.0));
+                }
               mobility.SetPositionAllocator (positionAlloc);
 
               mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
@@ -190,12 +231,16 @@ int main (int argc, char *argv[])
               stack.Install (wifiStaNode);
 
               Ipv4AddressHelper address;
-              address.SetBase ("192.168.1.0", "255.255.255.0");
+              address.SetBase ("192.168.0.0", "255.255.0.0");
               Ipv4InterfaceContainer staNodeInterface;
               Ipv4InterfaceContainer apNodeInterface;
 
               staNodeInterface = address.Assign (staDevice);
               apNodeInterface = address.Assign (apDevice);
+              if (nStations > 1)
+                {
+                  PopulateArpCache (wifiApNode.Get (0), wifiStaNode);
+                }
 
               /* Setting applications */
               ApplicationContainer serverApp;
@@ -204,17 +249,20 @@ int main (int argc, char *argv[])
                   //UDP flow
                   uint16_t port = 9;
                   UdpServerHelper server (port);
-                  serverApp = server.Install (wifiStaNode.Get (0));
+                  serverApp = server.Install (wifiStaNode);
                   serverApp.Start (Seconds (0.0));
                   serverApp.Stop (Seconds (simulationTime + 1));
 
-                  UdpClientHelper client (staNodeInterface.GetAddress (0), port);
-                  client.SetAttribute ("MaxPackets", UintegerValue (4294967295u));
-                  client.SetAttribute ("Interval", TimeValue (Time ("0.00001"))); //packets/s
-                  client.SetAttribute ("PacketSize", UintegerValue (payloadSize));
-                  ApplicationContainer clientApp = client.Install (wifiApNode.Get (0));
-                  clientApp.Start (Seconds (1.0));
-                  clientApp.Stop (Seconds (simulationTime + 1));
+                  for (uint32_t i = 0; i < nStations; i++)
+                    {
+                      UdpClientHelper client (staNodeInterface.GetAddress (i), port);
+                      client.SetAttribute ("MaxPackets", UintegerValue (4294967295u));
+                      client.SetAttribute ("Interval", TimeValue (Time ("0.00001") * static_cast<int64_t> (nStations))); //packets/s
+                      client.SetAttribute ("PacketSize", UintegerValue (payloadSize));
+                      ApplicationContainer clientApp = client.Install (wifiApNode.Get (0));
+                      clientApp.Start (Seconds (1.0));
+                      clientApp.Stop (Seconds (simulationTime + 1));
+                    }
                 }
               else
                 {
@@ -222,20 +270,23 @@ int main (int argc, char *argv[])
                   uint16_t port = 50000;
                   Address localAddress (InetSocketAddress (Ipv4Address::GetAny (), port));
                   PacketSinkHelper packetSinkHelper ("ns3::TcpSocketFactory", localAddress);
-                  serverApp = packetSinkHelper.Install (wifiStaNode.Get (0));
+                  serverApp = packetSinkHelper.Install (wifiStaNode);
                   serverApp.Start (Seconds (0.0));
                   serverApp.Stop (Seconds (simulationTime + 1));
 
-                  OnOffHelper onoff ("ns3::TcpSocketFactory", Ipv4Address::GetAny ());
-                  onoff.SetAttribute ("OnTime",  StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
-                  onoff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
-                  onoff.SetAttribute ("PacketSize", UintegerValue (payloadSize));
-                  onoff.SetAttribute ("DataRate", DataRateValue (1000000000)); //bit/s
-                  AddressValue remoteAddress (InetSocketAddress (staNodeInterface.GetAddress (0), port));
-                  onoff.SetAttribute ("Remote", remoteAddress);
-                  ApplicationContainer clientApp = onoff.Install (wifiApNode.Get (0));
-                  clientApp.Start (Seconds (1.0));
-                  clientApp.Stop (Seconds (simulationTime + 1));
+                  for (uint32_t i = 0; i < nStations; i++)
+                    {
+                      OnOffHelper onoff ("ns3::TcpSocketFactory", Ipv4Address::GetAny ());
+                      onoff.SetAttribute ("OnTime",  StringValue ("ns3::ConstantRandomVariable[Constant=1]"));
+                      onoff.SetAttribute ("OffTime", StringValue ("ns3::ConstantRandomVariable[Constant=0]"));
+                      onoff.SetAttribute ("PacketSize", UintegerValue (payloadSize));
+                      onoff.SetAttribute ("DataRate", DataRateValue (1000000000 / nStations)); //bit/s
+                      AddressValue remoteAddress (InetSocketAddress (staNodeInterface.GetAddress (i), port));
+                      onoff.SetAttribute ("Remote", remoteAddress);
+                      ApplicationContainer clientApp = onoff.Install (wifiApNode.Get (0));
+                      clientApp.Start (Seconds (1.0));
+                      clientApp.Stop (Seconds (simulationTime + 1));
+                    }
                 }
 
               Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
@@ -246,11 +297,17 @@ int main (int argc, char *argv[])
               uint64_t rxBytes = 0;
               if (udp)
                 {
-                  rxBytes = payloadSize * DynamicCast<UdpServer> (serverApp.Get (0))->GetReceived ();
+                  for (uint32_t i = 0; i < nStations; i++)
+                    {
+                      rxBytes += payloadSize * DynamicCast<UdpServer> (serverApp.Get (i))->GetReceived ();
+                    }
                 }
               else
                 {
-                  rxBytes = DynamicCast<PacketSink> (serverApp.Get (0))->GetTotalRx ();
+                  for (uint32_t i = 0; i < nStations; i++)
+                    {
+                      rxBytes += DynamicCast<PacketSink> (serverApp.Get (i))->GetTotalRx ();
+                    }
                 }
               double throughput = (rxBytes * 8) / (simulationTime * 1000000.0); //Mbit/s
 
@@ -276,8 +333,9 @@ int main (int argc, char *argv[])
                       exit (1);
                     }
                 }
-              //test previous throughput is smaller (for the same mcs)
-              if (throughput > previous)
+              //test previous throughput is smaller (for the same mcs); with several
+              //stations, the contention between the flows makes the goodput vary
+              if (throughput > previous || nStations > 1)
                 {
                   previous = throughput;
                 }
@@ -287,7 +345,7 @@ int main (int argc, char *argv[])
                   exit (1);
                 }
               //test previous throughput is smaller (for the same channel width and GI)
-              if (throughput > prevThroughput [index])
+              if (throughput > prevThroughput [index] || nStations > 1)
                 {
                   prevThroughput [index] = throughput;
                 }
@@ -65,6 +65,10 @@
 //    --wifiType:        select ns3::SpectrumWifiPhy or ns3::YansWifiPhy [ns3::SpectrumWifiPhy]
 //    --errorModelType:  select ns3::NistErrorRateModel or ns3::YansErrorRateModel [ns3::NistErrorRateModel]
 //    --enablePcap:      enable pcap output [false]
+//    --nBystanders:     number of idle stations beyond the AP [0]
+//    --bystanderDistance: meters between the AP and the first idle station [2000]
+//    --maxRange:        MaxRange attribute of the channel, 0 to disable [0]
+//    --minRxPowerDbm:   MinRxPowerDbm attribute of the MultiModelSpectrumChannel [-1e9]
 //
 // By default, the program will step through 64 index values, corresponding
 // to the following MCS, channel width, and guard interval combinations:
@@ -90,6 +94,18 @@
 //
 // selection of index values 32-63 will result in MCS selection 8-15
 // involving two spatial streams
+//
+// The idle stations, 10 m apart on a line, are out of the range of the AP
+// and the STA, but each transmission still reaches them through the
+// channel unless the channel skips them.  Comparing the run time of,
+// for example,
+//
+//   ./waf --run "wifi-spectrum-saturation-example --index=7 --nBystanders=200"
+//   ./waf --run "wifi-spectrum-saturation-example --index=7 --nBystanders=200 --maxRange=1000"
+//   ./waf --run "wifi-spectrum-saturation-example --index=7 --nBystanders=200 --minRxPowerDbm=-110"
+//
+// measures the cost of the receivers beyond the interference range; the
+// throughput is the same in the three runs.
 
 using namespace ns3;
 
@@ -104,6 +120,10 @@ int main (int argc, char *argv[])
   std::string wifiType = "ns3::SpectrumWifiPhy";
   std::string errorModelType = "ns3::NistErrorRateModel";
   bool enablePcap = false;
+  uint32_t nBystanders = 0;
+  double bystanderDistance = 2000;
+  double maxRange = 0;
+  double minRxPowerDbm = -1e9;
 
   CommandLine cmd;
   cmd.AddValue ("simulationTime", "Simulation time in seconds", simulationTime);
@@ -112,6 +132,10 @@ int main (int argc, char *argv[])
   cmd.AddValue ("wifiType", "select ns3::SpectrumWifiPhy or ns3::YansWifiPhy", wifiType);
   cmd.AddValue ("errorModelType", "select ns3::NistErrorRateModel or ns3::YansErrorRateModel", errorModelType);
   cmd.AddValue ("enablePcap", "enable pcap output", enablePcap);
+  cmd.AddValue ("nBystanders", "number of idle stations beyond the AP", nBystanders);
+  cmd.AddValue ("bystanderDistance", "meters between the AP and the first idle station", bystanderDistance);
+  cmd.AddValue ("maxRange", "MaxRange attribute of the channel, 0 to disable", maxRange);
+  cmd.AddValue ("minRxPowerDbm", "MinRxPowerDbm attribute of the MultiModelSpectrumChannel", minRxPowerDbm);
   cmd.Parse (argc,argv);
 
   uint16_t startIndex = 0;
@@ -139,6 +163,8 @@ int main (int argc, char *argv[])
       wifiStaNode.Create (1);
       NodeContainer wifiApNode;
       wifiApNode.Create (1);
+      NodeContainer bystanderNodes;
+      bystanderNodes.Create (nBystanders);
 
       YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
       SpectrumWifiPhyHelper spectrumPhy = SpectrumWifiPhyHelper::Default ();
@@ -147,7 +173,9 @@ int main (int argc, char *argv[])
           YansWifiChannelHelper channel;
           channel.AddPropagationLoss ("ns3::FriisPropagationLossModel");
           channel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
-          phy.SetChannel (channel.Create ());
+          Ptr<YansWifiChannel> yansChannel = channel.Create ();
+          yansChannel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+          phy.SetChannel (yansChannel);
           phy.Set ("TxPowerStart", DoubleValue (1));
           phy.Set ("TxPowerEnd", DoubleValue (1));
 
@@ -187,6 +215,8 @@ int main (int argc, char *argv[])
           Ptr<ConstantSpeedPropagationDelayModel> delayModel
             = CreateObject<ConstantSpeedPropagationDelayModel> ();
           spectrumChannel->SetPropagationDelayModel (delayModel);
+          spectrumChannel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+          spectrumChannel->SetAttribute ("MinRxPowerDbm", DoubleValue (minRxPowerDbm));
 
           spectrumPhy.SetChannel (spectrumChannel);
           spectrumPhy.SetErrorRateModel (errorModelType);
@@ -571,7 +601,9 @@ int main (int argc, char *argv[])
           mac.SetType ("ns3::ApWifiMac",
                        "Ssid", SsidValue (ssid));
           apDevice = wifi.Install (phy, mac, wifiApNode);
-
+          mac.SetType ("ns3::StaWifiMac",
+                       "Ssid", SsidValue (Ssid ("bystanders")));
+          wifi.Install (phy, mac, bystanderNodes);
         }
       else if (wifiType == "ns3::SpectrumWifiPhy")
         {
@@ -581,6 +613,9 @@ int main (int argc, char *argv[])
           mac.SetType ("ns3::ApWifiMac",
                        "Ssid", SsidValue (ssid));
           apDevice = wifi.Install (spectrumPhy, mac, wifiApNode);
+          mac.SetType ("ns3::StaWifiMac",
+                       "Ssid", SsidValue (Ssid ("bystanders")));
+          wifi.Install (spectrumPhy, mac, bystanderNodes);
         }
 
      if ((i <= 7) || (i > 31 && i <= 39))
@@ -617,6 +652,14 @@ int main (int argc, char *argv[])
       mobility.Install (wifiApNode);
       mobility.Install (wifiStaNode);
 
+      Ptr<ListPositionAllocator> bystanderPositionAlloc = CreateObject<ListPositionAllocator> ();
+      for (uint32_t j = 0; j < nBystanders; j++)
+        {
+          bystanderPositionAlloc->Add (Vector (-bystanderDistance - 10.0 * j, 0.0, 0.0));
+        }
+      mobility.SetPositionAllocator (bystanderPositionAlloc);
+      mobility.Install (bystanderNodes);
+
       /* Internet stack*/
       InternetStackHelper stack;
       stack.Install (wifiApNode);
@@ -0,0 +1,331 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::DaryHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+namespace {
+
+/** The number of children of a node. */
+const std::size_t ARITY = 4;
+/**
+ * Index of the root node.  The first ARITY - 1 entries are unused, so
+ * that the children of any node start on a multiple of ARITY.
+ */
+const std::size_t ROOT = ARITY - 1;
+/** Cache line size, in bytes. */
+const std::size_t CACHE_LINE = 64;
+/** Initial capacity of the node array. */
+const std::size_t INITIAL_CAPACITY = 256;
+
+} // unnamed namespace
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<DaryHeapScheduler> ()
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+  : m_nodes (0),
+    m_buffer (0),
+    m_capacity (0),
+    m_last (ROOT - 1),
+    m_sorted (ROOT - 1)
+{
+  NS_LOG_FUNCTION (this);
+  static_assert (sizeof (Node) * ARITY == CACHE_LINE,
+                 "The children of a node must fill a cache line");
+  Reserve ();
+}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  delete [] m_buffer;
+}
+
+bool
+DaryHeapScheduler::IsLess (const Node &a, const Node &b)
+{
+  return a.ts < b.ts || (a.ts == b.ts && a.uid < b.uid);
+}
+
+std::size_t
+DaryHeapScheduler::Parent (std::size_t id)
+{
+  return (id + ARITY * (ARITY - 2)) / ARITY;
+}
+
+std::size_t
+DaryHeapScheduler::FirstChild (std::size_t id)
+{
+  return ARITY * id - ARITY * (ARITY - 2);
+}
+
+void
+DaryHeapScheduler::Reserve (void)
+{
+  if (m_last + 1 < m_capacity)
+    {
+      return;
+    }
+  std::size_t capacity = m_capacity == 0 ? INITIAL_CAPACITY : 2 * m_capacity;
+  NS_LOG_FUNCTION (this << capacity);
+  char *buffer = new char [capacity * sizeof (Node) + CACHE_LINE];
+  std::size_t misalignment = reinterpret_cast<uintptr_t> (buffer) % CACHE_LINE;
+  Node *nodes = reinterpret_cast<Node *> (buffer + (CACHE_LINE - misalignment) % CACHE_LINE);
+  if (m_nodes != 0)
+    {
+      std::memcpy (nodes, m_nodes, (m_last + 1) * sizeof (Node));
+    }
+  delete [] m_buffer;
+  m_buffer = buffer;
+  m_nodes = nodes;
+  m_capacity = capacity;
+}
+
+void
+DaryHeapScheduler::BottomUp (std::size_t id) const
+{
+  Node node = m_nodes[id];
+  while (id > ROOT)
+    {
+      std::size_t parent = Parent (id);
+      if (!IsLess (node, m_nodes[parent]))
+        {
+          break;
+        }
+      m_nodes[id] = m_nodes[parent];
+      id = parent;
+    }
+  m_nodes[id] = node;
+}
+
+void
+DaryHeapScheduler::TopDown (std::size_t id) const
+{
+  Node node = m_nodes[id];
+  while (true)
+    {
+      std::size_t child = FirstChild (id);
+      if (child > m_last)
+        {
+          break;
+        }
+      std::size_t end = std::min (child + ARITY - 1, m_last);
+      std::size_t smallest = child;
+      for (std::size_t i = child + 1; i <= end; i++)
+        {
+          if (IsLess (m_nodes[i], m_nodes[smallest]))
+            {
+              smallest = i;
+            }
+        }
+      if (!IsLess (m_nodes[smallest], node))
+        {
+          break;
+        }
+      m_nodes[id] = m_nodes[smallest];
+      id = smallest;
+    }
+  m_nodes[id] = node;
+}
+
+void
+DaryHeapScheduler::Heapify (void) const
+{
+  if (m_sorted == m_last)
+    {
+      return;
+    }
+  std::size_t inserted = m_last - m_sorted;
+  std::size_t sorted = m_sorted + 1 - ROOT;
+  NS_LOG_FUNCTION (this << inserted << sorted);
+  if (inserted > sorted && m_last > ROOT)
+    {
+      // Rebuild the whole heap bottom-up, which is linear in its size.
+      for (std::size_t i = Parent (m_last); i >= ROOT; i--)
+        {
+          TopDown (i);
+        }
+    }
+  else
+    {
+      for (std::size_t i = m_sorted + 1; i <= m_last; i++)
+        {
+          BottomUp (i);
+        }
+    }
+  m_sorted = m_last;
+}
+
+void
+DaryHeapScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint32_t slot;
+  Payload payload = { ev.impl, ev.key.m_context };
+  if (m_freeSlots.empty ())
+    {
+      slot = m_payloads.size ();
+      m_payloads.push_back (payload);
+    }
+  else
+    {
+      slot = m_freeSlots.back ();
+      m_freeSlots.pop_back ();
+      m_payloads[slot] = payload;
+    }
+  Reserve ();
+  m_last++;
+  Node node = { ev.key.m_ts, ev.key.m_uid, slot };
+  m_nodes[m_last] = node;
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_last < ROOT;
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Heapify ();
+  const Node &node = m_nodes[ROOT];
+  const Payload &payload = m_payloads[node.slot];
+  Scheduler::Event ev;
+  ev.impl = payload.impl;
+  ev.key.m_ts = node.ts;
+  ev.key.m_uid = node.uid;
+  ev.key.m_context = payload.context;
+  return ev;
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveAt (std::size_t id)
+{
+  Node node = m_nodes[id];
+  const Payload &payload = m_payloads[node.slot];
+  Scheduler::Event ev;
+  ev.impl = payload.impl;
+  ev.key.m_ts = node.ts;
+  ev.key.m_uid = node.uid;
+  ev.key.m_context = payload.context;
+  m_freeSlots.push_back (node.slot);
+
+  m_nodes[id] = m_nodes[m_last];
+  m_last--;
+  m_sorted = m_last;
+  if (id <= m_last)
+    {
+      if (id > ROOT && IsLess (m_nodes[id], m_nodes[Parent (id)]))
+        {
+          BottomUp (id);
+        }
+      else
+        {
+          TopDown (id);
+        }
+    }
+  return ev;
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Heapify ();
+  Scheduler::Event ev = RemoveAt (ROOT);
+#if defined (__GNUC__)
+  // The payload of the next event is usually cold, and will only be
+  // needed after the current event has been run.
+  if (!IsEmpty ())
+    {
+      __builtin_prefetch (&m_payloads[m_nodes[ROOT].slot]);
+    }
+#endif
+  return ev;
+}
+
+std::size_t
+DaryHeapScheduler::Find (const Scheduler::EventKey &key) const
+{
+  Node target = { key.m_ts, key.m_uid, 0 };
+  m_stack.clear ();
+  m_stack.push_back (ROOT);
+  while (!m_stack.empty ())
+    {
+      std::size_t id = m_stack.back ();
+      m_stack.pop_back ();
+      const Node &node = m_nodes[id];
+      if (node.uid == key.m_uid)
+        {
+          return id;
+        }
+      if (IsLess (target, node))
+        {
+          // The whole subtree is later than the event.
+          continue;
+        }
+      std::size_t child = FirstChild (id);
+      std::size_t end = std::min (child + ARITY - 1, m_last);
+      for (std::size_t i = child; i <= end; i++)
+        {
+          m_stack.push_back (i);
+        }
+    }
+  NS_FATAL_ERROR ("Event " << key.m_uid << " not found");
+  return 0;
+}
+
+void
+DaryHeapScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  Heapify ();
+  RemoveAt (Find (ev.key));
+}
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::DaryHeapScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a cache-friendly 4-ary heap event scheduler
+ *
+ * The heap only holds 16-byte sort keys (timestamp, uid and the index
+ * of a slot holding the event implementation and context), so that the
+ * four children of a node fill exactly one 64-byte cache line: the
+ * array is cache-line aligned and the root is placed at index 3, which
+ * makes every group of siblings start on a cache line boundary.  A
+ * top-down heapify then touches one cache line per level, and the heap
+ * has half as many levels as a binary heap.
+ *
+ * Inserted events are appended to the array and only moved to their
+ * position in the heap when the next event is needed.  If many events
+ * were inserted in the meantime (e.g., the initial population of a
+ * simulation, or a batch of events with context), the whole heap is
+ * rebuilt bottom-up in linear time instead of percolating every event.
+ *
+ * Removing a specific event looks for it in the heap, skipping the
+ * subtrees whose root is later than the event.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DaryHeapScheduler ();
+  /** Destructor. */
+  virtual ~DaryHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** A heap node: the sort key of an event and the slot of its payload. */
+  struct Node
+  {
+    uint64_t ts;    //!< Event time stamp.
+    uint32_t uid;   //!< Event unique id.
+    uint32_t slot;  //!< Index of the event in the payload array.
+  };
+  /** The part of an event which does not take part in the sort. */
+  struct Payload
+  {
+    EventImpl *impl;   //!< Pointer to the event implementation.
+    uint32_t context;  //!< Event context.
+  };
+
+  /**
+   * Compare (less than) two nodes.
+   *
+   * \param [in] a The first node.
+   * \param [in] b The second node.
+   * \returns \c true if \c a < \c b
+   */
+  static inline bool IsLess (const Node &a, const Node &b);
+  /**
+   * \param [in] id A node index.
+   * \returns The index of the parent of \p id.
+   */
+  static inline std::size_t Parent (std::size_t id);
+  /**
+   * \param [in] id A node index.
+   * \returns The index of the first child of \p id.
+   */
+  static inline std::size_t FirstChild (std::size_t id);
+  /**
+   * Move a node up to its position in the heap.
+   * \param [in] id The node index.
+   */
+  void BottomUp (std::size_t id) const;
+  /**
+   * Move a node down to its position in the heap.
+   * \param [in] id The node index.
+   */
+  void TopDown (std::size_t id) const;
+  /**
+   * Move the events inserted since the last call to their position
+   * in the heap.
+   */
+  void Heapify (void) const;
+  /**
+   * Make sure the node array can hold one more node.
+   */
+  void Reserve (void);
+  /**
+   * Find an event in the heap.
+   * \param [in] key The event key.
+   * \returns The node index of the event.
+   */
+  std::size_t Find (const Scheduler::EventKey &key) const;
+  /**
+   * Remove the node at an index, and free its payload slot.
+   * \param [in] id The node index.
+   * \returns The removed event.
+   */
+  Scheduler::Event RemoveAt (std::size_t id);
+
+  /*
+   * The heap is logically not modified by PeekNext, but the events
+   * inserted since the previous access must be sorted first.
+   */
+  /** The cache-line aligned node array. */
+  mutable Node *m_nodes;
+  /** The allocated memory holding m_nodes. */
+  char *m_buffer;
+  /** The capacity of m_nodes. */
+  std::size_t m_capacity;
+  /** Index of the last node. */
+  mutable std::size_t m_last;
+  /** Index of the last node in heap order; later nodes are unsorted. */
+  mutable std::size_t m_sorted;
+  /** The event payloads. */
+  std::vector<Payload> m_payloads;
+  /** The free payload slots. */
+  std::vector<uint32_t> m_freeSlots;
+  /** Scratch stack for Find. */
+  mutable std::vector<std::size_t> m_stack;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
@@ -40,6 +40,12 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated from the heap.  Recycling their memory
+ * through free lists of each thread does not make the simulators
+ * faster: the heap allocator of the C library already serves these
+ * small blocks from per-thread caches, and the ListScheduler is slower
+ * when its events are not allocated next to its list nodes.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -65,6 +71,13 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Get the address of the function run by this event, which
+   * identifies it in the profiles (see EventProfiler).
+   *
+   * \returns The address of the function, or \c 0 if unknown.
+   */
+  virtual const void * GetFunction (void) const;
 
 protected:
   /**
@@ -0,0 +1,470 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "make-event.h"
+#include "simulator.h"
+#include "global-value.h"
+#include "string.h"
+#include "enum.h"
+#include "log.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdint.h>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#ifdef HAVE_DLFCN_H
+#include <dlfcn.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+/**
+ * @ingroup simulator
+ * The file to which the event profile is written by
+ * Simulator::Destroy().  Profiling is disabled if empty.
+ */
+static GlobalValue g_profilerOutput = GlobalValue
+  ("EventProfilerOutput",
+   "The file to which the event profile is written, or empty to disable profiling",
+   StringValue (""),
+   MakeStringChecker ());
+
+/**
+ * @ingroup simulator
+ * The format of the event profile.
+ */
+static GlobalValue g_profilerFormat = GlobalValue
+  ("EventProfilerFormat",
+   "The format of the event profile",
+   EnumValue (EventProfiler::REPORT),
+   MakeEnumChecker (EventProfiler::REPORT, "report",
+                    EventProfiler::FOLDED, "folded"));
+
+namespace {
+
+/**
+ * @ingroup simulator
+ * The profile of the current thread, if it has run any profiled events.
+ * Only the singleton profiler uses it.
+ */
+thread_local void *g_profilerTable = 0;
+
+/** Profile totals of a function or a context. */
+struct Totals
+{
+  uint64_t count;  //!< The number of events.
+  uint64_t time;   //!< The wall-clock time, in nanoseconds.
+};
+
+/**
+ * Compare two totals by decreasing time.
+ * \tparam K \deduced The totals key.
+ * \param [in] a The first totals.
+ * \param [in] b The second totals.
+ * \returns \c true if \p a has taken more time than \p b.
+ */
+template <typename K>
+bool
+CompareTime (const std::pair<K, Totals> &a, const std::pair<K, Totals> &b)
+{
+  return a.second.time > b.second.time;
+}
+
+/**
+ * Write a table of totals sorted by decreasing time.
+ * \tparam K \deduced The totals key.
+ * \param [in] os The output stream.
+ * \param [in] totals The totals.
+ * \param [in] time The total time of all the events.
+ * \param [in] title The title of the key column.
+ */
+template <typename K>
+void
+WriteTotals (std::ostream &os, const std::map<K, Totals> &totals,
+             uint64_t time, const std::string &title)
+{
+  std::vector<std::pair<K, Totals> > sorted (totals.begin (), totals.end ());
+  std::stable_sort (sorted.begin (), sorted.end (), CompareTime<K>);
+  os << std::setw (12) << "Time (s)" << std::setw (8) << "%"
+     << std::setw (14) << "Events" << std::setw (12) << "Mean (us)"
+     << "  " << title << std::endl;
+  for (typename std::vector<std::pair<K, Totals> >::const_iterator i = sorted.begin ();
+       i != sorted.end (); ++i)
+    {
+      os << std::fixed
+         << std::setw (12) << std::setprecision (6) << i->second.time / 1e9
+         << std::setw (8) << std::setprecision (2) << (time ? 100.0 * i->second.time / time : 0.0)
+         << std::setw (14) << i->second.count
+         << std::setw (12) << std::setprecision (3) << i->second.time / 1e3 / i->second.count
+         << "  " << i->first << std::endl;
+    }
+}
+
+/**
+ * \param [in] context An event context.
+ * \returns The context as it appears in the profile.
+ */
+std::string
+GetContextName (uint32_t context)
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return "none";
+    }
+  std::ostringstream oss;
+  oss << context;
+  return oss.str ();
+}
+
+} // unnamed namespace
+
+EventProfiler::EventProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EventProfiler::~EventProfiler ()
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Table *>::iterator i = m_tables.begin (); i != m_tables.end (); ++i)
+    {
+      delete *i;
+    }
+  m_tables.clear ();
+}
+
+EventProfiler *
+EventProfiler::GetEnabled (void)
+{
+  StringValue output;
+  g_profilerOutput.GetValue (output);
+  if (output.Get ().empty ())
+    {
+      return 0;
+    }
+  return Get ();
+}
+
+EventProfiler::Table *
+EventProfiler::GetTable (void)
+{
+  if (g_profilerTable == 0)
+    {
+      Table *table = new Table;
+      {
+        CriticalSection cs (m_mutex);
+        m_tables.push_back (table);
+      }
+      g_profilerTable = table;
+    }
+  return static_cast<Table *> (g_profilerTable);
+}
+
+void
+EventProfiler::Invoke (uint32_t context, EventImpl *event)
+{
+  if (event->IsCancelled ())
+    {
+      return;
+    }
+  Key key;
+  key.function = event->GetFunction ();
+  key.type = &typeid (*event);
+  key.context = context;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+  event->Invoke ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+
+  Entry &entry = (*GetTable ())[key];
+  entry.count++;
+  entry.time += std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count ();
+}
+
+std::string
+EventProfiler::GetFunctionName (const std::type_info &type)
+{
+  std::string name = type.name ();
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+
+  // The events made by MakeEvent() are local classes, named after the
+  // MakeEvent() instance, whose first parameter is the function bound
+  // to the event:
+  //   ns3::MakeEvent<MEM, OBJ, ...>(MEM, OBJ, ...)::EventMemberImpl1
+  std::string::size_type pos = name.find ("MakeEvent");
+  if (pos == std::string::npos)
+    {
+      return name;
+    }
+  pos += 9;
+  int depth = 0;
+  std::string::size_type start = std::string::npos;
+  for (; pos < name.size (); ++pos)
+    {
+      char c = name[pos];
+      if (c == '<' || c == '(')
+        {
+          if (c == '(' && depth == 0 && start == std::string::npos)
+            {
+              start = pos + 1;
+            }
+          depth++;
+        }
+      else if (c == '>' || c == ')')
+        {
+          depth--;
+          if (depth == 0 && start != std::string::npos)
+            {
+              break;
+            }
+        }
+      else if (c == ',' && depth == 1 && start != std::string::npos)
+        {
+          break;
+        }
+    }
+  if (start == std::string::npos || pos >= name.size () || pos == start)
+    {
+      return name;
+    }
+  return name.substr (start, pos - start);
+}
+
+const void *
+GetMemberFunctionAddress (const void *memPtr, std::size_t size, const void *obj)
+{
+  // The pointers to class methods are decoded as specified by the
+  // Itanium C++ ABI, which GCC and Clang follow; with other compilers,
+  // the address is unknown.
+#if defined (__GNUC__) && !defined (_WIN32)
+  struct
+  {
+    uintptr_t ptr;
+    ptrdiff_t adj;
+  } rep;
+  if (size != sizeof (rep))
+    {
+      return 0;
+    }
+  std::memcpy (&rep, memPtr, sizeof (rep));
+#if defined (__arm__) || defined (__aarch64__)
+  // The virtual flag is the low bit of the adjustment
+  bool isVirtual = (rep.adj & 1) != 0;
+  rep.adj >>= 1;
+  uintptr_t offset = rep.ptr;
+#else
+  // The virtual flag is the low bit of the pointer, which is then one
+  // plus the offset of the method in the virtual table
+  bool isVirtual = (rep.ptr & 1) != 0;
+  uintptr_t offset = rep.ptr - 1;
+#endif
+  if (isVirtual)
+    {
+      const char *self = static_cast<const char *> (obj) + rep.adj;
+      const char *vtable = *reinterpret_cast<const char * const *> (self);
+      return *reinterpret_cast<const void * const *> (vtable + offset);
+    }
+  return reinterpret_cast<const void *> (rep.ptr);
+#else
+  return 0;
+#endif
+}
+
+std::string
+EventProfiler::GetFunctionName (const void *function, const std::type_info &type)
+{
+  if (function == 0)
+    {
+      return GetFunctionName (type);
+    }
+  std::ostringstream oss;
+#ifdef HAVE_DLFCN_H
+  Dl_info info;
+  if (dladdr (function, &info) != 0)
+    {
+      if (info.dli_sname != 0 && info.dli_saddr == function)
+        {
+          std::string name = info.dli_sname;
+#if (__GNUC__ >= 3)
+          int status;
+          char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+          if (status == 0)
+            {
+              name = demangled;
+            }
+          std::free (demangled);
+#endif
+          return name;
+        }
+      if (info.dli_fname != 0)
+        {
+          // Not an exported symbol: name the function after its type
+          // and its place in its library
+          std::string file = info.dli_fname;
+          oss << GetFunctionName (type) << " at " << file.substr (file.rfind ('/') + 1)
+              << "+0x" << std::hex
+              << static_cast<const char *> (function) - static_cast<const char *> (info.dli_fbase);
+          return oss.str ();
+        }
+    }
+#endif
+  oss << GetFunctionName (type) << " at " << function;
+  return oss.str ();
+}
+
+void
+EventProfiler::Write (std::ostream &os, Format format) const
+{
+  NS_LOG_FUNCTION (this << &os << format);
+
+  // Merge the profiles of the threads, by name, since a function bound
+  // in several libraries gives several event types.
+  typedef std::pair<const void *, const std::type_info *> Function;
+  std::map<Function, std::string> names;
+  std::map<std::pair<std::string, uint32_t>, Totals> entries;
+  {
+    CriticalSection cs (m_mutex);
+    for (std::vector<Table *>::const_iterator t = m_tables.begin (); t != m_tables.end (); ++t)
+      {
+        for (Table::const_iterator i = (*t)->begin (); i != (*t)->end (); ++i)
+          {
+            Function function (i->first.function, i->first.type);
+            std::map<Function, std::string>::iterator n = names.find (function);
+            if (n == names.end ())
+              {
+                std::string name = GetFunctionName (i->first.function, *i->first.type);
+                n = names.insert (std::make_pair (function, name)).first;
+              }
+            Totals &totals = entries[std::make_pair (n->second, i->first.context)];
+            totals.count += i->second.count;
+            totals.time += i->second.time;
+          }
+      }
+  }
+
+  if (format == FOLDED)
+    {
+      for (std::map<std::pair<std::string, uint32_t>, Totals>::const_iterator i = entries.begin ();
+           i != entries.end (); ++i)
+        {
+          os << i->first.first << ";context " << GetContextName (i->first.second)
+             << " " << i->second.time << std::endl;
+        }
+      return;
+    }
+
+  Totals all = { 0, 0 };
+  std::map<std::string, Totals> functions;
+  std::map<std::string, Totals> contexts;
+  for (std::map<std::pair<std::string, uint32_t>, Totals>::const_iterator i = entries.begin ();
+       i != entries.end (); ++i)
+    {
+      Totals &function = functions[i->first.first];
+      function.count += i->second.count;
+      function.time += i->second.time;
+      Totals &context = contexts[GetContextName (i->first.second)];
+      context.count += i->second.count;
+      context.time += i->second.time;
+      all.count += i->second.count;
+      all.time += i->second.time;
+    }
+
+  os << "Event profile: " << all.count << " events in "
+     << std::fixed << std::setprecision (6) << all.time / 1e9 << " s" << std::endl;
+  os << std::endl << "By function:" << std::endl;
+  WriteTotals (os, functions, all.time, "Function");
+  os << std::endl << "By context:" << std::endl;
+  WriteTotals (os, contexts, all.time, "Context");
+}
+
+void
+EventProfiler::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  for (std::vector<Table *>::iterator i = m_tables.begin (); i != m_tables.end (); ++i)
+    {
+      (*i)->clear ();
+    }
+}
+
+void
+EventProfiler::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  bool empty = true;
+  {
+    CriticalSection cs (m_mutex);
+    for (std::vector<Table *>::const_iterator i = m_tables.begin (); i != m_tables.end (); ++i)
+      {
+        empty = empty && (*i)->empty ();
+      }
+  }
+  if (empty)
+    {
+      return;
+    }
+
+  StringValue output;
+  g_profilerOutput.GetValue (output);
+  EnumValue format;
+  g_profilerFormat.GetValue (format);
+  if (!output.Get ().empty ())
+    {
+      std::ofstream os (output.Get ().c_str ());
+      if (!os.good ())
+        {
+          NS_LOG_UNCOND ("EventProfiler: cannot open " << output.Get ());
+        }
+      else
+        {
+          Write (os, static_cast<Format> (format.Get ()));
+        }
+    }
+  Clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+#include "singleton.h"
+#include "system-mutex.h"
+
+#include <stdint.h>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * @ingroup simulator
+ *
+ * @brief Wall-clock profile of the events run by the simulator.
+ *
+ * When enabled, the simulator implementations run each event through
+ * Invoke(), which measures the wall-clock time taken by the event and
+ * adds it, with an event count, to the entry of the scheduled function
+ * and of the context (normally the node id) of the event.  The entries
+ * are kept in a hash table per thread, so that the cost per event is
+ * two clock reads and a table lookup.
+ *
+ * The scheduled function is identified by the address of the function
+ * bound by MakeEvent() (see EventImpl::GetFunction), which is resolved
+ * to its name with \c dladdr when the profile is written, for example
+ * \verbatim
+   ns3::YansWifiChannel::Receive(ns3::Ptr<ns3::YansWifiPhy>, ns3::Ptr<ns3::WifiPpdu const>, double) \endverbatim
+ * A function without an exported symbol, e.g., a static function, is
+ * named after its type and its address in its library, and an event
+ * which does not know its function (e.g., a Timer event) after its own
+ * type.
+ *
+ * The profile is written by Simulator::Destroy(), either as a report
+ * sorted by decreasing time per function and per context, or as
+ * folded stacks
+ * \verbatim
+   <function>;context <context> <nanoseconds> \endverbatim
+ * which can be given to \c flamegraph.pl.
+ *
+ * <b> Enabling the profiler </b>
+ *
+ * Set the name of the output file with the \c EventProfilerOutput
+ * global value, and the format with \c EventProfilerFormat, either
+ * \c "report" (the default) or \c "folded", for example
+ * \verbatim
+   $ ./waf --run "wifi-example --EventProfilerOutput=profile.txt" \endverbatim
+ * The profiler is disabled when \c EventProfilerOutput is empty, which
+ * is the default.  The global values are read by Simulator::Run().
+ */
+class EventProfiler : public Singleton<EventProfiler>
+{
+public:
+  /** The output formats. */
+  enum Format
+  {
+    REPORT,  //!< Report sorted by time per function and per context.
+    FOLDED   //!< Folded stacks, for flame graphs.
+  };
+
+  /** Constructor. */
+  EventProfiler ();
+  /** Destructor. */
+  ~EventProfiler ();
+
+  /**
+   * Get the profiler, if enabled by the \c EventProfilerOutput global
+   * value.
+   *
+   * \returns The profiler, or \c 0 if profiling is disabled.
+   */
+  static EventProfiler * GetEnabled (void);
+
+  /**
+   * Invoke an event, and add the time it took to the profile.
+   *
+   * Can be called by several threads at the same time.
+   *
+   * \param [in] context The context of the event.
+   * \param [in] event The event.
+   */
+  void Invoke (uint32_t context, EventImpl *event);
+
+  /**
+   * Write the profile.
+   *
+   * \param [in] os The output stream.
+   * \param [in] format The output format.
+   */
+  void Write (std::ostream &os, Format format) const;
+
+  /**
+   * Write the profile to the file set by the \c EventProfilerOutput
+   * global value, if any events have been profiled, and clear it.
+   * Called by Simulator::Destroy(), when the events are not running.
+   */
+  void Flush (void);
+
+  /**
+   * Get the type of the function scheduled by an event.
+   *
+   * \param [in] type The type of the event.
+   * \returns The type of the scheduled function, or the type of the
+   *          event if it was not made by MakeEvent().
+   */
+  static std::string GetFunctionName (const std::type_info &type);
+  /**
+   * Get the name of the function scheduled by an event, as it appears
+   * in the profile.
+   *
+   * \param [in] function The address of the function, or \c 0 if unknown.
+   * \param [in] type The type of the event.
+   * \returns The name of the scheduled function.
+   */
+  static std::string GetFunctionName (const void *function, const std::type_info &type);
+
+private:
+  /** A profile entry key. */
+  struct Key
+  {
+    const void *function;        //!< The address of the scheduled function.
+    const std::type_info *type;  //!< The type of the event.
+    uint32_t context;            //!< The context of the event.
+    /**
+     * \param [in] o The other key.
+     * \returns \c true if the keys are equal.
+     */
+    bool operator == (const Key &o) const
+    {
+      return function == o.function && type == o.type && context == o.context;
+    }
+  };
+  /** Hash function for Key. */
+  struct KeyHash
+  {
+    /**
+     * \param [in] key The key.
+     * \returns The hash of the key.
+     */
+    std::size_t operator () (const Key &key) const
+    {
+      return std::hash<const void *> () (key.function) ^ std::hash<const void *> () (key.type)
+             ^ (key.context * 0x9e3779b9UL);
+    }
+  };
+  /** A profile entry. */
+  struct Entry
+  {
+    uint64_t count;  //!< The number of events.
+    uint64_t time;   //!< The wall-clock time, in nanoseconds.
+  };
+  /** The profile of one thread. */
+  typedef std::unordered_map<Key, Entry, KeyHash> Table;
+
+  /** \returns The profile of the current thread. */
+  Table * GetTable (void);
+  /** Clear the profiles of all the threads. */
+  void Clear (void);
+
+  /** The profiles of all the threads, owned by the profiler. */
+  std::vector<Table *> m_tables;
+  /** Mutex to control access to the list of profiles. */
+  mutable SystemMutex m_mutex;
+
+};  // class EventProfiler
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
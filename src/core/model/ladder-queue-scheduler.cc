@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-queue-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderQueueScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderQueueScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderQueueScheduler);
+
+namespace {
+
+/**
+ * Buckets holding more events than this are spread over a new rung,
+ * and Bottom is spread over a new rung when it grows larger.
+ */
+const std::size_t THRESHOLD = 50;
+/** The maximum number of rungs. */
+const std::size_t MAX_RUNGS = 8;
+/** The maximum number of buckets of a rung. */
+const std::size_t MAX_BUCKETS = 1 << 16;
+
+/**
+ * Compare (greater than) two events, to sort the events with the
+ * earliest one last.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \c a > \c b
+ */
+bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b < a;
+}
+
+} // unnamed namespace
+
+TypeId
+LadderQueueScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderQueueScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderQueueScheduler> ()
+  ;
+  return tid;
+}
+
+LadderQueueScheduler::LadderQueueScheduler ()
+  : m_topMin (std::numeric_limits<uint64_t>::max ()),
+    m_topMax (0),
+    m_topStart (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderQueueScheduler::~LadderQueueScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderQueueScheduler::CurrentStart (const Rung &rung)
+{
+  return rung.start + rung.current * rung.width;
+}
+
+void
+LadderQueueScheduler::Spawn (Events &events, uint64_t start, uint64_t limit) const
+{
+  NS_LOG_FUNCTION (this << events.size () << start << limit);
+  NS_ASSERT (m_nRungs < MAX_RUNGS && limit > start);
+  uint64_t range = limit - start;
+  uint64_t buckets = std::min (std::max<std::size_t> (events.size (), 1), MAX_BUCKETS);
+  uint64_t width = (range + buckets - 1) / buckets;
+  Rung &rung = m_rungs[m_nRungs++];
+  rung.start = start;
+  rung.width = width;
+  rung.current = 0;
+  rung.count = events.size ();
+  rung.buckets.resize ((range + width - 1) / width);
+  for (Events::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      std::size_t bucket = (i->key.m_ts - start) / width;
+      NS_ASSERT (bucket < rung.buckets.size ());
+      rung.buckets[bucket].push_back (*i);
+    }
+  events.clear ();
+}
+
+void
+LadderQueueScheduler::InsertBottom (const Scheduler::Event &ev)
+{
+  m_bottom.insert (std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater), ev);
+  if (m_bottom.size () > THRESHOLD && m_nRungs < MAX_RUNGS
+      && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      uint64_t limit = m_nRungs > 0 ? CurrentStart (m_rungs[m_nRungs - 1]) : m_topStart;
+      Spawn (m_bottom, m_bottom.back ().key.m_ts, limit);
+    }
+}
+
+void
+LadderQueueScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_size++;
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      return;
+    }
+  for (std::size_t i = 0; i < m_nRungs; ++i)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= CurrentStart (rung))
+        {
+          std::size_t bucket = (ts - rung.start) / rung.width;
+          NS_ASSERT (bucket < rung.buckets.size ());
+          rung.buckets[bucket].push_back (ev);
+          rung.count++;
+          return;
+        }
+    }
+  InsertBottom (ev);
+}
+
+bool
+LadderQueueScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size == 0;
+}
+
+void
+LadderQueueScheduler::Prepare (void) const
+{
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+          NS_LOG_LOGIC ("transfer " << m_top.size () << " events from top");
+          uint64_t limit = m_topMax + 1;
+          if (m_top.size () <= THRESHOLD || m_topMin == m_topMax)
+            {
+              m_bottom.swap (m_top);
+              std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+            }
+          else
+            {
+              Spawn (m_top, m_topMin, limit);
+              const Rung &rung = m_rungs[0];
+              limit = rung.start + rung.buckets.size () * rung.width;
+            }
+          m_topStart = limit;
+          m_topMin = std::numeric_limits<uint64_t>::max ();
+          m_topMax = 0;
+          continue;
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      if (rung.count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      Events &bucket = rung.buckets[rung.current];
+      uint64_t start = CurrentStart (rung);
+      rung.current++;
+      rung.count -= bucket.size ();
+      if (bucket.size () > THRESHOLD && m_nRungs < MAX_RUNGS && rung.width > 1)
+        {
+          // m_rungs is never resized, so the bucket stays valid.
+          Spawn (bucket, start, start + rung.width);
+        }
+      else
+        {
+          m_bottom.swap (bucket);
+          std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+        }
+    }
+}
+
+Scheduler::Event
+LadderQueueScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Prepare ();
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderQueueScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Prepare ();
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_size--;
+  return ev;
+}
+
+void
+LadderQueueScheduler::RemoveFrom (Events &events, const Scheduler::Event &ev)
+{
+  for (Events::iterator i = events.begin (); i != events.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (i->impl == ev.impl);
+          *i = events.back ();
+          events.pop_back ();
+          return;
+        }
+    }
+  NS_FATAL_ERROR ("Event " << ev.key.m_uid << " not found");
+}
+
+void
+LadderQueueScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  m_size--;
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      RemoveFrom (m_top, ev);
+      return;
+    }
+  for (std::size_t i = 0; i < m_nRungs; ++i)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= CurrentStart (rung))
+        {
+          RemoveFrom (rung.buckets[(ts - rung.start) / rung.width], ev);
+          rung.count--;
+          return;
+        }
+    }
+  Events::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+  NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+  m_bottom.erase (i);
+}
+
+} // namespace ns3
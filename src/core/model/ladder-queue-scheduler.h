@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_QUEUE_SCHEDULER_H
+#define LADDER_QUEUE_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderQueueScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the Ladder Queue described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng, ACM TOMACS 15(3), 2005.
+ *
+ * The events are held in three tiers:
+ *  - Top, an unsorted list of the events later than any bucket of the
+ *    ladder, which is where most of the events are inserted;
+ *  - the ladder, a stack of rungs of buckets.  The first rung is built
+ *    from the content of Top, with up to one bucket per event; whenever
+ *    the next bucket of the last rung holds too many events, it is
+ *    spread over a new rung of finer buckets instead of being sorted;
+ *  - Bottom, a small sorted list of the earliest events, from which the
+ *    events are removed.
+ *
+ * Unlike the calendar queue, the bucket widths are derived from the
+ * actual range of the events they hold, rung by rung, so that events a
+ * few microseconds apart and events seconds away from the current time
+ * are both spread over buckets of a sensible size, and insertion and
+ * removal keep an O(1) amortized cost whatever the distribution of the
+ * timestamps.
+ */
+class LadderQueueScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderQueueScheduler ();
+  /** Destructor. */
+  virtual ~LadderQueueScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Event list type. */
+  typedef std::vector<Scheduler::Event> Events;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t start;              //!< Start of the first bucket.
+    uint64_t width;              //!< Bucket width.
+    std::size_t current;         //!< Index of the next bucket to dequeue.
+    std::size_t count;           //!< Number of events in the rung.
+    std::vector<Events> buckets; //!< The buckets.
+  };
+
+  /**
+   * \param [in] rung The rung.
+   * \returns The start of the next bucket to dequeue from a rung.
+   */
+  static inline uint64_t CurrentStart (const Rung &rung);
+  /**
+   * Spread a list of events over a new rung.
+   *
+   * \param [in,out] events The events, all in [\p start, \p limit).
+   *                        Emptied on return.
+   * \param [in] start The start of the new rung.
+   * \param [in] limit The end of the new rung.
+   */
+  void Spawn (Events &events, uint64_t start, uint64_t limit) const;
+  /**
+   * Insert an event in Bottom.
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /** Make sure Bottom holds the next event. */
+  void Prepare (void) const;
+  /**
+   * Remove an event from an unsorted list.
+   *
+   * \param [in,out] events The list.
+   * \param [in] ev The event.
+   */
+  static void RemoveFrom (Events &events, const Scheduler::Event &ev);
+
+  /*
+   * Moving events between the tiers does not change the content of the
+   * scheduler, and is required by PeekNext.
+   */
+  /** The Top list. */
+  mutable Events m_top;
+  /** Earliest timestamp in Top. */
+  mutable uint64_t m_topMin;
+  /** Latest timestamp in Top. */
+  mutable uint64_t m_topMax;
+  /** Events later than this timestamp are inserted in Top. */
+  mutable uint64_t m_topStart;
+  /** The rungs, including the unused ones. */
+  mutable std::vector<Rung> m_rungs;
+  /** The number of rungs in use. */
+  mutable std::size_t m_nRungs;
+  /** The Bottom list, sorted with the earliest event last. */
+  mutable Events m_bottom;
+  /** The number of events in the scheduler. */
+  std::size_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_QUEUE_SCHEDULER_H */
@@ -47,6 +47,10 @@ public:
     virtual ~EventFunctionImpl0 ()
     {
     }
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 protected:
     virtual void Notify (void)
     {
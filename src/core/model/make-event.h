@@ -317,6 +317,8 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 #include "event-impl.h"
 #include "type-traits.h"
 
+#include <cstddef>
+
 namespace ns3 {
 
 /**
@@ -355,6 +357,41 @@ struct EventMemberImplObjTraits<T *>
   }
 };
 
+/**
+ * \ingroup makeeventmemptr
+ * Get the address of the code run by a class method, when called on an
+ * object: the virtual methods are looked up in the virtual table of the
+ * object.
+ *
+ * The pointer to class method is passed as raw bytes, and decoded by
+ * the event profiler (see EventProfiler), so that this ABI-specific code
+ * is not compiled in every user of MakeEvent().
+ *
+ * \param [in] memPtr The bytes of the class method member function pointer.
+ * \param [in] size The size of the class method member function pointer.
+ * \param [in] obj The object.
+ * \returns The address of the code, or \c 0 if unknown.
+ */
+const void * GetMemberFunctionAddress (const void *memPtr, std::size_t size, const void *obj);
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the address of the code run by a class method, when called on an
+ * object.
+ *
+ * \tparam MEM \deduced The class method function signature.
+ * \tparam T \deduced The class type.
+ * \param [in] mem_ptr Class method member function pointer.
+ * \param [in] obj The object.
+ * \returns The address of the code, or \c 0 if unknown.
+ */
+template <typename MEM, typename T>
+const void *
+GetMemberFunctionAddress (const MEM &mem_ptr, const T &obj)
+{
+  return GetMemberFunctionAddress (&mem_ptr, sizeof (mem_ptr), &obj);
+}
+
 template <typename MEM, typename OBJ>
 EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
 {
@@ -370,6 +407,11 @@ public:
     virtual ~EventMemberImpl0 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -400,6 +442,11 @@ protected:
     virtual ~EventMemberImpl1 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -431,6 +478,11 @@ protected:
     virtual ~EventMemberImpl2 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -464,6 +516,11 @@ protected:
     virtual ~EventMemberImpl3 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -499,6 +556,11 @@ protected:
     virtual ~EventMemberImpl4 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -537,6 +599,11 @@ protected:
     virtual ~EventMemberImpl5 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -577,6 +644,11 @@ protected:
     virtual ~EventMemberImpl6 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return GetMemberFunctionAddress (m_function, EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
 private:
     virtual void Notify (void)
     {
@@ -612,6 +684,11 @@ protected:
     virtual ~EventFunctionImpl1 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 private:
     virtual void Notify (void)
     {
@@ -642,6 +719,11 @@ protected:
     virtual ~EventFunctionImpl2 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 private:
     virtual void Notify (void)
     {
@@ -675,6 +757,11 @@ protected:
     virtual ~EventFunctionImpl3 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 private:
     virtual void Notify (void)
     {
@@ -710,6 +797,11 @@ protected:
     virtual ~EventFunctionImpl4 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 private:
     virtual void Notify (void)
     {
@@ -747,6 +839,11 @@ protected:
     virtual ~EventFunctionImpl5 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 private:
     virtual void Notify (void)
     {
@@ -786,6 +883,11 @@ protected:
     virtual ~EventFunctionImpl6 ()
     {
     }
+public:
+    virtual const void * GetFunction (void) const
+    {
+      return reinterpret_cast<const void *> (m_function);
+    }
 private:
     virtual void Notify (void)
     {
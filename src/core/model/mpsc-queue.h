@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+
+/**
+ * \file
+ * \ingroup thread
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup thread
+ * \brief A lock-free multiple producer, single consumer FIFO queue.
+ *
+ * Any number of threads can Push items concurrently, with a single
+ * atomic exchange and without ever blocking; a single consumer thread
+ * removes them with Pop, in the order in which they were pushed by
+ * each producer.  This is the linked list queue of Dmitry Vyukov: a
+ * producer links its node to the previous head after exchanging it,
+ * so an item may not be visible to the consumer until the producer
+ * which pushed it has completed Push, even if later items have been
+ * pushed by other threads.  The consumer then sees an empty queue,
+ * and gets the items on a later call.
+ *
+ * Each Push allocates a list node with \c new, which Pop deletes: the
+ * producers do not contend on a lock of the queue, but still go
+ * through the heap allocator, whose thread caches usually serve these
+ * small blocks without locking.
+ *
+ * \tparam T \explicit The item type, which must be default
+ *         constructible and copyable.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+  /** Constructor. */
+  MpscQueue ();
+  /** Destructor: the remaining items are discarded. */
+  ~MpscQueue ();
+
+  /**
+   * Add an item at the end of the queue.  Can be called from any thread.
+   *
+   * \param [in] item The item.
+   */
+  void Push (const T &item);
+  /**
+   * Remove the item at the front of the queue.  Must only be called by
+   * the consumer thread.
+   *
+   * \param [out] item The item removed from the queue.
+   * \return \c false if the queue was empty.
+   */
+  bool Pop (T &item);
+  /**
+   * Check whether the queue is empty.  Must only be called by the
+   * consumer thread.
+   *
+   * \return \c true if Pop would fail.
+   */
+  bool IsEmpty (void) const;
+
+private:
+  /** A list node. */
+  struct Node
+  {
+    T item;                    //!< The item.
+    std::atomic<Node *> next;  //!< The next node.
+  };
+
+  /**
+   * Disable copy constructor.
+   * \param [in] o The queue to copy.
+   */
+  MpscQueue (const MpscQueue &o);
+  /**
+   * Disable assignment.
+   * \param [in] o The queue to copy.
+   * \returns This queue.
+   */
+  MpscQueue & operator = (const MpscQueue &o);
+
+  /** The last pushed node, written by the producers. */
+  std::atomic<Node *> m_head;
+  /** Keep m_tail off the cache line of m_head. */
+  char m_padding[64];
+  /**
+   * The node before the front of the queue, whose item has already
+   * been popped, only accessed by the consumer.
+   */
+  Node *m_tail;
+  /** The initial node. */
+  Node m_stub;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+MpscQueue<T>::MpscQueue ()
+  : m_head (&m_stub),
+    m_tail (&m_stub)
+{
+  m_stub.next.store (0, std::memory_order_relaxed);
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue ()
+{
+  T item;
+  while (Pop (item))
+    {
+    }
+  if (m_tail != &m_stub)
+    {
+      delete m_tail;
+    }
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push (const T &item)
+{
+  Node *node = new Node;
+  node->item = item;
+  node->next.store (0, std::memory_order_relaxed);
+  Node *previous = m_head.exchange (node, std::memory_order_acq_rel);
+  previous->next.store (node, std::memory_order_release);
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Pop (T &item)
+{
+  Node *tail = m_tail;
+  Node *next = tail->next.load (std::memory_order_acquire);
+  if (next == 0)
+    {
+      return false;
+    }
+  item = next->item;
+  m_tail = next;
+  if (tail != &m_stub)
+    {
+      delete tail;
+    }
+  return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty (void) const
+{
+  return m_tail->next.load (std::memory_order_acquire) == 0;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
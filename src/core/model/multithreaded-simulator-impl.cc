@@ -0,0 +1,767 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulator.h"
+#include "multithreaded-simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "event-profiler.h"
+
+#include "ptr.h"
+#include "pointer.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+
+#include <thread>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions, and because
+// the logging framework is not thread safe.
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::m_current = 0;
+
+/** Marker for the contexts which have not been explicitly assigned. */
+static const uint32_t UNASSIGNED_PARTITION = 0xffffffff;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("ThreadCount",
+                   "The number of partitions, each processed by its own thread. "
+                   "Zero selects the number of hardware threads.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_threadCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Lookahead",
+                   "The minimum delay of the events scheduled from one partition "
+                   "into another, i.e., the width of the synchronization windows.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::SetLookahead,
+                                     &MultithreadedSimulatorImpl::GetLookahead),
+                   MakeTimeChecker (Seconds (0)))
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  m_threadCount = 0;
+  m_lookahead = 0;
+  m_stop = false;
+  m_running = false;
+  m_currentTs = 0;
+  m_windowEnd = 0;
+  m_generation = 0;
+  m_pending = 0;
+  m_exit = false;
+  m_main = SystemThread::Self ();
+  m_profiler = 0;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  ProcessEventsWithContext ();
+
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *partition = *i;
+      while (!partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT_MSG (!m_running, "Cannot change the scheduler while running");
+
+  if (m_partitions.empty ())
+    {
+      // The attributes are set by now: create the partitions.
+      uint32_t n = m_threadCount;
+      if (n == 0)
+        {
+          n = std::max (std::thread::hardware_concurrency (), 1u);
+        }
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          Partition *partition = new Partition;
+          partition->index = i;
+          partition->outbox.resize (n);
+          // uids are allocated from 4, see DefaultSimulatorImpl.
+          partition->uid = 4;
+          partition->currentUid = 0;
+          partition->allocatedUids = 0;
+          partition->currentTs = 0;
+          partition->currentContext = Simulator::NO_CONTEXT;
+          partition->eventCount = 0;
+          partition->unscheduledEvents = 0;
+          m_partitions.push_back (partition);
+        }
+      NS_LOG_LOGIC ("created " << n << " partitions");
+    }
+
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      if ((*i)->events != 0)
+        {
+          while (!(*i)->events->IsEmpty ())
+            {
+              Scheduler::Event next = (*i)->events->RemoveNext ();
+              scheduler->Insert (next);
+            }
+        }
+      (*i)->events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+void
+MultithreadedSimulatorImpl::SetLookahead (const Time &lookahead)
+{
+  NS_LOG_FUNCTION (this << lookahead);
+  NS_ASSERT_MSG (!m_running, "Cannot change the lookahead while running");
+  NS_ASSERT_MSG (!lookahead.IsStrictlyNegative (), "Negative lookahead");
+  m_lookahead = lookahead.GetTimeStep ();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead (void) const
+{
+  return TimeStep (m_lookahead);
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition (uint32_t context, uint32_t partition)
+{
+  NS_LOG_FUNCTION (this << context << partition);
+  NS_ASSERT_MSG (!m_running, "Cannot change the partitioning while running");
+  NS_ASSERT_MSG (partition < m_partitions.size (), "Invalid partition " << partition);
+  NS_ASSERT_MSG (context != Simulator::NO_CONTEXT, "Cannot move events without context");
+  if (context >= m_contextPartition.size ())
+    {
+      m_contextPartition.resize (context + 1, UNASSIGNED_PARTITION);
+    }
+  m_contextPartition[context] = partition;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return 0;
+    }
+  if (context < m_contextPartition.size ()
+      && m_contextPartition[context] != UNASSIGNED_PARTITION)
+    {
+      return m_contextPartition[context];
+    }
+  return context % m_partitions.size ();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return m_partitions.size ();
+}
+
+bool
+MultithreadedSimulatorImpl::IsConcurrent (uint32_t context) const
+{
+  return GetCurrentPartition () != m_partitions[GetPartition (context)];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::AllocateUid (void)
+{
+  // Interleave the identifiers of the partitions: with a single
+  // partition, they are allocated as by DefaultSimulatorImpl.
+  Partition *partition = GetCurrentPartition ();
+  return partition->allocatedUids++ * m_partitions.size () + partition->index;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  if (m_current != 0)
+    {
+      return m_current;
+    }
+  return m_partitions[0];
+}
+
+Scheduler::Event
+MultithreadedSimulatorImpl::Insert (Partition *partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  NS_ASSERT (ts >= partition->currentTs);
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = partition->uid;
+  partition->uid++;
+  partition->unscheduledEvents++;
+  partition->events->Insert (ev);
+  return ev;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *partition)
+{
+  Scheduler::Event next = partition->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition->currentTs);
+  partition->unscheduledEvents--;
+  partition->eventCount++;
+
+  partition->currentTs = next.key.m_ts;
+  partition->currentContext = next.key.m_context;
+  partition->currentUid = next.key.m_uid;
+  if (m_profiler != 0)
+    {
+      m_profiler->Invoke (next.key.m_context, next.impl);
+    }
+  else
+    {
+      next.impl->Invoke ();
+    }
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (Partition *partition)
+{
+  Partition *previous = m_current;
+  m_current = partition;
+  while (!partition->events->IsEmpty ()
+         && partition->events->PeekNext ().key.m_ts < m_windowEnd)
+    {
+      ProcessOneEvent (partition);
+    }
+  m_current = previous;
+}
+
+void
+MultithreadedSimulatorImpl::WorkerThread (std::pair<MultithreadedSimulatorImpl *, uint32_t> arg)
+{
+  arg.first->DoWorker (arg.second);
+}
+
+void
+MultithreadedSimulatorImpl::DoWorker (uint32_t index)
+{
+  Partition *partition = m_partitions[index];
+  uint64_t generation = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_barrierMutex);
+        while (m_generation == generation && !m_exit)
+          {
+            m_windowStart.wait (lock);
+          }
+        if (m_exit)
+          {
+            return;
+          }
+        generation = m_generation;
+      }
+
+      ProcessWindow (partition);
+
+      {
+        std::lock_guard<std::mutex> lock (m_barrierMutex);
+        if (--m_pending == 0)
+          {
+            m_windowDone.notify_one ();
+          }
+      }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartThreads (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_exit = false;
+  for (uint32_t i = 1; i < m_partitions.size (); ++i)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (
+          MakeBoundCallback (&MultithreadedSimulatorImpl::WorkerThread,
+                             std::make_pair (this, i)));
+      thread->Start ();
+      m_threads.push_back (thread);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopThreads (void)
+{
+  NS_LOG_FUNCTION (this);
+  {
+    std::lock_guard<std::mutex> lock (m_barrierMutex);
+    m_exit = true;
+  }
+  m_windowStart.notify_all ();
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_threads.begin (); i != m_threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_threads.clear ();
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEventsWithContext (void)
+{
+  // The events exchanged between partitions: merge them by source
+  // partition order so that the outcome does not depend on the thread
+  // interleaving.
+  for (std::vector<Partition *>::iterator dst = m_partitions.begin (); dst != m_partitions.end (); ++dst)
+    {
+      for (std::vector<Partition *>::iterator src = m_partitions.begin (); src != m_partitions.end (); ++src)
+        {
+          EventsWithContext &outbox = (*src)->outbox[(*dst)->index];
+          for (EventsWithContext::const_iterator ev = outbox.begin (); ev != outbox.end (); ++ev)
+            {
+              Insert (*dst, ev->timestamp, ev->context, ev->event);
+            }
+          outbox.clear ();
+        }
+    }
+
+  EventWithContext event;
+  while (m_eventsWithContext.Pop (event))
+    {
+      Partition *partition = m_partitions[GetPartition (event.context)];
+      // Current time added here, as in DefaultSimulatorImpl; m_currentTs
+      // is not smaller than the clock of any partition.
+      Insert (partition, m_currentTs + event.timestamp, event.context, event.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = SystemThread::Self ();
+  m_stop = false;
+  m_profiler = EventProfiler::GetEnabled ();
+  m_running = true;
+  bool threadsStarted = false;
+
+  while (!m_stop)
+    {
+      ProcessEventsWithContext ();
+
+      // Find the start of the next window and the partitions active in it.
+      uint64_t next = GetMaximumSimulationTime ().GetTimeStep ();
+      bool empty = true;
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          if (!(*i)->events->IsEmpty ())
+            {
+              next = std::min (next, (*i)->events->PeekNext ().key.m_ts);
+              empty = false;
+            }
+        }
+      if (empty)
+        {
+          break;
+        }
+      // A zero lookahead still lets all the partitions process the
+      // events with the next timestamp in parallel.
+      uint64_t width = std::max<uint64_t> (m_lookahead, 1);
+      m_windowEnd = (next > GetMaximumSimulationTime ().GetTimeStep () - width) ?
+        GetMaximumSimulationTime ().GetTimeStep () : next + width;
+
+      Partition *active = 0;
+      uint32_t nActive = 0;
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          if (!(*i)->events->IsEmpty ()
+              && (*i)->events->PeekNext ().key.m_ts < m_windowEnd)
+            {
+              active = *i;
+              nActive++;
+            }
+        }
+
+      if (nActive == 1)
+        {
+          // Nothing to parallelize: avoid the barrier.
+          ProcessWindow (active);
+        }
+      else
+        {
+          if (!threadsStarted)
+            {
+              StartThreads ();
+              threadsStarted = true;
+            }
+          {
+            std::lock_guard<std::mutex> lock (m_barrierMutex);
+            m_pending = m_partitions.size () - 1;
+            m_generation++;
+          }
+          m_windowStart.notify_all ();
+          ProcessWindow (m_partitions[0]);
+          {
+            std::unique_lock<std::mutex> lock (m_barrierMutex);
+            while (m_pending != 0)
+              {
+                m_windowDone.wait (lock);
+              }
+          }
+        }
+
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          m_currentTs = std::max (m_currentTs, (*i)->currentTs);
+        }
+    }
+
+  if (threadsStarted)
+    {
+      StopThreads ();
+    }
+  m_running = false;
+  // Move the events sent during the last window, if stopped.
+  ProcessEventsWithContext ();
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+#ifdef NS3_ASSERT_ENABLE
+  if (IsFinished () && !m_stop)
+    {
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          NS_ASSERT ((*i)->unscheduledEvents == 0);
+        }
+    }
+#endif
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  Simulator::Schedule (delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_ASSERT_MSG (m_current != 0 || SystemThread::Equals (m_main),
+                 "Simulator::Schedule Thread-unsafe invocation!");
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+  Partition *partition = GetCurrentPartition ();
+  uint64_t now = (m_current != 0) ? m_current->currentTs : m_currentTs;
+  Time tAbsolute = delay + TimeStep (now);
+  Scheduler::Event ev = Insert (partition, (uint64_t) tAbsolute.GetTimeStep (), GetContext (), event);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  if (m_current != 0)
+    {
+      // From an event: deliver locally or through the outbox.
+      Partition *dst = m_partitions[GetPartition (context)];
+      Time tAbsolute = delay + TimeStep (m_current->currentTs);
+      if (dst == m_current)
+        {
+          Insert (dst, (uint64_t) tAbsolute.GetTimeStep (), context, event);
+        }
+      else
+        {
+          NS_ASSERT_MSG ((uint64_t) delay.GetTimeStep () >= m_lookahead,
+                         "Event scheduled for context " << context << " in partition "
+                         << dst->index << " with delay " << delay << " smaller than the lookahead "
+                         << GetLookahead ());
+          EventWithContext ev;
+          ev.context = context;
+          ev.timestamp = (uint64_t) tAbsolute.GetTimeStep ();
+          ev.event = event;
+          m_current->outbox[dst->index].push_back (ev);
+        }
+    }
+  else if (SystemThread::Equals (m_main))
+    {
+      // From the main program, while the simulation is not running.
+      Time tAbsolute = delay + TimeStep (m_currentTs);
+      Insert (m_partitions[GetPartition (context)], (uint64_t) tAbsolute.GetTimeStep (), context, event);
+    }
+  else
+    {
+      EventWithContext ev;
+      ev.context = context;
+      // Current time added in ProcessEventsWithContext()
+      ev.timestamp = delay.GetTimeStep ();
+      ev.event = event;
+      m_eventsWithContext.Push (ev);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_ASSERT_MSG (m_current != 0 || SystemThread::Equals (m_main),
+                 "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+  Partition *partition = GetCurrentPartition ();
+  uint64_t now = (m_current != 0) ? m_current->currentTs : m_currentTs;
+  Scheduler::Event ev = Insert (partition, now, GetContext (), event);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_ASSERT_MSG (SystemThread::Equals (m_main),
+                 "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+  EventId id (Ptr<EventImpl> (event, false), m_currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  if (m_current != 0)
+    {
+      return TimeStep (m_current->currentTs);
+    }
+  return TimeStep (m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs ()) - Now ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *partition = m_partitions[GetPartition (id.GetContext ())];
+  NS_ASSERT_MSG (m_current == partition || !m_running,
+                 "Events can only be removed from the partition which owns them");
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (id.GetUid () != 2 && id.PeekEventImpl () != 0)
+    {
+      NS_ASSERT_MSG (m_current == m_partitions[GetPartition (id.GetContext ())] || !m_running,
+                     "Events can only be cancelled from the partition which owns them");
+    }
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0)
+    {
+      return true;
+    }
+  const Partition *partition = m_partitions[GetPartition (id.GetContext ())];
+  NS_ASSERT_MSG (m_current == partition || !m_running,
+                 "Events can only be checked from the partition which owns them");
+  if (id.GetTs () < partition->currentTs
+      || (id.GetTs () == partition->currentTs
+          && id.GetUid () <= partition->currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  if (m_current != 0)
+    {
+      return m_current->currentContext;
+    }
+  return Simulator::NO_CONTEXT;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = 0;
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      count += (*i)->eventCount;
+    }
+  return count;
+}
+
+} // namespace ns3
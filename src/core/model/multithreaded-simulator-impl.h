@@ -0,0 +1,311 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "event-profiler.h"
+#include "system-thread.h"
+#include "nstime.h"
+#include "mpsc-queue.h"
+
+#include "ptr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A conservative parallel simulator implementation for shared-memory
+ * machines.
+ *
+ * Event contexts (i.e., node ids) are mapped onto a fixed number of
+ * partitions, each with its own event list, clock and worker thread.
+ * The simulation advances in synchronous windows: if \f$T\f$ is the
+ * timestamp of the earliest pending event over all the partitions,
+ * every partition independently processes its events with timestamps
+ * in \f$[T, T + L)\f$, where \f$L\f$ is the lookahead, before all the
+ * threads meet at a barrier.
+ *
+ * Events scheduled with Simulator::ScheduleWithContext for a context
+ * owned by another partition are the only hand-off between partitions.
+ * They are buffered in a per-(source, destination) outbox and moved to
+ * the destination event list at the next barrier, so no locking takes
+ * place while a window is being processed and the merge order (and hence
+ * the simulation) is deterministic.  Such cross-partition events must be
+ * scheduled at least \f$L\f$ in the future; this is what the propagation
+ * delay of a wireless channel guarantees as long as the lookahead is not
+ * larger than the smallest propagation delay between two nodes of
+ * different partitions (see ns3::LookaheadHelper).  A zero lookahead is
+ * legal but degenerates to one barrier per distinct timestamp.  Events
+ * with the same timestamp run in the order they were inserted in their
+ * partition, the events received at a barrier coming after those already
+ * scheduled: unlike with DefaultSimulatorImpl, this order depends on the
+ * partitioning, so that simultaneous events of different nodes may run
+ * in a different order under both implementations.
+ *
+ * Events scheduled with Simulator::Schedule or Simulator::ScheduleNow
+ * stay in the partition of the current context.  Events scheduled
+ * without a context (e.g., from the main program before Simulator::Run)
+ * belong to partition 0.  By default, context \c c is owned by
+ * partition <tt>c % n</tt>; use SetPartition to place nodes explicitly,
+ * for example to keep the nodes of a BSS together.
+ *
+ * When ns-3 is configured with --enable-atomic-refcount, the reference
+ * counts of the objects are atomic, and since Object::GetObject does not
+ * modify the aggregates, an event may reference the objects of a node
+ * of another partition, e.g., a channel delivering a packet to a
+ * device.  Without this option, the partitions must not share any
+ * reference counted object.  The packets share their data with their
+ * copies without any lock: they must be handed over to another
+ * partition as a Packet::DeepCopy when IsConcurrent returns \c true, as
+ * YansWifiChannel does.  The spectrum channels do not, and are not
+ * supported.  The packet uids are allocated by each partition (see
+ * AllocateUid), so they do not depend on the thread interleaving.
+ * Models whose state is shared between nodes of different partitions
+ * (global counters, trace sinks, shared objects) must be made thread
+ * safe by the user.
+ *
+ * Simulator::Stop takes effect at the end of the current window, so
+ * partitions may have processed events up to \f$L\f$ past the stop
+ * time of the partition which called it.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual bool IsConcurrent (uint32_t context) const;
+  virtual uint32_t AllocateUid (void);
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * Set the lookahead, i.e., the minimum delay of any event scheduled
+   * from one partition into another.
+   *
+   * \param [in] lookahead The lookahead.
+   */
+  void SetLookahead (const Time &lookahead);
+  /**
+   * \return The lookahead.
+   */
+  Time GetLookahead (void) const;
+  /**
+   * Assign a context to a partition.
+   *
+   * This must be done before any event is scheduled with this context,
+   * and cannot be done while the simulation is running.
+   *
+   * \param [in] context The context, typically a node id.
+   * \param [in] partition The partition index, smaller than GetNPartitions().
+   */
+  void SetPartition (uint32_t context, uint32_t partition);
+  /**
+   * \param [in] context The context, typically a node id.
+   * \return The index of the partition owning this context.
+   */
+  uint32_t GetPartition (uint32_t context) const;
+  /**
+   * \return The number of partitions, i.e., of threads used by Run.
+   */
+  uint32_t GetNPartitions (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** Wrap an event with its execution context. */
+  struct EventWithContext {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp, absolute or relative depending on the queue. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /** Container type for the events from a different context. */
+  typedef std::vector<struct EventWithContext> EventsWithContext;
+
+  /** The state owned by a single worker thread. */
+  struct Partition {
+    /** The partition index. */
+    uint32_t index;
+    /** The event priority queue. */
+    Ptr<Scheduler> events;
+    /**
+     * Events scheduled for other partitions during the current window,
+     * indexed by destination partition.  Only written by the owner thread.
+     */
+    std::vector<EventsWithContext> outbox;
+    /** Next event unique id. */
+    uint32_t uid;
+    /** Unique id of the current event. */
+    uint32_t currentUid;
+    /** Number of identifiers allocated by AllocateUid. */
+    uint32_t allocatedUids;
+    /** Timestamp of the current event. */
+    uint64_t currentTs;
+    /** Execution context of the current event. */
+    uint32_t currentContext;
+    /** The event count. */
+    uint64_t eventCount;
+    /** Number of events inserted but not yet processed or removed. */
+    int unscheduledEvents;
+  };
+
+  /**
+   * Entry point of the worker threads.
+   * \param [in] arg The simulator and the index of the partition to run.
+   */
+  static void WorkerThread (std::pair<MultithreadedSimulatorImpl *, uint32_t> arg);
+  /**
+   * Process windows for a partition until the simulation ends.
+   * \param [in] partition The partition index.
+   */
+  void DoWorker (uint32_t partition);
+  /**
+   * Process all the events of a partition before the end of the
+   * current window.
+   * \param [in] partition The partition.
+   */
+  void ProcessWindow (Partition *partition);
+  /**
+   * Process the next event of a partition.
+   * \param [in] partition The partition.
+   */
+  void ProcessOneEvent (Partition *partition);
+  /**
+   * Insert an event in the event list of a partition.
+   * \param [in] partition The partition.
+   * \param [in] ts The absolute event timestamp.
+   * \param [in] context The event context.
+   * \param [in] event The event implementation.
+   * \return The scheduler event.
+   */
+  Scheduler::Event Insert (Partition *partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Move the events exchanged between partitions during the last window,
+   * and those injected by foreign threads, to their event lists.
+   */
+  void ProcessEventsWithContext (void);
+  /**
+   * Get the partition which must hold the events of the calling thread.
+   * \return The partition of the current event, or the partition of
+   *         the events without a context if called outside of an event.
+   */
+  Partition *GetCurrentPartition (void) const;
+  /** Create the worker threads. */
+  void StartThreads (void);
+  /** Make the worker threads return and join them. */
+  void StopThreads (void);
+
+  /** The partition of the event being processed by the calling thread. */
+  static thread_local Partition *m_current;
+
+  /** The partitions. */
+  std::vector<Partition *> m_partitions;
+  /** Explicit context to partition assignments. */
+  std::vector<uint32_t> m_contextPartition;
+  /** The number of partitions requested through the attribute. */
+  uint32_t m_threadCount;
+  /** The lookahead, in time steps. */
+  uint64_t m_lookahead;
+
+  /** Events injected from foreign threads, with relative timestamps. */
+  MpscQueue<struct EventWithContext> m_eventsWithContext;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Flag calling for the end of the simulation. */
+  std::atomic<bool> m_stop;
+  /** Flag \c true while Run is processing windows. */
+  bool m_running;
+
+  /** Timestamp of the latest event processed by any partition. */
+  uint64_t m_currentTs;
+  /** End (excluded) of the window being processed. */
+  uint64_t m_windowEnd;
+
+  /** The worker threads, one per partition but the first one. */
+  std::vector<Ptr<SystemThread> > m_threads;
+  /** Mutex protecting the window barrier state. */
+  std::mutex m_barrierMutex;
+  /** Condition signalled when a new window starts. */
+  std::condition_variable m_windowStart;
+  /** Condition signalled when the last worker completes a window. */
+  std::condition_variable m_windowDone;
+  /** Window generation, incremented for each window. */
+  uint64_t m_generation;
+  /** Number of workers still processing the current window. */
+  uint32_t m_pending;
+  /** Flag asking the workers to return. */
+  bool m_exit;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+
+  /** The event profiler, if enabled when Run() was called. */
+  EventProfiler *m_profiler;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -29,6 +29,7 @@
 #include <sstream>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 
 /**
  * \file
@@ -46,6 +47,8 @@ NS_LOG_COMPONENT_DEFINE ("Object");
 
 NS_OBJECT_ENSURE_REGISTERED (Object);
 
+const uint32_t Object::MAX_AGGREGATES_CACHE_SIZE;
+
 Object::AggregateIterator::AggregateIterator ()
   : m_object (0),
     m_current (0)
@@ -97,11 +100,9 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates (AllocateAggregates (1))
 {
   NS_LOG_FUNCTION (this);
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object () 
@@ -120,6 +121,11 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // and empty the cache of the lookups, whose indexes have changed
+  for (uint32_t i = 0; i <= m_aggregates->cacheMask; i++)
+    {
+      m_aggregates->cache[i].store (0, std::memory_order_relaxed);
+    }
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -132,10 +138,8 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates (AllocateAggregates (1))
 {
-  m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -151,6 +155,20 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
+  // Look up the cache first
+  uint32_t uid = tid.GetUid ();
+  AggregatesCacheEntry *entry = &m_aggregates->cache[uid & m_aggregates->cacheMask];
+  uint32_t cached = entry->load (std::memory_order_relaxed);
+  if ((cached >> 16) == uid)
+    {
+      uint32_t index = cached & 0xffff;
+      if (index == NOT_AGGREGATED)
+        {
+          return 0;
+        }
+      return m_aggregates->buffer[index];
+    }
+
   uint32_t n = m_aggregates->n;
   TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
@@ -163,20 +181,13 @@ Object::DoGetObject (TypeId tid) const
         }
       if (cur == tid)
         {
-          // This is an attempt to 'cache' the result of this lookup.
-          // the idea is that if we perform a lookup for a TypeId on this object,
-          // we are likely to perform the same lookup later so, we make sure
-          // that the aggregate array is sorted by the number of accesses
-          // to each object.
-
-          // first, increment the access count
-          current->m_getObjectCount++;
-          // then, update the sort
-          UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
+          // if we perform a lookup for a TypeId on this object, we are
+          // likely to perform the same lookup later so, we cache it.
+          entry->store (uid << 16 | i, std::memory_order_relaxed);
           return const_cast<Object *> (current);
         }
     }
+  entry->store (uid << 16 | NOT_AGGREGATED, std::memory_order_relaxed);
   return 0;
 }
 void
@@ -235,18 +246,26 @@ restart:
         }
     }
 }
-void
-Object::UpdateSortedArray (struct Aggregates *aggregates, uint32_t j) const
+struct Object::Aggregates *
+Object::AllocateAggregates (uint32_t n)
 {
-  NS_LOG_FUNCTION (this << aggregates << j);
-  while (j > 0 && 
-         aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j-1]->m_getObjectCount)
+  uint32_t entries = 2;
+  while (entries < 2 * n && entries < MAX_AGGREGATES_CACHE_SIZE)
+    {
+      entries *= 2;
+    }
+  NS_ASSERT_MSG (n < NOT_AGGREGATED, "Too many aggregated Objects");
+  struct Aggregates *aggregates =
+    (struct Aggregates *)std::malloc (sizeof (struct Aggregates) + (n - 1) * sizeof (Object *)
+                                      + entries * sizeof (AggregatesCacheEntry));
+  aggregates->n = n;
+  aggregates->cacheMask = entries - 1;
+  aggregates->cache = reinterpret_cast<AggregatesCacheEntry *> (&aggregates->buffer[n]);
+  for (uint32_t i = 0; i < entries; i++)
     {
-      Object *tmp = aggregates->buffer[j-1];
-      aggregates->buffer[j-1] = aggregates->buffer[j];
-      aggregates->buffer[j] = tmp;
-      j--;
+      new (&aggregates->cache[i]) AggregatesCacheEntry (0);
     }
+  return aggregates;
 }
 void 
 Object::AggregateObject (Ptr<Object> o)
@@ -260,9 +279,7 @@ Object::AggregateObject (Ptr<Object> o)
   Object *other = PeekPointer (o);
   // first create the new aggregate buffer.
   uint32_t total = m_aggregates->n + other->m_aggregates->n;
-  struct Aggregates *aggregates = 
-    (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
-  aggregates->n = total;
+  struct Aggregates *aggregates = AllocateAggregates (total);
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -281,7 +298,6 @@ Object::AggregateObject (Ptr<Object> o)
                           other->GetInstanceTypeId () <<
                           " on objects of type " << typeId);
         }
-      UpdateSortedArray (aggregates, m_aggregates->n + i);
     }
 
   // keep track of the old aggregate buffers for the iteration
@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <string>
 #include <vector>
+#include <atomic>
 #include "ptr.h"
 #include "attribute.h"
 #include "object-base.h"
@@ -320,6 +321,20 @@ private:
   friend class AggregateIterator;
   friend struct ObjectDeleter;
 
+  /** The maximum number of entries of the cache of the lookups of DoGetObject. */
+  static const uint32_t MAX_AGGREGATES_CACHE_SIZE = 64;
+
+  /**
+   * An entry of the cache of the lookups of DoGetObject: the uid of the
+   * TypeId looked up in the upper 16 bits, 0 for an empty entry, and the
+   * index of the Object found in the lower 16 bits, NOT_AGGREGATED if
+   * none was found.  The entry is a single word, so that the threads of
+   * a multithreaded simulator can look up the same list concurrently.
+   */
+  typedef std::atomic<uint32_t> AggregatesCacheEntry;
+  /** The index cached for the TypeIds which are not aggregated. */
+  static const uint32_t NOT_AGGREGATED = 0xffff;
+
   /**
    * The list of Objects aggregated to this one.
    *
@@ -331,14 +346,36 @@ private:
    * chunk of memory than the struct to allow space for a larger
    * variable sized buffer whose size is indicated by the element
    * \c n
+   *
+   * The results of the recent lookups of DoGetObject are cached in a
+   * table indexed by the uid of the TypeId looked up, so that repeated
+   * lookups do not walk the TypeId of each aggregate.  The table, which
+   * follows the buffer in the same chunk of memory, has twice as many
+   * entries as the list, rounded to a power of two, up to
+   * MAX_AGGREGATES_CACHE_SIZE.  As a new list is allocated by
+   * AggregateObject, and the lookups do not reorder the list, the cache
+   * of a list remains valid as long as the list, until an Object is
+   * removed from it when it is destroyed.
    */
   struct Aggregates {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The number of entries in \c cache, minus one. */
+    uint32_t cacheMask;
+    /** The cache of the lookups. */
+    AggregatesCacheEntry *cache;
     /** The array of Objects. */
     Object *buffer[1];
   };
 
+  /**
+   * Allocate a list of aggregates, with an empty cache.
+   *
+   * \param [in] n The number of Objects in the list.
+   * \return The list, to be freed with std::free.
+   */
+  static struct Aggregates * AllocateAggregates (uint32_t n);
+
   /**
    * Find an Object of TypeId tid in the aggregates of this Object.
    *
@@ -386,13 +423,6 @@ private:
   */
   void Construct (const AttributeConstructionList &attributes);
 
-  /**
-   * Keep the list of aggregates in most-recently-used order
-   *
-   * \param [in,out] aggregates The list of aggregated Objects.
-   * \param [in] i The most recently used entry in the list.
-   */
-  void UpdateSortedArray (struct Aggregates *aggregates, uint32_t i) const;
   /**
    * Attempt to delete this Object.
    *
@@ -424,14 +454,6 @@ private:
    * so the size of the array is indirectly a reference count.
    */
   struct Aggregates * m_aggregates;
-  /**
-   * The number of times the Object was accessed with a
-   * call to GetObject().
-   *
-   * This integer is used to implement a heuristic to sort
-   * the array of aggregates in most-frequently accessed order.
-   */
-  uint32_t m_getObjectCount;
 };
 
 template <typename T>
@@ -21,6 +21,7 @@
 #include "wall-clock-synchronizer.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 #include "synchronizer.h"
 
 #include "ptr.h"
@@ -33,6 +34,7 @@
 #include "enum.h"
 
 
+#include <algorithm>
 #include <cmath>
 
 
@@ -91,6 +93,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
   m_eventCount = 0;
+  m_profiler = 0;
 
   m_main = SystemThread::Self();
 
@@ -108,6 +111,10 @@ void
 RealtimeSimulatorImpl::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  {
+    CriticalSection cs (m_mutex);
+    ProcessEventsWithContext ();
+  }
   while (!m_events->IsEmpty ())
     {
       Scheduler::Event next = m_events->RemoveNext ();
@@ -222,6 +229,16 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         NS_ASSERT_MSG (m_synchronizer->Realtime (), 
                        "RealtimeSimulatorImpl::ProcessOneEvent (): Synchronizer reports not Realtime ()");
 
+        //
+        // Reset the synchronizer so that any future event will cause it to
+        // interrupt (see below) before looking at the events scheduled by
+        // other threads: those threads add their events without taking the
+        // critical section, and Signal() after adding them, so an event
+        // added after this point either is found now or interrupts the wait.
+        //
+        m_synchronizer->SetCondition (false);
+        ProcessEventsWithContext ();
+
         //
         // tsNow is set to the normalized current real time.  When the simulation was
         // started, the current real time was effectively set to zero; so tsNow is
@@ -254,10 +271,9 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         // We've figured out how long we need to delay in order to pace the 
         // simulation time with the real time.  We're going to sleep, but need
         // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
+        // external happens (like a packet is received).  The synchronizer was
+        // reset above so that any future event will cause it to interrupt.
         //
-        m_synchronizer->SetCondition (false);
       }
 
       //
@@ -325,8 +341,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     // We do know we're waiting for an event, so there had better be an event on the 
     // event queue.  Let's pull it off.  When we release the critical section, the
     // event we're working on won't be on the list and so subsequent operations won't
-    // mess with us.
+    // mess with us.  Events scheduled by other threads since we synchronized
+    // may be due before it.
     //
+    ProcessEventsWithContext ();
     NS_ASSERT_MSG (m_events->IsEmpty () == false, 
                    "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
     next = m_events->RemoveNext ();
@@ -390,7 +408,14 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
 
   EventImpl *event = next.impl;
   m_synchronizer->EventStart ();
-  event->Invoke ();
+  if (m_profiler != 0)
+    {
+      m_profiler->Invoke (next.key.m_context, event);
+    }
+  else
+    {
+      event->Invoke ();
+    }
   m_synchronizer->EventEnd ();
   event->Unref ();
 }
@@ -401,12 +426,42 @@ RealtimeSimulatorImpl::IsFinished (void) const
   bool rc;
   {
     CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
+    rc = (m_events->IsEmpty () && m_eventsWithContext.IsEmpty ()) || m_stop;
   }
 
   return rc;
 }
 
+//
+// Should be called with critical section locked.
+//
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext (void)
+{
+  EventWithContext event;
+  while (m_eventsWithContext.Pop (event))
+    {
+      Scheduler::Event ev;
+      ev.impl = event.event;
+      ev.key.m_ts = event.timestamp;
+      if (event.relative)
+        {
+          ev.key.m_ts += m_currentTs;
+        }
+      //
+      // The real time read by the scheduling thread may be late with
+      // respect to an event which started running before the event
+      // was moved here.
+      //
+      ev.key.m_ts = std::max (ev.key.m_ts, m_currentTs);
+      ev.key.m_context = event.context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+    }
+}
+
 //
 // Peeks into event list.  Should be called with critical section locked.
 //
@@ -431,8 +486,9 @@ RealtimeSimulatorImpl::Run (void)
   m_main = SystemThread::Self();
 
   m_stop = false;
-  m_running = true;
+  m_profiler = EventProfiler::GetEnabled ();
   m_synchronizer->SetOrigin (m_currentTs);
+  m_running = true;
 
   // Sleep until signalled
   uint64_t tsNow = 0;
@@ -444,6 +500,7 @@ RealtimeSimulatorImpl::Run (void)
       {
         CriticalSection cs (m_mutex);
 
+        ProcessEventsWithContext ();
         if (!m_events->IsEmpty ())
           {
             process = true;
@@ -544,23 +601,34 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
 {
   NS_LOG_FUNCTION (this << context << delay << impl);
 
+  if (!SystemThread::Equals (m_main))
+    {
+      //
+      // Other threads do not take the critical section, which may be held
+      // by the main thread for the duration of an event: they queue the
+      // event, to be moved to the event list by the main thread.
+      //
+      // If the simulator is running, we're pacing and have a meaningful 
+      // realtime clock.  If we're not, then m_currentTs is where we stopped,
+      // which is added when the event is moved to the event list.
+      // 
+      EventWithContext ev;
+      ev.context = context;
+      ev.relative = !m_running;
+      ev.timestamp = delay.GetTimeStep ();
+      if (!ev.relative)
+        {
+          ev.timestamp += m_synchronizer->GetCurrentRealtime ();
+        }
+      ev.event = impl;
+      m_eventsWithContext.Push (ev);
+      m_synchronizer->Signal ();
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
-    uint64_t ts;
-
-    if (SystemThread::Equals (m_main))
-      {
-        ts = m_currentTs + delay.GetTimeStep ();
-      }
-    else
-      {
-        //
-        // If the simulator is running, we're pacing and have a meaningful 
-        // realtime clock.  If we're not, then m_currentTs is where we stopped.
-        // 
-        ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
-        ts += delay.GetTimeStep ();
-      }
+    uint64_t ts = m_currentTs + delay.GetTimeStep ();
 
     NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
     Scheduler::Event ev;
@@ -25,12 +25,15 @@
 #include "scheduler.h"
 #include "synchronizer.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 
 #include "ptr.h"
 #include "assert.h"
 #include "log.h"
 #include "system-mutex.h"
+#include "mpsc-queue.h"
 
+#include <atomic>
 #include <list>
 
 /**
@@ -173,9 +176,29 @@ private:
   uint64_t NextTs (void) const;
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /**
+   * Move the events scheduled by other threads into the event list.
+   * Must be called with #m_mutex locked.
+   */
+  void ProcessEventsWithContext (void);
   /** Destructor implementation. */
   virtual void DoDispose (void);
 
+  /** Wrap an event scheduled by another thread with its execution context. */
+  struct EventWithContext {
+    /** The event context. */
+    uint32_t context;
+    /**
+     * Event timestamp, absolute if \c relative is \c false, otherwise
+     * relative to the time at which the event is moved to the event list.
+     */
+    uint64_t timestamp;
+    /** Whether the timestamp is relative. */
+    bool relative;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+
   /** Container type for events to be run at destroy time. */
   typedef std::list<EventId> DestroyEvents;
   /** Container for events to be run at destroy time. */
@@ -183,7 +206,13 @@ private:
   /** Has the stopping condition been reached? */
   bool m_stop;
   /** Is the simulator currently running. */
-  bool m_running;
+  std::atomic<bool> m_running;
+  /**
+   * The queue of events scheduled by other threads, to which they add
+   * events without locking #m_mutex.  Events are only removed with
+   * #m_mutex locked.
+   */
+  MpscQueue<struct EventWithContext> m_eventsWithContext;
 
   /**
    * \name Mutex-protected variables.
@@ -221,6 +250,9 @@ private:
 
   /** Main SystemThread. */
   SystemThread::ThreadId m_main;
+
+  /** The event profiler, if enabled when Run() was called. */
+  EventProfiler *m_profiler;
 };
 
 } // namespace ns3
@@ -26,8 +26,12 @@
 #include "default-deleter.h"
 #include "assert.h"
 #include "unused.h"
+#include "ns3/core-config.h"
 #include <stdint.h>
 #include <limits>
+#ifdef NS3_ATOMIC_REFCOUNT
+#include <atomic>
+#endif
 
 /**
  * \file
@@ -68,6 +72,14 @@ namespace ns3 {
  *      to the object it manages exist anymore.
  *
  * Interesting users of this class include ns3::Object as well as ns3::Packet.
+ *
+ * When ns-3 is configured with --enable-atomic-refcount, the reference
+ * count is atomic, so that the objects can be referenced from the
+ * threads of a multithreaded simulator: for example, a channel
+ * references the devices of the nodes of all the partitions.  This
+ * does not make the objects themselves thread safe.  Otherwise, the
+ * count is a plain integer, which single-threaded simulations do not
+ * pay for.
  */
 template <typename T, typename PARENT = empty, typename DELETER = DefaultDeleter<T> >
 class SimpleRefCount : public PARENT
@@ -104,8 +116,13 @@ public:
    */
   inline void Ref (void) const
   {
+#ifdef NS3_ATOMIC_REFCOUNT
+    NS_ASSERT (m_count.load (std::memory_order_relaxed) < std::numeric_limits<uint32_t>::max());
+    m_count.fetch_add (1, std::memory_order_relaxed);
+#else
     NS_ASSERT (m_count < std::numeric_limits<uint32_t>::max());
     m_count++;
+#endif
   }
   /**
    * Decrement the reference count. This method should not be called
@@ -115,8 +132,13 @@ public:
    */
   inline void Unref (void) const
   {
+#ifdef NS3_ATOMIC_REFCOUNT
+    // The last reference must see the changes made through the others
+    if (m_count.fetch_sub (1, std::memory_order_acq_rel) == 1)
+#else
     m_count--;
     if (m_count == 0)
+#endif
       {
         DELETER::Delete (static_cast<T*> (const_cast<SimpleRefCount *> (this)));
       }
@@ -130,7 +152,11 @@ public:
    */
   inline uint32_t GetReferenceCount (void) const
   {
+#ifdef NS3_ATOMIC_REFCOUNT
+    return m_count.load (std::memory_order_relaxed);
+#else
     return m_count;
+#endif
   }
 
 private:
@@ -141,7 +167,11 @@ private:
    * Note we make this mutable so that the const methods can still
    * change it.
    */
+#ifdef NS3_ATOMIC_REFCOUNT
+  mutable std::atomic<uint32_t> m_count;
+#else
   mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
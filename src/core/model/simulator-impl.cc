@@ -42,4 +42,17 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+bool
+SimulatorImpl::IsConcurrent (uint32_t context) const
+{
+  return false;
+}
+
+uint32_t
+SimulatorImpl::AllocateUid (void)
+{
+  static uint32_t uid = 0;
+  return uid++;
+}
+
 } // namespace ns3
@@ -99,6 +99,20 @@ public:
   virtual uint32_t GetSystemId () const = 0; 
   /** \copydoc Simulator::GetContext */
   virtual uint32_t GetContext (void) const = 0;
+  /**
+   * \copydoc Simulator::IsConcurrent
+   *
+   * The default implementation runs all the events in a single thread,
+   * and returns \c false.
+   */
+  virtual bool IsConcurrent (uint32_t context) const;
+  /**
+   * \copydoc Simulator::AllocateUid
+   *
+   * The default implementation allocates the identifiers from a
+   * single counter, which is not reset by Simulator::Destroy.
+   */
+  virtual uint32_t AllocateUid (void);
   /** \copydoc Simulator::GetEventCount */
   virtual uint64_t GetEventCount (void) const = 0;
 
@@ -24,6 +24,7 @@
 #include "map-scheduler.h"
 #include "event-impl.h"
 #include "des-metrics.h"
+#include "event-profiler.h"
 
 #include "ptr.h"
 #include "string.h"
@@ -150,6 +151,12 @@ Simulator::Destroy (void)
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
+
+  EventProfiler *profiler = EventProfiler::GetEnabled ();
+  if (profiler != 0)
+    {
+      profiler->Flush ();
+    }
 }
 
 void
@@ -323,6 +330,18 @@ Simulator::GetContext (void)
 {
   return GetImpl ()->GetContext ();
 }
+
+bool
+Simulator::IsConcurrent (uint32_t context)
+{
+  return GetImpl ()->IsConcurrent (context);
+}
+
+uint32_t
+Simulator::AllocateUid (void)
+{
+  return GetImpl ()->AllocateUid ();
+}
   
 uint64_t
 Simulator::GetEventCount (void)
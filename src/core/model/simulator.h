@@ -198,6 +198,36 @@ public:
     NO_CONTEXT = 0xffffffff
   };
 
+  /**
+   * Check whether the events of a context may run concurrently with
+   * the current event.
+   *
+   * This is the case when the context is owned by another partition
+   * than the current one in a ns3::MultithreadedSimulatorImpl.  The
+   * objects bound to an event scheduled with ScheduleWithContext for
+   * such a context are then used by another thread, so they must not
+   * share any state which is not thread safe with the current
+   * context: for example, a packet must be handed over as a
+   * Packet::DeepCopy rather than as a Packet::Copy.
+   *
+   * @param [in] context The context of the event.
+   * @return \c true if the events of this context may run in another
+   *         thread.
+   */
+  static bool IsConcurrent (uint32_t context);
+
+  /**
+   * Allocate an identifier, e.g., the uid of a packet.
+   *
+   * The identifiers are unique among those allocated by this method,
+   * until they wrap around.  With ns3::MultithreadedSimulatorImpl,
+   * each partition allocates its own identifiers, so that they do not
+   * depend on the interleaving of the threads.
+   *
+   * @return A new identifier.
+   */
+  static uint32_t AllocateUid (void);
+
   /**
    * Get the number of events executed.
    * \returns The total number of events executed.
@@ -0,0 +1,387 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/event-profiler.h"
+#include "ns3/make-event.h"
+#include "ns3/event-impl.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Check the names of the functions scheduled by events.
+ */
+class EventProfilerNameTestCase : public TestCase
+{
+public:
+  EventProfilerNameTestCase ();
+
+  /** A member function to schedule. */
+  void Member (int a, double b);
+
+private:
+  virtual void DoRun (void);
+};
+
+/** A function to schedule. */
+static void
+EventProfilerFunction (void)
+{
+}
+
+EventProfilerNameTestCase::EventProfilerNameTestCase ()
+  : TestCase ("Check the names of the scheduled functions")
+{
+}
+
+void
+EventProfilerNameTestCase::Member (int a, double b)
+{
+}
+
+void
+EventProfilerNameTestCase::DoRun (void)
+{
+  EventImpl *event = MakeEvent (&EventProfilerNameTestCase::Member, this, 1, 2.0);
+  NS_TEST_EXPECT_MSG_EQ (EventProfiler::GetFunctionName (typeid (*event)),
+                         "void (EventProfilerNameTestCase::*)(int, double)",
+                         "Wrong member function type");
+  NS_TEST_EXPECT_MSG_EQ (EventProfiler::GetFunctionName (event->GetFunction (), typeid (*event)),
+                         "EventProfilerNameTestCase::Member(int, double)",
+                         "Wrong member function name");
+  event->Unref ();
+
+  // A static function has no exported symbol
+  event = MakeEvent (&EventProfilerFunction);
+  NS_TEST_EXPECT_MSG_EQ (EventProfiler::GetFunctionName (typeid (*event)),
+                         "void (*)()",
+                         "Wrong function type");
+  std::string name = EventProfiler::GetFunctionName (event->GetFunction (), typeid (*event));
+  NS_TEST_EXPECT_MSG_EQ (name.substr (0, 14), "void (*)() at ", "Wrong function name");
+  event->Unref ();
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Run events with the profiler enabled, and check the event counts
+ * of the folded stacks written by Simulator::Destroy().
+ */
+class EventProfilerFoldedTestCase : public TestCase
+{
+public:
+  EventProfilerFoldedTestCase ();
+
+  /** An event. */
+  void EventA (void);
+  /**
+   * Another event.
+   * \param n Unused.
+   */
+  void EventB (int n);
+
+private:
+  virtual void DoRun (void);
+};
+
+EventProfilerFoldedTestCase::EventProfilerFoldedTestCase ()
+  : TestCase ("Check the event counts of the folded stacks")
+{
+}
+
+void
+EventProfilerFoldedTestCase::EventA (void)
+{
+}
+
+void
+EventProfilerFoldedTestCase::EventB (int n)
+{
+}
+
+void
+EventProfilerFoldedTestCase::DoRun (void)
+{
+  std::string output = CreateTempDirFilename ("event-profile.folded");
+  GlobalValue::Bind ("EventProfilerOutput", StringValue (output));
+  GlobalValue::Bind ("EventProfilerFormat", StringValue ("folded"));
+
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventProfilerFoldedTestCase::EventA, this);
+      Simulator::ScheduleWithContext (7, MicroSeconds (i), &EventProfilerFoldedTestCase::EventB, this, i);
+    }
+  EventId cancelled = Simulator::Schedule (MicroSeconds (10), &EventProfilerFoldedTestCase::EventB, this, 0);
+  Simulator::Cancel (cancelled);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  GlobalValue::Bind ("EventProfilerOutput", StringValue (""));
+  GlobalValue::Bind ("EventProfilerFormat", StringValue ("report"));
+
+  // The folded stacks only hold times, which are not checked, so
+  // count the lines of each stack.
+  std::ifstream file (output.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.good (), true, "Could not open " << output);
+  std::map<std::string, uint32_t> stacks;
+  std::string line;
+  while (std::getline (file, line))
+    {
+      stacks[line.substr (0, line.rfind (' '))]++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (stacks.size (), 2, "Wrong number of stacks");
+  NS_TEST_EXPECT_MSG_EQ (stacks["EventProfilerFoldedTestCase::EventA();context none"], 1,
+                         "Missing stack of EventA");
+  NS_TEST_EXPECT_MSG_EQ (stacks["EventProfilerFoldedTestCase::EventB(int);context 7"], 1,
+                         "Missing stack of EventB");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Run events with the profiler enabled, and check the event counts
+ * of the report written by Simulator::Destroy().
+ */
+class EventProfilerReportTestCase : public TestCase
+{
+public:
+  EventProfilerReportTestCase ();
+
+  /** An event. */
+  void Event (void);
+
+private:
+  virtual void DoRun (void);
+};
+
+EventProfilerReportTestCase::EventProfilerReportTestCase ()
+  : TestCase ("Check the event counts of the report")
+{
+}
+
+void
+EventProfilerReportTestCase::Event (void)
+{
+}
+
+void
+EventProfilerReportTestCase::DoRun (void)
+{
+  std::string output = CreateTempDirFilename ("event-profile.txt");
+  GlobalValue::Bind ("EventProfilerOutput", StringValue (output));
+
+  for (uint32_t i = 0; i < 5; ++i)
+    {
+      Simulator::ScheduleWithContext (i % 2, MicroSeconds (i), &EventProfilerReportTestCase::Event, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  GlobalValue::Bind ("EventProfilerOutput", StringValue (""));
+
+  std::ifstream file (output.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.good (), true, "Could not open " << output);
+  std::string line;
+  std::getline (file, line);
+  NS_TEST_EXPECT_MSG_EQ (line.substr (0, 25), "Event profile: 5 events i", "Wrong total");
+
+  // Read the event count column of the rows of each section.
+  std::map<std::string, uint64_t> counts;
+  std::string section;
+  while (std::getline (file, line))
+    {
+      if (line.empty () || line.find ("Time (s)") != std::string::npos)
+        {
+          continue;
+        }
+      if (line[line.size () - 1] == ':')
+        {
+          section = line;
+          continue;
+        }
+      std::istringstream iss (line);
+      double time, percent, mean;
+      uint64_t count;
+      std::string name;
+      iss >> time >> percent >> count >> mean;
+      std::getline (iss >> std::ws, name);
+      counts[section + name] = count;
+    }
+  NS_TEST_EXPECT_MSG_EQ (counts.size (), 3, "Wrong number of rows");
+  NS_TEST_EXPECT_MSG_EQ (counts["By function:EventProfilerReportTestCase::Event()"], 5,
+                         "Wrong count of the function");
+  NS_TEST_EXPECT_MSG_EQ (counts["By context:0"], 3, "Wrong count of context 0");
+  NS_TEST_EXPECT_MSG_EQ (counts["By context:1"], 2, "Wrong count of context 1");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * A class with a virtual method, scheduled by EventProfilerMethodsTestCase.
+ */
+class EventProfilerBase
+{
+public:
+  virtual ~EventProfilerBase ();
+  /** A virtual method. */
+  virtual void Virtual (void);
+};
+
+EventProfilerBase::~EventProfilerBase ()
+{
+}
+
+void
+EventProfilerBase::Virtual (void)
+{
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * A class overriding the virtual method of EventProfilerBase.
+ */
+class EventProfilerDerived : public EventProfilerBase
+{
+public:
+  virtual void Virtual (void);
+};
+
+void
+EventProfilerDerived::Virtual (void)
+{
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Run events of two methods with the same signature, and of a virtual
+ * method, and check that the report counts each method separately.
+ */
+class EventProfilerMethodsTestCase : public TestCase
+{
+public:
+  EventProfilerMethodsTestCase ();
+
+  /**
+   * An event.
+   * \param n Unused.
+   */
+  void EventA (int n);
+  /**
+   * An event with the signature of EventA.
+   * \param n Unused.
+   */
+  void EventB (int n);
+
+private:
+  virtual void DoRun (void);
+};
+
+EventProfilerMethodsTestCase::EventProfilerMethodsTestCase ()
+  : TestCase ("Check that the methods with the same signature are profiled separately")
+{
+}
+
+void
+EventProfilerMethodsTestCase::EventA (int n)
+{
+}
+
+void
+EventProfilerMethodsTestCase::EventB (int n)
+{
+}
+
+void
+EventProfilerMethodsTestCase::DoRun (void)
+{
+  std::string output = CreateTempDirFilename ("event-profile-methods.txt");
+  GlobalValue::Bind ("EventProfilerOutput", StringValue (output));
+
+  EventProfilerDerived derived;
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (i), &EventProfilerMethodsTestCase::EventA, this, i);
+      if (i < 3)
+        {
+          Simulator::Schedule (MicroSeconds (i), &EventProfilerMethodsTestCase::EventB, this, i);
+        }
+      if (i < 2)
+        {
+          // Runs the method of the derived class
+          Simulator::Schedule (MicroSeconds (i), &EventProfilerBase::Virtual, &derived);
+        }
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  GlobalValue::Bind ("EventProfilerOutput", StringValue (""));
+
+  std::ifstream file (output.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.good (), true, "Could not open " << output);
+  std::map<std::string, uint64_t> counts;
+  std::string line;
+  while (std::getline (file, line) && line != "By context:")
+    {
+      std::istringstream iss (line);
+      double time, percent, mean;
+      uint64_t count;
+      std::string name;
+      if (iss >> time >> percent >> count >> mean)
+        {
+          std::getline (iss >> std::ws, name);
+          counts[name] = count;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (counts.size (), 3, "Wrong number of functions");
+  NS_TEST_EXPECT_MSG_EQ (counts["EventProfilerMethodsTestCase::EventA(int)"], 4,
+                         "Wrong count of EventA");
+  NS_TEST_EXPECT_MSG_EQ (counts["EventProfilerMethodsTestCase::EventB(int)"], 3,
+                         "Wrong count of EventB");
+  NS_TEST_EXPECT_MSG_EQ (counts["EventProfilerDerived::Virtual()"], 2,
+                         "Wrong count of the virtual method");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The event profiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+public:
+  EventProfilerTestSuite ()
+    : TestSuite ("event-profiler", UNIT)
+  {
+    AddTestCase (new EventProfilerNameTestCase (), TestCase::QUICK);
+    AddTestCase (new EventProfilerFoldedTestCase (), TestCase::QUICK);
+    AddTestCase (new EventProfilerReportTestCase (), TestCase::QUICK);
+    AddTestCase (new EventProfilerMethodsTestCase (), TestCase::QUICK);
+  }
+};
+
+static EventProfilerTestSuite g_eventProfilerTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/ladder-queue-scheduler.h"
+#include "ns3/map-scheduler.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Replay the events scheduled by a wifi simulation, which mixes slot and
+ * SIFS delays with beacon, rate control and application events up to
+ * tens of seconds away, and check that the ladder queue returns them in
+ * the same order as MapScheduler.  Several copies of the trace can be
+ * replayed concurrently, as if the simulation had more nodes, and
+ * timers can be added, most of which are removed before they expire.
+ */
+class LadderQueueTraceTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param copies The number of concurrent copies of the trace.
+   * \param timerInterval Start a timer every this many events, or
+   *        never if 0.
+   */
+  LadderQueueTraceTestCase (uint32_t copies, uint32_t timerInterval);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Insert an event in both schedulers.
+   * \param ts The event timestamp.
+   * \param context The event context.
+   * \return The event.
+   */
+  Scheduler::Event Insert (uint64_t ts, uint32_t context);
+  /**
+   * Remove the next event from both schedulers, and check that it is
+   * the same.
+   * \return The event.
+   */
+  Scheduler::Event RemoveNext (void);
+
+  uint32_t m_copies;                 //!< Number of copies of the trace
+  uint32_t m_timerInterval;          //!< Start a timer every this many events
+  Ptr<Scheduler> m_ladder;           //!< The scheduler under test
+  Ptr<Scheduler> m_reference;        //!< The reference scheduler
+  uint32_t m_uid;                    //!< The next event uid
+  std::vector<Scheduler::Event> m_timers; //!< The pending timers
+};
+
+/// The context of the timers
+static const uint32_t TIMER_CONTEXT = 0xffffffff;
+
+LadderQueueTraceTestCase::LadderQueueTraceTestCase (uint32_t copies, uint32_t timerInterval)
+  : TestCase ("Replay " + std::to_string (copies) + " copies of a wifi event trace" +
+              (timerInterval == 0 ? std::string () :
+               ", with a timer every " + std::to_string (timerInterval) + " events")),
+    m_copies (copies),
+    m_timerInterval (timerInterval)
+{
+}
+
+Scheduler::Event
+LadderQueueTraceTestCase::Insert (uint64_t ts, uint32_t context)
+{
+  Scheduler::Event ev;
+  // The schedulers only store the event implementations, so any
+  // distinct pointer identifies an event.
+  ev.impl = reinterpret_cast<EventImpl *> (static_cast<uintptr_t> (m_uid + 1) * 8);
+  ev.key.m_ts = ts;
+  ev.key.m_uid = m_uid++;
+  ev.key.m_context = context;
+  m_ladder->Insert (ev);
+  m_reference->Insert (ev);
+  return ev;
+}
+
+Scheduler::Event
+LadderQueueTraceTestCase::RemoveNext (void)
+{
+  Scheduler::Event ev = m_ladder->RemoveNext ();
+  Scheduler::Event ref = m_reference->RemoveNext ();
+  NS_TEST_EXPECT_MSG_EQ (ev.key.m_ts, ref.key.m_ts, "Wrong event timestamp");
+  NS_TEST_EXPECT_MSG_EQ (ev.key.m_uid, ref.key.m_uid, "Wrong event uid");
+  NS_TEST_EXPECT_MSG_EQ (ev.key.m_context, ref.key.m_context, "Wrong event context");
+  NS_TEST_EXPECT_MSG_EQ (ev.impl, ref.impl, "Wrong event implementation");
+  if (ref.key.m_context == TIMER_CONTEXT)
+    {
+      for (std::vector<Scheduler::Event>::iterator i = m_timers.begin (); i != m_timers.end (); ++i)
+        {
+          if (i->key.m_uid == ref.key.m_uid)
+            {
+              m_timers.erase (i);
+              break;
+            }
+        }
+    }
+  return ref;
+}
+
+void
+LadderQueueTraceTestCase::DoRun (void)
+{
+  std::ifstream file (CreateDataDirFilename ("wifi-event-trace.txt").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.good (), true, "Cannot open the event trace");
+  std::vector<std::vector<uint64_t> > trace;
+  std::string line;
+  while (std::getline (file, line))
+    {
+      if (!line.empty () && line[0] == '#')
+        {
+          continue;
+        }
+      std::istringstream delays (line);
+      std::vector<uint64_t> events;
+      uint64_t delay;
+      while (delays >> delay)
+        {
+          events.push_back (delay);
+        }
+      trace.push_back (events);
+    }
+  NS_TEST_ASSERT_MSG_GT (trace.size (), 10000, "Event trace too short");
+
+  m_ladder = CreateObject<LadderQueueScheduler> ();
+  m_reference = CreateObject<MapScheduler> ();
+  m_uid = 0;
+  m_timers.clear ();
+
+  // The first line holds the events scheduled before the simulation
+  // starts.  Copy c starts c microseconds late and consumes line
+  // next[c] when one of its events is run.
+  std::vector<std::size_t> next (m_copies, 1);
+  for (uint32_t c = 0; c < m_copies; ++c)
+    {
+      for (std::size_t i = 0; i < trace[0].size (); ++i)
+        {
+          Insert (c * 1000 + trace[0][i], c);
+        }
+    }
+  uint32_t events = 0;
+  while (!m_reference->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_ladder->IsEmpty (), false, "Ladder queue should not be empty");
+      Scheduler::Event ev = RemoveNext ();
+      uint32_t c = ev.key.m_context;
+      if (c == TIMER_CONTEXT || next[c] == trace.size ())
+        {
+          continue;
+        }
+      const std::vector<uint64_t> &delays = trace[next[c]++];
+      for (std::size_t i = 0; i < delays.size (); ++i)
+        {
+          Insert (ev.key.m_ts + delays[i], c);
+        }
+      events++;
+      if (m_timerInterval != 0 && events % m_timerInterval == 0)
+        {
+          // Timeouts from a few microseconds to seconds
+          static const uint64_t timeouts[] = { 75000, 3000000, 1000000000, 5000 };
+          uint64_t timeout = timeouts[(events / m_timerInterval) % 4];
+          m_timers.push_back (Insert (ev.key.m_ts + timeout, TIMER_CONTEXT));
+          if (m_timers.size () > 4 * m_copies)
+            {
+              Scheduler::Event timer = m_timers.front ();
+              m_timers.erase (m_timers.begin ());
+              m_ladder->Remove (timer);
+              m_reference->Remove (timer);
+            }
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (events, m_copies * (trace.size () - 1), "Some events of the trace were not run");
+  NS_TEST_EXPECT_MSG_EQ (m_ladder->IsEmpty (), true, "Ladder queue should be empty");
+  m_ladder = 0;
+  m_reference = 0;
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The ladder queue scheduler test suite.
+ */
+class LadderQueueSchedulerTestSuite : public TestSuite
+{
+public:
+  LadderQueueSchedulerTestSuite ()
+    : TestSuite ("ladder-queue-scheduler", UNIT)
+  {
+    SetDataDir (NS_TEST_SOURCEDIR);
+    AddTestCase (new LadderQueueTraceTestCase (1, 0), TestCase::QUICK);
+    AddTestCase (new LadderQueueTraceTestCase (1, 3), TestCase::QUICK);
+    AddTestCase (new LadderQueueTraceTestCase (20, 3), TestCase::QUICK);
+  }
+};
+
+static LadderQueueSchedulerTestSuite g_ladderQueueSchedulerTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/mpsc-queue.h"
+#include "ns3/system-thread.h"
+
+#include <thread>  // yield
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * An item pushed by a producer.
+ */
+struct MpscQueueTestItem
+{
+  uint32_t producer;  //!< The producer which pushed the item.
+  uint32_t sequence;  //!< The rank of the item among those of the producer.
+};
+
+/**
+ * \ingroup core-tests
+ *
+ * Push and pop the items from a single thread.
+ */
+class MpscQueueFifoTestCase : public TestCase
+{
+public:
+  MpscQueueFifoTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MpscQueueFifoTestCase::MpscQueueFifoTestCase ()
+  : TestCase ("Check the FIFO order of a single producer")
+{
+}
+
+void
+MpscQueueFifoTestCase::DoRun (void)
+{
+  MpscQueue<int> queue;
+  int item = -1;
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "A new queue should be empty");
+  NS_TEST_ASSERT_MSG_EQ (queue.Pop (item), false, "Pop should fail on an empty queue");
+
+  for (int i = 0; i < 10; i++)
+    {
+      queue.Push (i);
+    }
+  for (int i = 0; i < 5; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (queue.Pop (item), true, "Missing item " << i);
+      NS_TEST_ASSERT_MSG_EQ (item, i, "Wrong order");
+    }
+  // Push after some items have been popped
+  queue.Push (10);
+  for (int i = 5; i < 11; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), false, "The queue should not be empty");
+      NS_TEST_ASSERT_MSG_EQ (queue.Pop (item), true, "Missing item " << i);
+      NS_TEST_ASSERT_MSG_EQ (item, i, "Wrong order");
+    }
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "The queue should be empty");
+  NS_TEST_ASSERT_MSG_EQ (queue.Pop (item), false, "Pop should fail on an empty queue");
+
+  // The remaining items are discarded by the destructor
+  queue.Push (11);
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Push items from several threads while the main thread pops them.
+ */
+class MpscQueueProducersTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] producers The number of producer threads.
+   */
+  MpscQueueProducersTestCase (uint32_t producers);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Push the items of a producer.
+   * \param [in] arg The test case and the producer index.
+   */
+  static void Produce (std::pair<MpscQueueProducersTestCase *, uint32_t> arg);
+
+  uint32_t m_producers;                 //!< The number of producers.
+  MpscQueue<MpscQueueTestItem> m_queue; //!< The queue.
+};
+
+/** The number of items pushed by each producer. */
+static const uint32_t N_ITEMS = 100000;
+
+MpscQueueProducersTestCase::MpscQueueProducersTestCase (uint32_t producers)
+  : TestCase ("Check the items pushed by " + std::to_string (producers) + " concurrent producers"),
+    m_producers (producers)
+{
+}
+
+void
+MpscQueueProducersTestCase::Produce (std::pair<MpscQueueProducersTestCase *, uint32_t> arg)
+{
+  MpscQueueTestItem item;
+  item.producer = arg.second;
+  for (uint32_t i = 0; i < N_ITEMS; i++)
+    {
+      item.sequence = i;
+      arg.first->m_queue.Push (item);
+    }
+}
+
+void
+MpscQueueProducersTestCase::DoRun (void)
+{
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < m_producers; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (
+          MakeBoundCallback (&MpscQueueProducersTestCase::Produce, std::make_pair (this, i)));
+      threads.push_back (thread);
+      thread->Start ();
+    }
+
+  // Pop concurrently with the producers: each producer's items must come
+  // out in the order it pushed them, and none may be lost or duplicated.
+  std::vector<uint32_t> next (m_producers, 0);
+  uint64_t popped = 0;
+  bool ordered = true;
+  bool known = true;
+  MpscQueueTestItem item;
+  while (popped < static_cast<uint64_t> (m_producers) * N_ITEMS)
+    {
+      if (!m_queue.Pop (item))
+        {
+          std::this_thread::yield ();
+          continue;
+        }
+      popped++;
+      if (item.producer >= m_producers)
+        {
+          known = false;
+          continue;
+        }
+      if (item.sequence != next[item.producer])
+        {
+          ordered = false;
+        }
+      next[item.producer] = item.sequence + 1;
+    }
+
+  for (uint32_t i = 0; i < m_producers; i++)
+    {
+      threads[i]->Join ();
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (known, true, "Item of an unknown producer");
+  NS_TEST_EXPECT_MSG_EQ (ordered, true, "Items of a producer popped out of order");
+  for (uint32_t i = 0; i < m_producers; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (next[i], N_ITEMS, "Items of producer " << i << " lost");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_queue.IsEmpty (), true, "Items left after all have been popped");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * MpscQueue test suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+public:
+  MpscQueueTestSuite ();
+};
+
+MpscQueueTestSuite::MpscQueueTestSuite ()
+  : TestSuite ("mpsc-queue", UNIT)
+{
+  AddTestCase (new MpscQueueFifoTestCase, TestCase::QUICK);
+  AddTestCase (new MpscQueueProducersTestCase (1), TestCase::QUICK);
+  AddTestCase (new MpscQueueProducersTestCase (4), TestCase::QUICK);
+}
+
+static MpscQueueTestSuite g_mpscQueueTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/heap-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Run a set of contexts exchanging events with ScheduleWithContext,
+ * and check that the multithreaded simulator processes exactly the same
+ * events, at the same times, as the default simulator.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param schedulerFactory The scheduler of each partition.
+   * \param threads The number of partitions.
+   */
+  MultithreadedSimulatorTestCase (ObjectFactory schedulerFactory, uint32_t threads);
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  /**
+   * Run the scenario with a simulator implementation.
+   * \param simulatorType The simulator implementation.
+   * \return The timestamps of the events processed by each context.
+   */
+  std::vector<std::vector<uint64_t> > RunScenario (std::string simulatorType);
+  /**
+   * Event handler: log the event, schedule a local or a remote event.
+   * \param context The context this event was scheduled for.
+   */
+  void Hop (uint32_t context);
+
+  ObjectFactory m_schedulerFactory;                 //!< The scheduler factory
+  uint32_t m_threads;                               //!< The number of partitions
+  std::vector<std::vector<uint64_t> > m_timestamps; //!< Per-context event timestamps
+  bool m_contextError;                              //!< Wrong context detected
+};
+
+/// The number of contexts in the scenario
+static const uint32_t N_CONTEXTS = 8;
+/// The lookahead used for cross-context events
+static const Time LOOKAHEAD = MicroSeconds (5);
+/// The end of the scenario
+static const Time DURATION = MilliSeconds (2);
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (ObjectFactory schedulerFactory, uint32_t threads)
+  : TestCase ("Check parallel event handling with " +
+              std::to_string (threads) + " threads, " +
+              schedulerFactory.GetTypeId ().GetName () + " scheduler"),
+    m_schedulerFactory (schedulerFactory),
+    m_threads (threads)
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Hop (uint32_t context)
+{
+  if (Simulator::GetContext () != context)
+    {
+      m_contextError = true;
+    }
+  // Only the partition owning the context touches this vector.
+  m_timestamps[context].push_back (Simulator::Now ().GetTimeStep ());
+  if (Simulator::Now () > DURATION)
+    {
+      return;
+    }
+  // Alternate between local and remote events
+  if (m_timestamps[context].size () % 2 == 0)
+    {
+      Simulator::Schedule (MicroSeconds (3), &MultithreadedSimulatorTestCase::Hop, this, context);
+    }
+  else
+    {
+      uint32_t next = (context * 3 + 1) % N_CONTEXTS;
+      Simulator::ScheduleWithContext (next, LOOKAHEAD + NanoSeconds (context * 100),
+                                      &MultithreadedSimulatorTestCase::Hop, this, next);
+    }
+}
+
+std::vector<std::vector<uint64_t> >
+MultithreadedSimulatorTestCase::RunScenario (std::string simulatorType)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (m_threads));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (LOOKAHEAD));
+  Simulator::SetScheduler (m_schedulerFactory);
+
+  m_timestamps.assign (N_CONTEXTS, std::vector<uint64_t> ());
+  m_contextError = false;
+  for (uint32_t i = 0; i < N_CONTEXTS; ++i)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (i), &MultithreadedSimulatorTestCase::Hop, this, i);
+    }
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_contextError, false, "Event run with a wrong context in " << simulatorType);
+  uint64_t events = 0;
+  for (uint32_t i = 0; i < N_CONTEXTS; ++i)
+    {
+      events += m_timestamps[i].size ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetEventCount (), events, "Wrong event count in " << simulatorType);
+  Simulator::Destroy ();
+  return m_timestamps;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  std::vector<std::vector<uint64_t> > reference = RunScenario ("ns3::DefaultSimulatorImpl");
+  std::vector<std::vector<uint64_t> > parallel = RunScenario ("ns3::MultithreadedSimulatorImpl");
+
+  for (uint32_t i = 0; i < N_CONTEXTS; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (parallel[i].size (), reference[i].size (),
+                             "Wrong number of events for context " << i);
+      for (uint32_t j = 0; j < reference[i].size (); ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ (parallel[i][j], reference[i][j],
+                                 "Wrong timestamp for event " << j << " of context " << i);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check the partitioning of the contexts.
+ */
+class MultithreadedSimulatorPartitionTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorPartitionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+};
+
+MultithreadedSimulatorPartitionTestCase::MultithreadedSimulatorPartitionTestCase ()
+  : TestCase ("Check the assignment of contexts to partitions")
+{
+}
+
+void
+MultithreadedSimulatorPartitionTestCase::DoRun (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (4));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (1)));
+
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Wrong simulator implementation");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), 4, "Wrong number of partitions");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLookahead (), MicroSeconds (1), "Wrong lookahead");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetPartition (Simulator::NO_CONTEXT), 0, "Events without context belong to partition 0");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetPartition (6), 2, "Wrong default partition");
+  impl->SetPartition (6, 1);
+  NS_TEST_EXPECT_MSG_EQ (impl->GetPartition (6), 1, "Wrong explicit partition");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetPartition (7), 3, "Wrong default partition");
+  Simulator::Destroy ();
+}
+
+void
+MultithreadedSimulatorPartitionTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The multithreaded simulator test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    ObjectFactory factory;
+    uint32_t threadcounts[] = { 1, 2, 3, 8 };
+    for (unsigned int i = 0; i < (sizeof (threadcounts) / sizeof (threadcounts[0])); ++i)
+      {
+        factory.SetTypeId (MapScheduler::GetTypeId ());
+        AddTestCase (new MultithreadedSimulatorTestCase (factory, threadcounts[i]), TestCase::QUICK);
+        factory.SetTypeId (HeapScheduler::GetTypeId ());
+        AddTestCase (new MultithreadedSimulatorTestCase (factory, threadcounts[i]), TestCase::QUICK);
+      }
+    AddTestCase (new MultithreadedSimulatorPartitionTestCase (), TestCase::QUICK);
+  }
+};
+
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite; //!< Static variable for test initialization
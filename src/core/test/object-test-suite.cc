@@ -398,6 +398,63 @@ AggregateObjectTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the cache of the lookups of GetObject.
+ */
+class GetObjectCacheTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  GetObjectCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GetObjectCacheTestCase::GetObjectCacheTestCase ()
+  : TestCase ("Check the cache of the GetObject lookups")
+{
+}
+
+void
+GetObjectCacheTestCase::DoRun (void)
+{
+  Ptr<BaseA> baseA = CreateObject<BaseA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+
+  //
+  // The lookups which failed before the aggregation must not be served
+  // by the cache after it.
+  //
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through baseA");
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through baseA");
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), 0, "Unexpectedly found a BaseA through derivedB");
+  baseA->AggregateObject (derivedB);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), derivedB, "Cannot GetObject (through baseA) for BaseB Object");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedB> (), derivedB, "Cannot GetObject (through baseA) for DerivedB Object");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<Object> (BaseB::GetTypeId ()), derivedB, "Cannot GetObject (through baseA) for BaseB TypeId");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), baseA, "Cannot GetObject (through derivedB) for BaseA Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (), 0, "Unexpectedly found a DerivedA through derivedB");
+    }
+
+  //
+  // Neither must the lookups which succeeded once the aggregation is
+  // extended.
+  //
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  Ptr<Object> object = CreateObject<Object> ();
+  object->AggregateObject (derivedA);
+  NS_TEST_ASSERT_MSG_EQ (object->GetObject<BaseA> (), derivedA, "Cannot GetObject (through object) for BaseA Object");
+  NS_TEST_ASSERT_MSG_EQ (object->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through object");
+  object->AggregateObject (CreateObject<BaseB> ());
+  NS_TEST_ASSERT_MSG_EQ (object->GetObject<BaseA> (), derivedA, "Cannot GetObject (through object) for BaseA Object");
+  NS_TEST_ASSERT_MSG_NE (object->GetObject<BaseB> (), 0, "Cannot GetObject (through object) for BaseB Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), object->GetObject<BaseB> (), "Inconsistent lookups");
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -489,6 +546,7 @@ ObjectTestSuite::ObjectTestSuite ()
 {
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
+  AddTestCase (new GetObjectCacheTestCase);
   AddTestCase (new ObjectFactoryTestCase);
 }
 
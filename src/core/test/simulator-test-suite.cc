@@ -21,8 +21,13 @@
 #include "ns3/simulator.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/dary-heap-scheduler.h"
+#include "ns3/ladder-queue-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/random-variable-stream.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -461,6 +466,110 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Drive a scheduler and a MapScheduler with the same random sequence of
+ * insertions, including bursts of insertions, and removals of the next
+ * or of arbitrary events, and check that they agree on every event.
+ */
+class SchedulerConsistencyTestCase : public TestCase
+{
+public:
+  SchedulerConsistencyTestCase (ObjectFactory schedulerFactory);
+private:
+  virtual void DoRun (void);
+  /**
+   * Check that both schedulers return the same event.
+   * \param a The event from the scheduler under test.
+   * \param b The event from the reference scheduler.
+   */
+  void CheckEvent (const Scheduler::Event &a, const Scheduler::Event &b);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerConsistencyTestCase::SchedulerConsistencyTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the event order of " + schedulerFactory.GetTypeId ().GetName () +
+              " against ns3::MapScheduler"),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SchedulerConsistencyTestCase::CheckEvent (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  NS_TEST_EXPECT_MSG_EQ (a.key.m_ts, b.key.m_ts, "Wrong event timestamp");
+  NS_TEST_EXPECT_MSG_EQ (a.key.m_uid, b.key.m_uid, "Wrong event uid");
+  NS_TEST_EXPECT_MSG_EQ (a.key.m_context, b.key.m_context, "Wrong event context");
+  NS_TEST_EXPECT_MSG_EQ (a.impl, b.impl, "Wrong event implementation");
+}
+
+void
+SchedulerConsistencyTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  // The schedulers only store the event implementations, so any
+  // distinct pointer identifies an event.
+  std::vector<Scheduler::Event> pending;
+  uint32_t uid = 0;
+  uint64_t now = 0;
+  for (uint32_t round = 0; round < 2000; ++round)
+    {
+      uint32_t inserts = rng->GetInteger (0, 4);
+      if (round % 100 == 0)
+        {
+          inserts = 1000;
+        }
+      for (uint32_t i = 0; i < inserts; ++i)
+        {
+          Scheduler::Event ev;
+          ev.impl = reinterpret_cast<EventImpl *> (static_cast<uintptr_t> (uid + 1) * 8);
+          // Mix simultaneous, close and far away events
+          static const uint32_t ranges[] = { 0, 20, 1000, 1000000000 };
+          ev.key.m_ts = now + rng->GetInteger (0, ranges[rng->GetInteger (0, 3)]);
+          ev.key.m_uid = uid++;
+          ev.key.m_context = rng->GetInteger (0, 10);
+          scheduler->Insert (ev);
+          reference->Insert (ev);
+          pending.push_back (ev);
+        }
+      if (!pending.empty () && rng->GetValue () < 0.3)
+        {
+          uint32_t i = rng->GetInteger (0, pending.size () - 1);
+          scheduler->Remove (pending[i]);
+          reference->Remove (pending[i]);
+          pending[i] = pending.back ();
+          pending.pop_back ();
+        }
+      uint32_t removes = rng->GetInteger (0, 4);
+      for (uint32_t i = 0; i < removes && !reference->IsEmpty (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "Scheduler should not be empty");
+          CheckEvent (scheduler->PeekNext (), reference->PeekNext ());
+          Scheduler::Event next = reference->RemoveNext ();
+          CheckEvent (scheduler->RemoveNext (), next);
+          now = next.key.m_ts;
+          for (std::size_t j = 0; j < pending.size (); ++j)
+            {
+              if (pending[j].key.m_uid == next.key.m_uid)
+                {
+                  pending[j] = pending.back ();
+                  pending.pop_back ();
+                  break;
+                }
+            }
+        }
+    }
+  while (!reference->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), false, "Scheduler should not be empty");
+      CheckEvent (scheduler->RemoveNext (), reference->RemoveNext ());
+    }
+  NS_TEST_EXPECT_MSG_EQ (scheduler->IsEmpty (), true, "Scheduler should be empty");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,7 +584,16 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (HeapScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderQueueScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SchedulerConsistencyTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderQueueScheduler::GetTypeId ());
+    AddTestCase (new SchedulerConsistencyTestCase (factory), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
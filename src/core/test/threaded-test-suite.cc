@@ -236,13 +236,16 @@ public:
 #ifdef HAVE_RT
       "ns3::RealtimeSimulatorImpl",
 #endif
+      "ns3::MultithreadedSimulatorImpl",
       "ns3::DefaultSimulatorImpl"
     };
     std::string schedulerTypes[] = {
       "ns3::ListScheduler",
       "ns3::HeapScheduler",
+      "ns3::DaryHeapScheduler",
       "ns3::MapScheduler",
-      "ns3::CalendarScheduler"
+      "ns3::CalendarScheduler",
+      "ns3::LadderQueueScheduler"
     };
     unsigned int threadcounts[] = {
       0,
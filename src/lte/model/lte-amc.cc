@@ -332,7 +332,7 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
   NS_LOG_FUNCTION (this);
 
   std::vector<int> cqi;
-  Values::const_iterator it;
+  SpectrumValue::ConstValuesIterator it;
   
   if (m_amcModel == PiroEW2010)
     {
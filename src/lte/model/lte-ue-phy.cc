@@ -612,7 +612,7 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
       // RSRP evaluated as averaged received power among RBs
       double sum = 0.0;
       uint8_t rbNum = 0;
-      Values::const_iterator it;
+      SpectrumValue::ConstValuesIterator it;
       for (it = m_rsReceivedPower.ConstValuesBegin (); it != m_rsReceivedPower.ConstValuesEnd (); it++)
         {
           // convert PSD [W/Hz] to linear power [W] for the single RE
@@ -650,8 +650,8 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
           uint16_t rbNum = 0;
           double rssiSum = 0.0;
 
-          Values::const_iterator itIntN = m_rsInterferencePower.ConstValuesBegin ();
-          Values::const_iterator itPj = m_rsReceivedPower.ConstValuesBegin ();
+          SpectrumValue::ConstValuesIterator itIntN = m_rsInterferencePower.ConstValuesBegin ();
+          SpectrumValue::ConstValuesIterator itPj = m_rsReceivedPower.ConstValuesBegin ();
           for (itPj = m_rsReceivedPower.ConstValuesBegin ();
                itPj != m_rsReceivedPower.ConstValuesEnd ();
                itIntN++, itPj++)
@@ -702,7 +702,7 @@ LteUePhy::ComputeAvgSinr (const SpectrumValue& sinr)
   // averaged SINR among RBs
   double sum = 0.0;
   uint8_t rbNum = 0;
-  Values::const_iterator it;
+  SpectrumValue::ConstValuesIterator it;
 
   for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
     {
@@ -815,7 +815,7 @@ LteUePhy::ReportRsReceivedPower (const SpectrumValue& power)
     {
       double sum = 0;
       uint32_t rbNum = 0;
-      Values::const_iterator it;
+      SpectrumValue::ConstValuesIterator it;
       for (it = m_rsReceivedPower.ConstValuesBegin (); it != m_rsReceivedPower.ConstValuesEnd (); it++)
         {
           double powerTxW = ((*it) * 180000);
@@ -1180,7 +1180,7 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
 
   double sum = 0.0;
   uint16_t nRB = 0;
-  Values::const_iterator itPi;
+  SpectrumValue::ConstValuesIterator itPi;
   for (itPi = p->ConstValuesBegin (); itPi != p->ConstValuesEnd (); itPi++)
     {
       // convert PSD [W/Hz] to linear power [W] for the single RE
@@ -198,7 +198,7 @@ void
 LteFrTestCase::DlDataRxStart (Ptr<const SpectrumValue> spectrumValue)
 {
   NS_LOG_DEBUG ("DL DATA Power allocation :");
-  Values::const_iterator it;
+  SpectrumValue::ConstValuesIterator it;
   uint32_t i = 0;
   for (it = spectrumValue->ConstValuesBegin (); it != spectrumValue->ConstValuesEnd (); it++)
     {
@@ -217,7 +217,7 @@ void
 LteFrTestCase::UlDataRxStart (Ptr<const SpectrumValue> spectrumValue)
 {
   NS_LOG_DEBUG ("UL DATA Power allocation :");
-  Values::const_iterator it;
+  SpectrumValue::ConstValuesIterator it;
   uint32_t i = 0;
   for (it = spectrumValue->ConstValuesBegin (); it != spectrumValue->ConstValuesEnd (); it++)
     {
@@ -509,7 +509,7 @@ LteFrAreaTestCase::DlDataRxStart (Ptr<const SpectrumValue> spectrumValue)
     }
 
   NS_LOG_DEBUG ("DL DATA Power allocation :");
-  Values::const_iterator it;
+  SpectrumValue::ConstValuesIterator it;
   uint32_t i = 0;
   for (it = spectrumValue->ConstValuesBegin (); it != spectrumValue->ConstValuesEnd (); it++)
     {
@@ -541,7 +541,7 @@ LteFrAreaTestCase::UlDataRxStart (Ptr<const SpectrumValue> spectrumValue)
     }
 
   NS_LOG_DEBUG ("UL DATA Power allocation :");
-  Values::const_iterator it;
+  SpectrumValue::ConstValuesIterator it;
   uint32_t i = 0;
   uint32_t numActiveRbs = 0;
 
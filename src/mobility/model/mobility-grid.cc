@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "mobility-grid.h"
+#include "mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MobilityGrid");
+
+MobilityGrid::MobilityGrid ()
+  : m_cellSize (1.0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MobilityGrid::~MobilityGrid ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+MobilityGrid::SetCellSize (double size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT (size > 0);
+  m_cellSize = size;
+  m_cells.clear ();
+  m_mobile.clear ();
+  for (uint32_t i = 0; i < m_entries.size (); i++)
+    {
+      // Update moves the model out of the list of moving models
+      m_entries[i].mobile = true;
+      m_mobile.push_back (i);
+      Update (i);
+    }
+}
+
+double
+MobilityGrid::GetCellSize (void) const
+{
+  return m_cellSize;
+}
+
+uint32_t
+MobilityGrid::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  NS_ASSERT (mobility != 0);
+  uint32_t index = m_entries.size ();
+  Entry entry;
+  entry.mobility = mobility;
+  entry.mobile = true;
+  entry.courseChange = MakeCallback (&MobilityGrid::CourseChanged, this).Bind (index);
+  mobility->TraceConnectWithoutContext ("CourseChange", entry.courseChange);
+  m_entries.push_back (entry);
+  m_mobile.push_back (index);
+  Update (index);
+  return index;
+}
+
+void
+MobilityGrid::Replace (uint32_t index, Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << index << mobility);
+  NS_ASSERT (index < m_entries.size ());
+  NS_ASSERT (mobility != 0);
+  Entry &entry = m_entries[index];
+  entry.mobility->TraceDisconnectWithoutContext ("CourseChange", entry.courseChange);
+  entry.mobility = mobility;
+  mobility->TraceConnectWithoutContext ("CourseChange", entry.courseChange);
+  Update (index);
+}
+
+uint32_t
+MobilityGrid::GetN (void) const
+{
+  return m_entries.size ();
+}
+
+void
+MobilityGrid::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Entry>::iterator i = m_entries.begin (); i != m_entries.end (); i++)
+    {
+      i->mobility->TraceDisconnectWithoutContext ("CourseChange", i->courseChange);
+    }
+  m_entries.clear ();
+  m_cells.clear ();
+  m_mobile.clear ();
+}
+
+MobilityGrid::Cell
+MobilityGrid::GetCell (const Vector &position) const
+{
+  return Cell (static_cast<int64_t> (std::floor (position.x / m_cellSize)),
+               static_cast<int64_t> (std::floor (position.y / m_cellSize)));
+}
+
+void
+MobilityGrid::Update (uint32_t index)
+{
+  Entry &entry = m_entries[index];
+  if (entry.mobile)
+    {
+      m_mobile.erase (std::find (m_mobile.begin (), m_mobile.end (), index));
+    }
+  else
+    {
+      std::vector<uint32_t> &cell = m_cells[entry.cell];
+      cell.erase (std::find (cell.begin (), cell.end (), index));
+    }
+  Vector velocity = entry.mobility->GetVelocity ();
+  entry.mobile = (velocity.x != 0 || velocity.y != 0 || velocity.z != 0);
+  if (entry.mobile)
+    {
+      m_mobile.push_back (index);
+    }
+  else
+    {
+      entry.position = entry.mobility->GetPosition ();
+      entry.cell = GetCell (entry.position);
+      m_cells[entry.cell].push_back (index);
+    }
+}
+
+void
+MobilityGrid::CourseChanged (uint32_t index, Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << index << mobility);
+  Update (index);
+}
+
+std::vector<uint32_t>
+MobilityGrid::GetInRange (const Vector &position, double range) const
+{
+  std::vector<uint32_t> indexes;
+  Cell cell = GetCell (position);
+  int64_t span = static_cast<int64_t> (std::ceil (range / m_cellSize));
+  for (int64_t x = cell.first - span; x <= cell.first + span; x++)
+    {
+      for (int64_t y = cell.second - span; y <= cell.second + span; y++)
+        {
+          std::map<Cell, std::vector<uint32_t> >::const_iterator it = m_cells.find (Cell (x, y));
+          if (it == m_cells.end ())
+            {
+              continue;
+            }
+          for (std::vector<uint32_t>::const_iterator i = it->second.begin (); i != it->second.end (); i++)
+            {
+              if (CalculateDistance (position, m_entries[*i].position) <= range)
+                {
+                  indexes.push_back (*i);
+                }
+            }
+        }
+    }
+  for (std::vector<uint32_t>::const_iterator i = m_mobile.begin (); i != m_mobile.end (); i++)
+    {
+      if (CalculateDistance (position, m_entries[*i].mobility->GetPosition ()) <= range)
+        {
+          indexes.push_back (*i);
+        }
+    }
+  std::sort (indexes.begin (), indexes.end ());
+  NS_LOG_DEBUG (indexes.size () << " of " << m_entries.size () << " models within " << range << "m");
+  return indexes;
+}
+
+} // namespace ns3
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MOBILITY_GRID_H
+#define MOBILITY_GRID_H
+
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include "ns3/callback.h"
+#include "ns3/non-copyable.h"
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief A uniform grid of the positions of a set of mobility models,
+ * to find the models within some range of a position without visiting
+ * all of them.
+ *
+ * The grid is updated when a model notifies a course change.  The
+ * models with a non-zero velocity are not put in the grid, since their
+ * position changes without notification: they are kept in a list and
+ * checked on each query.  The grid is two-dimensional, the distances
+ * are three-dimensional.
+ */
+class MobilityGrid : private NonCopyable
+{
+public:
+  MobilityGrid ();
+  ~MobilityGrid ();
+
+  /**
+   * Set the size of the cells, and put the models back in the grid.
+   * Queries are fastest with a range close to the cell size.
+   *
+   * \param size the size of the cells, in meters
+   */
+  void SetCellSize (double size);
+  /**
+   * \return the size of the cells, in meters
+   */
+  double GetCellSize (void) const;
+  /**
+   * Add a mobility model to the grid, and track its course changes.
+   *
+   * \param mobility the mobility model
+   * \return the index of the model, which is the number of models
+   *         added before it
+   */
+  uint32_t Add (Ptr<MobilityModel> mobility);
+  /**
+   * Replace a mobility model of the grid, and track the course changes
+   * of the new model instead of the old one.
+   *
+   * \param index the index of the model to replace
+   * \param mobility the new mobility model
+   */
+  void Replace (uint32_t index, Ptr<MobilityModel> mobility);
+  /**
+   * \return the number of models in the grid
+   */
+  uint32_t GetN (void) const;
+  /**
+   * Remove all the models from the grid.
+   */
+  void Clear (void);
+  /**
+   * \param position a position
+   * \param range the range, in meters
+   * \return the indexes of the models whose distance to the position
+   *         is at most range, in increasing order
+   */
+  std::vector<uint32_t> GetInRange (const Vector &position, double range) const;
+
+private:
+  /**
+   * A cell of the grid.
+   */
+  typedef std::pair<int64_t, int64_t> Cell;
+  /**
+   * The position of a model in the grid.
+   */
+  struct Entry
+  {
+    Ptr<MobilityModel> mobility; //!< The mobility model
+    Vector position;             //!< The position of a static model
+    bool mobile;                 //!< Whether the model is moving
+    Cell cell;                   //!< The cell of a static model
+    Callback<void, Ptr<const MobilityModel> > courseChange; //!< The CourseChange callback
+  };
+
+  /**
+   * \param position a position
+   * \return the cell holding the position
+   */
+  Cell GetCell (const Vector &position) const;
+  /**
+   * Move a model in the grid, or to the list of moving models.
+   *
+   * \param index the index of the model
+   */
+  void Update (uint32_t index);
+  /**
+   * Called when a model changes course.
+   *
+   * \param index the index of the model
+   * \param mobility the model
+   */
+  void CourseChanged (uint32_t index, Ptr<const MobilityModel> mobility);
+
+  double m_cellSize;                               //!< The size of the cells (m)
+  std::vector<Entry> m_entries;                    //!< The models
+  std::map<Cell, std::vector<uint32_t> > m_cells;  //!< The static models in each cell
+  std::vector<uint32_t> m_mobile;                  //!< The moving models
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_H */
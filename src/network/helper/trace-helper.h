@@ -222,6 +222,22 @@ public:
   Ptr<OutputStreamWrapper> CreateFileStream (std::string filename, 
                                              std::ios::openmode filemode = std::ios::out);
 
+  /**
+   * @brief Create and initialize an output stream object to which the
+   * default trace sinks write compact binary records instead of text.
+   *
+   * The stream can be passed to the EnableAscii methods of the helpers.
+   * Each event is written as a fixed-size record (see BinaryTraceFile),
+   * with the UID and the size of the packet instead of its printed headers,
+   * and optionally its first bytes.  The utils/decode-binary-trace program
+   * converts the file to text or CSV.
+   *
+   * @param filename file name
+   * @param nPacketBytes the maximum number of bytes of each packet stored
+   * @returns a smart pointer to the output stream
+   */
+  Ptr<OutputStreamWrapper> CreateBinaryFileStream (std::string filename, uint16_t nPacketBytes = 0);
+
   /**
    * @brief Hook a trace source to the default enqueue operation trace sink that
    * does not accept nor log a trace context.
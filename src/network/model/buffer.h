@@ -24,6 +24,7 @@
 #include <vector>
 #include <ostream>
 #include "ns3/assert.h"
+#include "ns3/data-pool.h"
 
 #define BUFFER_FREE_LIST 1
 
@@ -38,10 +39,15 @@ namespace ns3 {
  * automatically adjusted to hold any data prepended
  * or appended by the user. Its implementation is optimized
  * to ensure that the number of buffer resizes is minimized,
- * by creating new Buffers of the maximum size ever used.
+ * by creating new Buffers of the maximum size ever used, up to
+ * Buffer::MAX_RECOMMENDED_SIZE.
  * The correct maximum size is learned at runtime during use by 
  * recording the maximum size of each packet.
  *
+ * The data of the buffers are allocated from a DataPool of each
+ * thread, whose limits and statistics are available with
+ * Buffer::SetPoolLimits and Buffer::GetPoolStats.
+ *
  * \internal
  * The implementation of the Buffer class uses a COW (Copy On Write)
  * technique to ensure that the underlying data buffer which holds
@@ -555,6 +561,14 @@ private:
    */
   Buffer CreateFragment (uint32_t start, uint32_t length) const;
 
+  /**
+   * \brief Make this buffer the only one referencing its data.
+   *
+   * The data shared with other Buffer instances is copied, so that
+   * this buffer can be handed over to another thread.
+   */
+  void Unshare (void);
+
   /**
    * \return an Iterator which points to the
    * start of this Buffer.
@@ -642,6 +656,30 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \brief Set the limits of the pools of buffer data of all the threads
+   *
+   * The default limits are 4096 blocks per size class and 64 MiB per
+   * thread.
+   *
+   * \param maxBlocks the maximum number of blocks retained in each size class
+   * \param maxBytes the maximum number of bytes retained by each thread
+   */
+  static void SetPoolLimits (uint32_t maxBlocks, uint64_t maxBytes);
+  /**
+   * \brief Get the statistics of the pool of buffer data of the calling thread
+   *
+   * \returns the statistics of the pool
+   */
+  static DataPool::Stats GetPoolStats (void);
+
+  /**
+   * The largest size of the new buffer data learned from the
+   * packets: larger packets do not make all the buffers larger.
+   */
+  static const uint32_t MAX_RECOMMENDED_SIZE = 4096;
+
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -765,9 +803,15 @@ private:
   /**
    * location in a newly-allocated buffer where you should start
    * writing data. i.e., m_start should be initialized to this 
-   * value.
+   * value.  Each thread learns its own value.
    */
-  static uint32_t g_recommendedStart;
+  static thread_local uint32_t g_recommendedStart;
+  /**
+   * size of the data of a newly-allocated buffer: the maximum
+   * value of the internal end of the buffers, if it does not exceed
+   * MAX_RECOMMENDED_SIZE.  Each thread learns its own value.
+   */
+  static thread_local uint32_t g_recommendedSize;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -789,19 +833,6 @@ private:
    * instance from the start of m_data->m_data
    */
   uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-  /// Container for buffer data
-  typedef std::vector<struct Buffer::Data*> FreeList;
-  /// Local static destructor structure
-  struct LocalStaticDestructor 
-  {
-    ~LocalStaticDestructor ();
-  };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
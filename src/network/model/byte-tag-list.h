@@ -231,6 +231,14 @@ private:
    */
   void AddAtStart (int32_t prependOffset);
 
+  /**
+   * Make this list the only one referencing its data.
+   *
+   * The data shared with other ByteTagList instances is copied, so that
+   * this list can be handed over to another thread.
+   */
+  void Unshare (void);
+
 private:
   /**
    * \brief Returns an iterator pointing to the very first tag in this list.
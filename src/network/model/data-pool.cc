@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <new>
+#include "ns3/assert.h"
+#include "data-pool.h"
+
+namespace ns3 {
+
+const uint32_t DataPool::N_CLASSES;
+
+namespace {
+
+/// The size of the smallest size class (bytes)
+const uint32_t DATA_POOL_MIN_SIZE = 64;
+
+/** The pools of the current thread which retain blocks. */
+thread_local DataPool *g_registeredPools = 0;
+
+} // unnamed namespace
+
+/**
+ * \ingroup packet
+ * Clear the pools of the current thread when it exits.
+ */
+struct DataPoolReleaser
+{
+  DataPoolReleaser ()
+  {
+  }
+  ~DataPoolReleaser ()
+  {
+    for (DataPool *pool = g_registeredPools; pool != 0; pool = pool->m_next)
+      {
+        pool->Clear ();
+        pool->m_released = true;
+      }
+  }
+};
+
+namespace {
+
+/** Instantiated when the first pool of a thread retains a block. */
+thread_local DataPoolReleaser g_dataPoolReleaser;
+
+} // unnamed namespace
+
+double
+DataPool::Stats::GetHitRate (void) const
+{
+  uint64_t allocations = hits + misses;
+  return allocations > 0 ? static_cast<double> (hits) / allocations : 0;
+}
+
+uint32_t
+DataPool::GetSizeClass (uint32_t size)
+{
+  if (size <= DATA_POOL_MIN_SIZE)
+    {
+      return 0;
+    }
+  // size - 1 is in [2^p, 2^(p+1)), and in [(4 + j) 2^(p-2), (5 + j) 2^(p-2))
+  uint32_t s = size - 1;
+  uint32_t p = 31 - __builtin_clz (s);
+  uint32_t j = (s >> (p - 2)) & 3;
+  return (p - 6) * 4 + j + 1;
+}
+
+uint32_t
+DataPool::GetClassSize (uint32_t sizeClass)
+{
+  if (sizeClass == 0)
+    {
+      return DATA_POOL_MIN_SIZE;
+    }
+  uint32_t p = 6 + (sizeClass - 1) / 4;
+  uint32_t j = (sizeClass - 1) % 4;
+  return (5 + j) << (p - 2);
+}
+
+void *
+DataPool::Allocate (uint32_t &size)
+{
+  uint32_t sizeClass = GetSizeClass (size);
+  if (sizeClass < N_CLASSES)
+    {
+      size = GetClassSize (sizeClass);
+      Block *block = m_heads[sizeClass];
+      if (block != 0)
+        {
+          m_heads[sizeClass] = block->next;
+          m_counts[sizeClass]--;
+          m_retainedBytes -= size;
+          m_hits++;
+          return block;
+        }
+    }
+  m_misses++;
+  return ::operator new (size);
+}
+
+void
+DataPool::Deallocate (void *block, uint32_t size)
+{
+  uint32_t sizeClass = GetSizeClass (size);
+  if (sizeClass < N_CLASSES && !m_released)
+    {
+      NS_ASSERT (GetClassSize (sizeClass) == size);
+      if (m_counts[sizeClass] < m_limits->maxBlocks
+          && m_retainedBytes + size <= m_limits->maxBytes)
+        {
+          if (!m_registered)
+            {
+              Register ();
+            }
+          Block *b = static_cast<Block *> (block);
+          b->next = m_heads[sizeClass];
+          m_heads[sizeClass] = b;
+          m_counts[sizeClass]++;
+          m_retainedBytes += size;
+          return;
+        }
+      m_drops++;
+    }
+  ::operator delete (block);
+}
+
+void
+DataPool::Register (void)
+{
+  m_registered = true;
+  m_next = g_registeredPools;
+  g_registeredPools = this;
+  // odr-use the releaser to construct it for this thread
+  (void) &g_dataPoolReleaser;
+}
+
+DataPool::Stats
+DataPool::GetStats (void) const
+{
+  Stats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.drops = m_drops;
+  stats.retainedBlocks = 0;
+  for (uint32_t i = 0; i < N_CLASSES; i++)
+    {
+      stats.retainedBlocks += m_counts[i];
+    }
+  stats.retainedBytes = m_retainedBytes;
+  return stats;
+}
+
+void
+DataPool::Clear (void)
+{
+  for (uint32_t i = 0; i < N_CLASSES; i++)
+    {
+      while (m_heads[i] != 0)
+        {
+          Block *block = m_heads[i];
+          m_heads[i] = block->next;
+          ::operator delete (block);
+        }
+      m_counts[i] = 0;
+    }
+  m_retainedBytes = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DATA_POOL_H
+#define DATA_POOL_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ * \brief A pool of memory blocks, in size classes, for the data of packets
+ *
+ * Buffer and PacketMetadata store the data of the packets in
+ * reference-counted blocks, which are allocated and released as packets
+ * are created, copied and destroyed.  Each of them uses its own DataPool,
+ * which keeps the released blocks in free lists, one per size class, to
+ * serve the next allocations.  The packet tags are not stored here, but
+ * in the slabs of PacketTagList.  The size classes are 64 bytes, and
+ * then four classes per power of two up to 128 KiB, so that a block is
+ * at most 25% larger than requested.  Larger blocks are not pooled.
+ *
+ * Each thread uses its own pool, declared thread_local, which is thus
+ * accessed without any lock: a block released by another thread than
+ * the one which allocated it joins the pool of the former.  The pool is
+ * constant-initialized and trivially destructible, so that accessing it
+ * does not involve any thread-local initialization guard.  The blocks it
+ * retains are freed when its thread exits.
+ *
+ * The number of blocks retained in each size class, and the number of
+ * bytes retained in all the classes, are capped by the limits shared by
+ * the pools of all the threads.
+ */
+class DataPool
+{
+public:
+  /// The limits of the pools
+  struct Limits
+  {
+    uint32_t maxBlocks; //!< the maximum number of blocks retained in each size class
+    uint64_t maxBytes;  //!< the maximum number of bytes retained in all the size classes
+  };
+
+  /// The statistics of a pool
+  struct Stats
+  {
+    uint64_t hits;           //!< the number of allocations served by the pool
+    uint64_t misses;         //!< the number of allocations served by the heap
+    uint64_t drops;          //!< the number of released blocks freed because of the limits
+    uint64_t retainedBlocks; //!< the number of blocks retained
+    uint64_t retainedBytes;  //!< the number of bytes retained
+    /**
+     * \returns the fraction of the allocations served by the pool
+     */
+    double GetHitRate (void) const;
+  };
+
+  /// The number of size classes
+  static const uint32_t N_CLASSES = 45;
+
+  /**
+   * \param limits the limits of the pool, which must outlive it
+   */
+  constexpr DataPool (const Limits *limits)
+    : m_limits (limits),
+      m_heads (),
+      m_counts (),
+      m_retainedBytes (0),
+      m_hits (0),
+      m_misses (0),
+      m_drops (0),
+      m_next (0),
+      m_registered (false),
+      m_released (false)
+  {
+  }
+
+  /**
+   * Allocate a block.
+   *
+   * \param size the requested size of the block (bytes), set to its
+   *        actual size, which must be passed to Deallocate
+   * \returns the block
+   */
+  void * Allocate (uint32_t &size);
+  /**
+   * Release a block, which is retained or freed.
+   *
+   * \param block the block
+   * \param size the size of the block returned by Allocate
+   */
+  void Deallocate (void *block, uint32_t size);
+  /**
+   * \returns the statistics of the pool
+   */
+  Stats GetStats (void) const;
+  /**
+   * Free the blocks retained by the pool.
+   */
+  void Clear (void);
+
+private:
+  /// A retained block
+  struct Block
+  {
+    Block *next; //!< the next block of the same size class
+  };
+
+  /**
+   * \param size the size of a block (bytes)
+   * \returns the smallest size class holding this size
+   */
+  static uint32_t GetSizeClass (uint32_t size);
+  /**
+   * \param sizeClass the size class
+   * \returns the size of the blocks of the size class (bytes)
+   */
+  static uint32_t GetClassSize (uint32_t sizeClass);
+  /// Register the pool, so that it is cleared when the thread exits
+  void Register (void);
+  /// Clears the pools of a thread when it exits
+  friend struct DataPoolReleaser;
+
+  const Limits *m_limits;          //!< the limits of the pool
+  Block *m_heads[N_CLASSES];       //!< the free lists
+  uint32_t m_counts[N_CLASSES];    //!< the lengths of the free lists
+  uint64_t m_retainedBytes;        //!< the number of bytes retained
+  uint64_t m_hits;                 //!< the number of allocations served by the pool
+  uint64_t m_misses;               //!< the number of allocations served by the heap
+  uint64_t m_drops;                //!< the number of released blocks freed because of the limits
+  DataPool *m_next;                //!< the next pool registered in the thread
+  bool m_registered;               //!< whether the pool is registered
+  bool m_released;                 //!< whether the thread exits: blocks are not retained anymore
+};
+
+} // namespace ns3
+
+#endif /* DATA_POOL_H */
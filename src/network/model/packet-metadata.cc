@@ -19,6 +19,8 @@
  */
 #include <utility>
 #include <list>
+#include <new>
+#include <algorithm>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
@@ -34,19 +36,22 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+const uint32_t PacketMetadata::MAX_RECOMMENDED_SIZE;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
 
-PacketMetadata::DataFreeList::~DataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
-    {
-      PacketMetadata::Deallocate (*i);
-    }
-  PacketMetadata::m_enable = false;
-}
+namespace {
+
+/** The limits of the pools of metadata storage. */
+DataPool::Limits g_metadataPoolLimits = { 4096, 16 << 20 };
+
+/** The pool of metadata storage of the current thread. */
+thread_local DataPool g_metadataPool (&g_metadataPoolLimits);
+
+/** The size of the largest pooled blocks, whose m_size fits in 16 bits. */
+const uint32_t MAX_POOLED_SIZE = 65536;
+
+} // unnamed namespace
 
 void 
 PacketMetadata::Enable (void)
@@ -70,6 +75,20 @@ PacketMetadata::EnableChecking (void)
   m_enableChecking = true;
 }
 
+void
+PacketMetadata::SetPoolLimits (uint32_t maxBlocks, uint64_t maxBytes)
+{
+  NS_LOG_FUNCTION (maxBlocks << maxBytes);
+  g_metadataPoolLimits.maxBlocks = maxBlocks;
+  g_metadataPoolLimits.maxBytes = maxBytes;
+}
+
+DataPool::Stats
+PacketMetadata::GetPoolStats (void)
+{
+  return g_metadataPool.GetStats ();
+}
+
 void
 PacketMetadata::ReserveCopy (uint32_t size)
 {
@@ -96,6 +115,16 @@ PacketMetadata::ReserveCopy (uint32_t size)
     }
 }
 void
+PacketMetadata::Unshare (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_data != 0);
+  if (m_data->m_count != 1)
+    {
+      ReserveCopy (0);
+    }
+}
+void
 PacketMetadata::Reserve (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
@@ -571,47 +600,19 @@ PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
   NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
-  if (size > m_maxSize)
+  if (size > m_maxSize && size <= MAX_RECOMMENDED_SIZE)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
-    {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
-      if (data->m_size >= size) 
-        {
-          NS_LOG_LOGIC ("create found size="<<data->m_size);
-          data->m_count = 1;
-          return data;
-        }
-      NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
-      PacketMetadata::Deallocate (data);
-    }
-  NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
-  return PacketMetadata::Allocate (m_maxSize);
+  return PacketMetadata::Allocate (std::max (size, m_maxSize));
 }
 
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
-    {
-      PacketMetadata::Deallocate (data);
-      return;
-    } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
-    {
-      PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
-    }
+  PacketMetadata::Deallocate (data);
 }
 
 struct PacketMetadata::Data *
@@ -624,8 +625,19 @@ PacketMetadata::Allocate (uint32_t n)
       n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
   size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-  uint8_t *buf = new uint8_t [size];
-  struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)buf;
+  struct PacketMetadata::Data *data;
+  if (size <= MAX_POOLED_SIZE)
+    {
+      // the block may be larger than requested
+      data = static_cast<struct PacketMetadata::Data *> (g_metadataPool.Allocate (size));
+      n = size - sizeof (struct Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
+    }
+  else
+    {
+      // the size of a larger block would not fit in m_size
+      data = static_cast<struct PacketMetadata::Data *> (::operator new (size));
+    }
+  NS_ASSERT (n <= 0xffff);
   data->m_size = n;
   data->m_count = 1;
   data->m_dirtyEnd = 0;
@@ -635,8 +647,15 @@ void
 PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  uint8_t *buf = (uint8_t *)data;
-  delete [] buf;
+  uint32_t size = data->m_size + sizeof (struct Data) - PACKET_METADATA_DATA_M_DATA_SIZE;
+  if (size <= MAX_POOLED_SIZE)
+    {
+      g_metadataPool.Deallocate (data, size);
+    }
+  else
+    {
+      ::operator delete (data);
+    }
 }
 
 
@@ -27,6 +27,7 @@
 #include "ns3/assert.h"
 #include "ns3/type-id.h"
 #include "buffer.h"
+#include "data-pool.h"
 
 namespace ns3 {
 
@@ -160,6 +161,22 @@ private:
    * \brief Enable the packet metadata checking
    */
   static void EnableChecking (void);
+  /**
+   * \brief Set the limits of the pools of metadata storage of all the threads
+   *
+   * The default limits are 4096 blocks per size class and 16 MiB per
+   * thread.
+   *
+   * \param maxBlocks the maximum number of blocks retained in each size class
+   * \param maxBytes the maximum number of bytes retained by each thread
+   */
+  static void SetPoolLimits (uint32_t maxBlocks, uint64_t maxBytes);
+  /**
+   * \brief Get the statistics of the pool of metadata storage of the calling thread
+   *
+   * \returns the statistics of the pool
+   */
+  static DataPool::Stats GetPoolStats (void);
 
   /**
    * \brief Constructor
@@ -218,6 +235,14 @@ private:
    */
   PacketMetadata CreateFragment (uint32_t start, uint32_t end) const;
 
+  /**
+   * \brief Make this metadata the only one referencing its storage.
+   *
+   * The storage shared with other PacketMetadata instances is copied,
+   * so that this metadata can be handed over to another thread.
+   */
+  void Unshare (void);
+
   /**
    * \brief Add a metadata at the metadata start
    * \param o the metadata to add
@@ -494,16 +519,6 @@ private:
     uint64_t packetUid;
   };
 
-  /**
-   * \brief Class to hold all the metadata
-   */
-  class DataFreeList : public std::vector<struct Data *>
-  {
-public:
-    ~DataFreeList ();
-  };
-
-  friend DataFreeList::~DataFreeList ();
   /// Friend class
   friend class ItemIterator;
 
@@ -661,7 +676,6 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -672,8 +686,13 @@ public:
    */
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize; //!< maximum metadata size
-  static uint16_t m_chunkUid; //!< Chunk Uid
+  /**
+   * The largest size of the new metadata storage learned from the
+   * packets: larger metadata do not make all the storages larger.
+   */
+  static const uint32_t MAX_RECOMMENDED_SIZE = 1024;
+  static thread_local uint32_t m_maxSize; //!< maximum metadata size of the thread, up to MAX_RECOMMENDED_SIZE
+  static thread_local uint16_t m_chunkUid; //!< Chunk Uid of the thread
 
   struct Data *m_data; //!< Metadata storage
   /*
@@ -28,12 +28,103 @@
 #include "tag.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include <cstddef>
 #include <cstring>
+#include <mutex>
+#include <new>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+namespace {
+
+/// A free slot of a slab
+struct TagSlot
+{
+  TagSlot *next; //!< the next free slot
+};
+
+/// The size of a slot (bytes)
+const std::size_t TAG_SLOT_SIZE = 64;
+/// The largest tag stored in a slot (bytes)
+const std::size_t TAG_SLOT_DATA_SIZE = TAG_SLOT_SIZE - offsetof (PacketTagList::TagData, data);
+/// The number of slots of a slab
+const std::size_t TAG_SLAB_SLOTS = 64;
+
+/// The free slots of the thread
+thread_local TagSlot *g_freeSlots = 0;
+
+/// The free slots left by the threads which exited
+TagSlot *g_spareSlots = 0;
+/// Protects g_spareSlots
+std::mutex g_spareSlotsMutex;
+
+} // unnamed namespace
+
+/**
+ * \ingroup packet
+ * Hand the free slots of the current thread over to the other threads
+ * when it exits.
+ */
+struct TagSlotReleaser
+{
+  TagSlotReleaser ()
+  {
+  }
+  ~TagSlotReleaser ()
+  {
+    if (g_freeSlots == 0)
+      {
+        return;
+      }
+    TagSlot *last = g_freeSlots;
+    while (last->next != 0)
+      {
+        last = last->next;
+      }
+    std::lock_guard<std::mutex> lock (g_spareSlotsMutex);
+    last->next = g_spareSlots;
+    g_spareSlots = g_freeSlots;
+    g_freeSlots = 0;
+  }
+};
+
+namespace {
+
+/** Instantiated when the first slot of a thread becomes free. */
+thread_local TagSlotReleaser g_tagSlotReleaser;
+
+/**
+ * Fill the free slots of the thread, with the spare slots if any, or
+ * with a new slab.
+ */
+void
+RefillTagSlots (void)
+{
+  (void) &g_tagSlotReleaser;
+  {
+    std::lock_guard<std::mutex> lock (g_spareSlotsMutex);
+    if (g_spareSlots != 0)
+      {
+        g_freeSlots = g_spareSlots;
+        g_spareSlots = 0;
+        return;
+      }
+  }
+  // The slabs are never freed, since their slots can be released by
+  // any thread, at any time.
+  char *slab = static_cast<char *> (::operator new (TAG_SLAB_SLOTS * TAG_SLOT_SIZE));
+  for (std::size_t i = TAG_SLAB_SLOTS; i > 0; i--)
+    {
+      TagSlot *slot = reinterpret_cast<TagSlot *> (slab + (i - 1) * TAG_SLOT_SIZE);
+      slot->next = g_freeSlots;
+      g_freeSlots = slot;
+    }
+}
+
+} // unnamed namespace
+
 PacketTagList::TagData *
 PacketTagList::CreateTagData (size_t dataSize)
 {
@@ -43,14 +134,50 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
+  void * p;
+  if (dataSize <= TAG_SLOT_DATA_SIZE)
+    {
+      if (g_freeSlots == 0)
+        {
+          RefillTagSlots ();
+        }
+      TagSlot *slot = g_freeSlots;
+      g_freeSlots = slot->next;
+      p = slot;
+    }
+  else
+    {
+      p = std::malloc (sizeof (TagData) + dataSize - 1);
+    }
+  // The matching frees are in FreeTagData
 
   TagData * tag = new (p) TagData;
   tag->size = dataSize;
   return tag;
 }
 
+void
+PacketTagList::FreeTagData (TagData *tag)
+{
+  bool slot = tag->size <= TAG_SLOT_DATA_SIZE;
+  tag->~TagData ();
+  if (slot)
+    {
+      if (g_freeSlots == 0)
+        {
+          // odr-use the releaser to construct it for this thread
+          (void) &g_tagSlotReleaser;
+        }
+      TagSlot *s = reinterpret_cast<TagSlot *> (tag);
+      s->next = g_freeSlots;
+      g_freeSlots = s;
+    }
+  else
+    {
+      std::free (tag);
+    }
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -194,8 +321,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      FreeTagData (cur);
     }
   else
     {
@@ -294,6 +420,36 @@ PacketTagList::Peek (Tag &tag) const
   return false;
 }
 
+void
+PacketTagList::Unshare (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Skip the head of the branch, which only this list references
+  struct TagData **prevNext = &m_next;
+  while (*prevNext != 0 && (*prevNext)->count == 1)
+    {
+      prevNext = &(*prevNext)->next;
+    }
+  struct TagData *merge = *prevNext;
+  if (merge == 0)
+    {
+      return;
+    }
+  // Copy the rest of the list, from the first merge
+  for (struct TagData *cur = merge; cur != 0; cur = cur->next)
+    {
+      struct TagData *copy = CreateTagData (cur->size);
+      copy->count = 1;
+      copy->next = 0;
+      copy->tid = cur->tid;
+      std::memcpy (copy->data, cur->data, cur->size);
+      *prevNext = copy;
+      prevNext = &copy->next;
+    }
+  // The merge point is still referenced by the other branches
+  merge->count--;
+}
+
 const struct PacketTagList::TagData *
 PacketTagList::Head (void) const
 {
@@ -119,6 +119,21 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * \par <b> Storage </b> of the TagData:
+ *
+ *   - The TagData holding up to 44 bytes of tag data, which covers the
+ *     usual tags, such as those of the Wi-Fi stack, are stored in
+ *     64-byte slots carved out of slabs, without calling the heap
+ *     allocator.  Larger TagData are allocated from the heap.
+ *
+ *   - Each thread keeps its own list of free slots, accessed without any
+ *     lock: a slot released by another thread than the one which
+ *     allocated it joins the list of the former.  The free slots of a
+ *     thread which exits are handed over to the other threads.
+ *
+ *   - The slabs are never freed, so the memory they use is that of the
+ *     largest number of tags alive at the same time.
  */
 class PacketTagList 
 {
@@ -201,6 +216,13 @@ public:
    *        the list is guaranteed to have the new tag value either way).
    */
   bool Replace (Tag &tag);
+  /**
+   * Make this list the only one referencing its TagData.
+   *
+   * The TagData shared with other branches are copied, so that this
+   * list can be handed over to another thread.
+   */
+  void Unshare (void);
   /**
    * Find a tag and return its value.
    *
@@ -228,6 +250,13 @@ private:
    */
   static
   TagData * CreateTagData (size_t dataSize);
+  /**
+   * Destroy and free a TagData struct allocated by CreateTagData.
+   *
+   * \param [in] tag The TagData object.
+   */
+  static
+  void FreeTagData (TagData *tag);
   
   /**
    * Typedef of method function pointer for copy-on-write operations
@@ -341,15 +370,13 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
-          prev->~TagData ();
-          std::free (prev);
+          FreeTagData (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      prev->~TagData ();
-      std::free (prev);
+      FreeTagData (prev);
     }
   m_next = 0;
 }
@@ -453,6 +453,19 @@ public:
    */
   Ptr<Packet> Copy (void) const;
 
+  /**
+   * \brief performs a deep copy of the packet.
+   *
+   * \returns a copy of the packet which shares no data with
+   * the original packet.
+   *
+   * Unlike the COW copies returned by Copy, the returned packet
+   * can be handed over to another thread, e.g., to a node of another
+   * partition of a ns3::MultithreadedSimulatorImpl (see
+   * Simulator::IsConcurrent).
+   */
+  Ptr<Packet> DeepCopy (void) const;
+
   /**
    * \brief Returns the packet's Uid.
    *
@@ -786,8 +799,6 @@ private:
 
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
-
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/binary-trace-file.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/trace-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that the events written by the default sinks of AsciiTraceHelper
+ * to a binary stream are read back by BinaryTraceFile.
+ */
+class BinaryTraceFileTestCase : public TestCase
+{
+public:
+  BinaryTraceFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Write the events of a packet to the stream.
+   * \param stream the stream
+   * \param p the packet
+   */
+  void WriteEvents (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p);
+};
+
+BinaryTraceFileTestCase::BinaryTraceFileTestCase ()
+  : TestCase ("Check the binary trace records")
+{
+}
+
+void
+BinaryTraceFileTestCase::WriteEvents (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
+{
+  AsciiTraceHelper::DefaultEnqueueSinkWithContext (stream, "/NodeList/3/DeviceList/1/TxQueue/Enqueue", p);
+  AsciiTraceHelper::DefaultDequeueSinkWithContext (stream, "/NodeList/3/DeviceList/1/TxQueue/Dequeue", p);
+  AsciiTraceHelper::DefaultDropSinkWithoutContext (stream, p);
+  AsciiTraceHelper::DefaultReceiveSinkWithContext (stream, "/NodeList/12/DeviceList/0/MacRx", p);
+}
+
+void
+BinaryTraceFileTestCase::DoRun (void)
+{
+  std::stringstream ss;
+  Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper> (&ss);
+  stream->SetBinary (4);
+
+  uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  Ptr<Packet> p1 = Create<Packet> (data, sizeof (data));
+  Ptr<Packet> p2 = Create<Packet> (data, 2);
+  Simulator::Schedule (MicroSeconds (1500), &BinaryTraceFileTestCase::WriteEvents, this, stream, p1);
+  Simulator::Schedule (Seconds (2), &BinaryTraceFileTestCase::WriteEvents, this, stream, p2);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // The header, the three contexts, written once, and eight events
+  uint32_t contexts = std::string ("/NodeList/3/DeviceList/1/TxQueue/Enqueue").size ()
+    + std::string ("/NodeList/3/DeviceList/1/TxQueue/Dequeue").size ()
+    + std::string ("/NodeList/12/DeviceList/0/MacRx").size ();
+  NS_TEST_ASSERT_MSG_EQ (ss.str ().size (), 16 + 3 * 40 + contexts + 8 * 40 + 4 * 4 + 4 * 2, "Unexpected size");
+
+  BinaryTraceFile file;
+  NS_TEST_ASSERT_MSG_EQ (file.ReadHeader (&ss), true, "Invalid header");
+  NS_TEST_ASSERT_MSG_EQ (file.GetNPacketBytes (), 4, "Unexpected number of packet bytes");
+
+  const char types[] = {'+', '-', 'd', 'r'};
+  BinaryTraceFile::Record record;
+  std::vector<uint8_t> bytes;
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      Ptr<Packet> p = i < 4 ? p1 : p2;
+      NS_TEST_ASSERT_MSG_EQ (file.Read (&ss, record, bytes), true, "Missing record " << i);
+      NS_TEST_EXPECT_MSG_EQ (static_cast<char> (record.type), types[i % 4], "Unexpected type of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (record.time, (i < 4 ? MicroSeconds (1500) : Seconds (2)).GetNanoSeconds (), "Unexpected time of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (record.uid, p->GetUid (), "Unexpected UID of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (record.size, p->GetSize (), "Unexpected size of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (record.info, BinaryTraceFile::NONE, "Unexpected info of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (bytes.size (), std::min<uint32_t> (p->GetSize (), 4), "Unexpected bytes of record " << i);
+      for (uint32_t j = 0; j < bytes.size (); j++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (bytes[j]), static_cast<uint32_t> (data[j]), "Unexpected byte " << j << " of record " << i);
+        }
+      uint32_t node = BinaryTraceFile::NONE;
+      uint32_t device = BinaryTraceFile::NONE;
+      std::string context;
+      switch (i % 4)
+        {
+        case 0:
+          node = 3;
+          device = 1;
+          context = "/NodeList/3/DeviceList/1/TxQueue/Enqueue";
+          break;
+        case 1:
+          node = 3;
+          device = 1;
+          context = "/NodeList/3/DeviceList/1/TxQueue/Dequeue";
+          break;
+        case 3:
+          node = 12;
+          device = 0;
+          context = "/NodeList/12/DeviceList/0/MacRx";
+          break;
+        }
+      NS_TEST_EXPECT_MSG_EQ (record.node, node, "Unexpected node of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (record.device, device, "Unexpected device of record " << i);
+      NS_TEST_EXPECT_MSG_EQ (file.GetString (record.context), context, "Unexpected context of record " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (file.Read (&ss, record, bytes), false, "Unexpected record after the events");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Binary trace file test suite
+ */
+class BinaryTraceFileTestSuite : public TestSuite
+{
+public:
+  BinaryTraceFileTestSuite ();
+};
+
+BinaryTraceFileTestSuite::BinaryTraceFileTestSuite ()
+  : TestSuite ("binary-trace-file", UNIT)
+{
+  AddTestCase (new BinaryTraceFileTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceFileTestSuite g_binaryTraceFileTestSuite; //!< Static variable for test initialization
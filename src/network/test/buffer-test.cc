@@ -389,6 +389,65 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that the data of the buffers are recycled by the DataPool of
+ * the thread, within its limits.
+ */
+class BufferPoolTest : public TestCase {
+public:
+  virtual void DoRun (void);
+  BufferPoolTest ();
+};
+
+BufferPoolTest::BufferPoolTest ()
+  : TestCase ("Buffer data pool") {
+}
+
+void
+BufferPoolTest::DoRun (void)
+{
+  {
+    Buffer b;
+    b.AddAtStart (5000);
+  }
+  DataPool::Stats s1 = Buffer::GetPoolStats ();
+  NS_TEST_ASSERT_MSG_GT (s1.retainedBlocks, 0, "The data of the buffer are not retained");
+  {
+    // Too large to change the size of the new buffers
+    Buffer b;
+    b.AddAtStart (5000);
+  }
+  DataPool::Stats s2 = Buffer::GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (s2.hits, s1.hits + 2, "The data should be recycled");
+  NS_TEST_EXPECT_MSG_EQ (s2.misses, s1.misses, "The data should be recycled");
+  NS_TEST_EXPECT_MSG_EQ (s2.retainedBytes, s1.retainedBytes, "The data should be retained again");
+  NS_TEST_EXPECT_MSG_EQ (s2.GetHitRate (), static_cast<double> (s2.hits) / (s2.hits + s2.misses), "Unexpected hit rate");
+
+  Buffer::SetPoolLimits (4096, s2.retainedBytes);
+  {
+    Buffer b;
+    b.AddAtStart (40000);
+  }
+  DataPool::Stats s3 = Buffer::GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (s3.misses, s2.misses + 1, "The new size class should be allocated");
+  NS_TEST_EXPECT_MSG_EQ (s3.drops, s2.drops + 1, "The data should be freed beyond the limit");
+  NS_TEST_EXPECT_MSG_EQ (s3.retainedBytes, s2.retainedBytes, "The data should not be retained");
+
+  Buffer::SetPoolLimits (4096, 64 << 20);
+  {
+    // Larger than the largest size class
+    Buffer b;
+    b.AddAtStart (200000);
+  }
+  DataPool::Stats s4 = Buffer::GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (s4.misses, s3.misses + 1, "The data should be allocated");
+  NS_TEST_EXPECT_MSG_EQ (s4.drops, s3.drops, "The data should not be pooled");
+  NS_TEST_EXPECT_MSG_EQ (s4.retainedBytes, s3.retainedBytes, "The data should not be pooled");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -405,6 +464,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferPoolTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -21,6 +21,7 @@
 #include "ns3/packet-tag-list.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
+#include "ns3/system-thread.h"
 #include <limits>     // std:numeric_limits
 #include <string>
 #include <cstdarg>
@@ -790,6 +791,12 @@ private:
    * \return the ticks to remove the tags.
    */
   int AddRemoveTime (const bool verbose = false);
+
+  /**
+   * Add a tag of a slot and a tag of the heap to each list.
+   * \param lists The lists.
+   */
+  static void AddSlotAndHeapTags (std::vector<PacketTagList> *lists);
 };
 
 PacketTagListTest::PacketTagListTest ()
@@ -892,6 +899,18 @@ PacketTagListTest::AddRemoveTime (const bool verbose /* = false */)
   return delta;
 }
 
+void
+PacketTagListTest::AddSlotAndHeapTags (std::vector<PacketTagList> *lists)
+{
+  ATestTag<40> slot (3);  // the largest tag stored in a slot
+  ATestTag<41> heap (4);  // the smallest tag allocated from the heap
+  for (std::vector<PacketTagList>::iterator i = lists->begin (); i != lists->end (); ++i)
+    {
+      i->Add (slot);
+      i->Add (heap);
+    }
+}
+
 void
 PacketTagListTest::DoRun (void)
 {
@@ -994,6 +1013,33 @@ PacketTagListTest::DoRun (void)
     ReplaceCheck (7);
   }
   
+  { // Storage
+    std::cout << GetName () << "check the tags of the slots and of the heap"
+              << std::endl;
+    // More tags than a slab holds, added by another thread
+    std::vector<PacketTagList> lists (200, ref);
+    Ptr<SystemThread> thread = Create<SystemThread> (
+        MakeBoundCallback (&PacketTagListTest::AddSlotAndHeapTags, &lists));
+    thread->Start ();
+    thread->Join ();
+    for (std::size_t i = 0; i < lists.size (); ++i)
+      {
+        ATestTag<40> slot;
+        ATestTag<41> heap;
+        PacketTagList copy = lists[i];
+        NS_TEST_EXPECT_MSG_EQ (copy.Remove (slot), true, "tag of a slot " << i);
+        NS_TEST_EXPECT_MSG_EQ (slot.GetData (), 3, "tag of a slot " << i);
+        NS_TEST_EXPECT_MSG_EQ (copy.Peek (heap), true, "tag of the heap " << i);
+        NS_TEST_EXPECT_MSG_EQ (heap.GetData (), 4, "tag of the heap " << i);
+        CheckRefList (copy, "storage copy");
+        // The slots released by this thread are reused
+        copy.Add (slot);
+        lists[i].RemoveAll ();
+        CheckRef (copy, slot, "storage slot");
+        CheckRefList (copy, "storage copy");
+      }
+  }
+
   { // Timing
     std::cout << GetName () << "add+remove timing" << std::endl;
     int flm = std::numeric_limits<int>::max ();
@@ -25,6 +25,11 @@
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcap-file-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/enum.h"
 
 using namespace ns3;
 
@@ -1144,6 +1149,133 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the asynchronous mode of
+ * PcapFileWrapper writes the same records as the synchronous mode, and
+ * only drops records with the DROP policy.
+ */
+class AsynchronousWriteTestCase : public TestCase
+{
+public:
+  AsynchronousWriteTestCase ();
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  /**
+   * Write the records of the test to a file.
+   * \param filename the name of the file
+   * \param asynchronous whether the records are written asynchronously
+   * \param bufferSize the size of each buffer of records
+   * \param nBuffers the number of buffers
+   * \param policy the overflow policy
+   * \return the number of dropped records
+   */
+  uint64_t WriteRecords (std::string filename, bool asynchronous, uint32_t bufferSize,
+                         uint32_t nBuffers, PcapFileWrapper::OverflowPolicy policy);
+
+  std::string m_syncFilename; //!< File written synchronously
+  std::string m_asyncFilename; //!< File written asynchronously
+  uint32_t m_nRecords; //!< Number of records
+};
+
+AsynchronousWriteTestCase::AsynchronousWriteTestCase ()
+  : TestCase ("Check the asynchronous mode of PcapFileWrapper"),
+    m_nRecords (500)
+{
+}
+
+void
+AsynchronousWriteTestCase::DoSetup (void)
+{
+  std::stringstream filename;
+  filename << rand ();
+  m_syncFilename = CreateTempDirFilename (filename.str () + "-sync.pcap");
+  m_asyncFilename = CreateTempDirFilename (filename.str () + "-async.pcap");
+}
+
+void
+AsynchronousWriteTestCase::DoTeardown (void)
+{
+  if (remove (m_syncFilename.c_str ()) || remove (m_asyncFilename.c_str ()))
+    {
+      NS_LOG_ERROR ("Failed to delete file " << m_syncFilename << " or " << m_asyncFilename);
+    }
+}
+
+uint64_t
+AsynchronousWriteTestCase::WriteRecords (std::string filename, bool asynchronous, uint32_t bufferSize,
+                                         uint32_t nBuffers, PcapFileWrapper::OverflowPolicy policy)
+{
+  Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
+  file->SetAttribute ("Asynchronous", BooleanValue (asynchronous));
+  file->SetAttribute ("BufferSize", UintegerValue (bufferSize));
+  file->SetAttribute ("NBuffers", UintegerValue (nBuffers));
+  file->SetAttribute ("OverflowPolicy", EnumValue (policy));
+  file->Open (filename, std::ios::out);
+  file->Init (1, 100);
+  uint8_t data[300];
+  for (uint32_t i = 0; i < m_nRecords; i++)
+    {
+      // Some records are truncated, and some are larger than the buffers
+      uint32_t size = (i * 37) % 300;
+      for (uint32_t j = 0; j < size; j++)
+        {
+          data[j] = static_cast<uint8_t> (i + j);
+        }
+      if (i % 2 == 0)
+        {
+          file->Write (MicroSeconds (1000 * i + 1), data, size);
+        }
+      else
+        {
+          file->Write (MicroSeconds (1000 * i + 1), Create<Packet> (data, size));
+        }
+    }
+  uint64_t nDropped = file->GetNDroppedRecords ();
+  file->Close ();
+  return nDropped;
+}
+
+void
+AsynchronousWriteTestCase::DoRun (void)
+{
+  WriteRecords (m_syncFilename, false, 1 << 20, 16, PcapFileWrapper::BLOCK);
+  uint64_t nDropped = WriteRecords (m_asyncFilename, true, 256, 2, PcapFileWrapper::BLOCK);
+  NS_TEST_EXPECT_MSG_EQ (nDropped, 0, "No record must be dropped with the BLOCK policy");
+  uint32_t sec = 0;
+  uint32_t usec = 0;
+  uint32_t packets = 0;
+  bool diff = PcapFile::Diff (m_syncFilename, m_asyncFilename, sec, usec, packets);
+  NS_TEST_EXPECT_MSG_EQ (diff, false, "The files must be the same, differ at " << sec << "." << usec);
+  NS_TEST_EXPECT_MSG_EQ (packets, m_nRecords, "Wrong number of records");
+  NS_TEST_EXPECT_MSG_EQ (CheckFileLength (m_asyncFilename, 0), false, "The file must not be empty");
+
+  // With the DROP policy, the records are either written or dropped
+  nDropped = WriteRecords (m_asyncFilename, true, 256, 1, PcapFileWrapper::DROP);
+  PcapFile f;
+  f.Open (m_asyncFilename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << m_asyncFilename << ", \"std::ios::in\") returns error");
+  uint8_t data[300];
+  uint32_t tsSec, tsUsec, inclLen, origLen, readLen;
+  uint32_t nRead = 0;
+  while (true)
+    {
+      f.Read (data, sizeof (data), tsSec, tsUsec, inclLen, origLen, readLen);
+      if (f.Fail ())
+        {
+          break;
+        }
+      nRead++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (nRead + nDropped, m_nRecords, "The records must be written or dropped");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1167,6 +1299,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new AsynchronousWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/packet.h"
+#include "binary-trace-file.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceFile");
+
+const uint32_t BinaryTraceFile::MAGIC;
+const uint16_t BinaryTraceFile::VERSION_MAJOR;
+const uint16_t BinaryTraceFile::VERSION_MINOR;
+const uint32_t BinaryTraceFile::NONE;
+
+/// The header of a binary trace file
+struct BinaryTraceFileHeader
+{
+  uint32_t magic;         //!< the magic number
+  uint16_t versionMajor;  //!< the major version
+  uint16_t versionMinor;  //!< the minor version
+  uint32_t nPacketBytes;  //!< the maximum number of bytes of each packet stored
+  uint32_t reserved;      //!< reserved, zero
+};
+
+BinaryTraceFile::BinaryTraceFile ()
+  : m_nPacketBytes (0)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (sizeof (BinaryTraceFileHeader) == 16);
+  NS_ASSERT (sizeof (Record) == 40);
+}
+
+void
+BinaryTraceFile::WriteHeader (std::ostream *os, uint16_t nPacketBytes)
+{
+  NS_LOG_FUNCTION (this << os << nPacketBytes);
+  m_nPacketBytes = nPacketBytes;
+  m_buffer.resize (nPacketBytes);
+  BinaryTraceFileHeader header;
+  header.magic = MAGIC;
+  header.versionMajor = VERSION_MAJOR;
+  header.versionMinor = VERSION_MINOR;
+  header.nPacketBytes = nPacketBytes;
+  header.reserved = 0;
+  os->write (reinterpret_cast<const char *> (&header), sizeof (header));
+}
+
+uint32_t
+BinaryTraceFile::WriteString (std::ostream *os, const std::string &s)
+{
+  std::map<std::string, uint32_t>::const_iterator it = m_indexes.find (s);
+  if (it != m_indexes.end ())
+    {
+      return it->second;
+    }
+  NS_LOG_FUNCTION (this << os << s);
+  NS_ASSERT (s.size () <= 0xffff);
+  uint32_t index = m_indexes.size ();
+  m_indexes[s] = index;
+  Record record;
+  std::memset (&record, 0, sizeof (record));
+  record.type = STRING;
+  record.nBytes = s.size ();
+  record.context = NONE;
+  record.uid = index;
+  record.node = NONE;
+  record.device = NONE;
+  record.info = NONE;
+  os->write (reinterpret_cast<const char *> (&record), sizeof (record));
+  os->write (s.data (), s.size ());
+  return index;
+}
+
+const BinaryTraceFile::Context &
+BinaryTraceFile::WriteContext (std::ostream *os, const std::string &context)
+{
+  std::map<std::string, Context>::const_iterator it = m_contexts.find (context);
+  if (it != m_contexts.end ())
+    {
+      return it->second;
+    }
+  Context c;
+  c.index = WriteString (os, context);
+  c.node = NONE;
+  c.device = NONE;
+  const char *nodeList = "/NodeList/";
+  const char *deviceList = "/DeviceList/";
+  if (context.compare (0, std::strlen (nodeList), nodeList) == 0)
+    {
+      char *end;
+      const char *s = context.c_str () + std::strlen (nodeList);
+      unsigned long node = std::strtoul (s, &end, 10);
+      if (end != s)
+        {
+          c.node = node;
+          if (std::strncmp (end, deviceList, std::strlen (deviceList)) == 0)
+            {
+              s = end + std::strlen (deviceList);
+              unsigned long device = std::strtoul (s, &end, 10);
+              if (end != s)
+                {
+                  c.device = device;
+                }
+            }
+        }
+    }
+  return m_contexts.insert (std::make_pair (context, c)).first->second;
+}
+
+void
+BinaryTraceFile::Write (std::ostream *os, RecordType type, Time time, const std::string &context,
+                        Ptr<const Packet> p, const std::string &info)
+{
+  NS_LOG_FUNCTION (this << os << static_cast<char> (type) << time << context << p << info);
+  Record record;
+  record.type = type;
+  record.reserved = 0;
+  if (context.empty ())
+    {
+      record.context = NONE;
+      record.node = NONE;
+      record.device = NONE;
+    }
+  else
+    {
+      const Context &c = WriteContext (os, context);
+      record.context = c.index;
+      record.node = c.node;
+      record.device = c.device;
+    }
+  record.info = info.empty () ? NONE : WriteString (os, info);
+  record.time = time.GetNanoSeconds ();
+  record.uid = p->GetUid ();
+  record.size = p->GetSize ();
+  record.nBytes = std::min<uint32_t> (record.size, m_nPacketBytes);
+  os->write (reinterpret_cast<const char *> (&record), sizeof (record));
+  if (record.nBytes > 0)
+    {
+      p->CopyData (&m_buffer[0], record.nBytes);
+      os->write (reinterpret_cast<const char *> (&m_buffer[0]), record.nBytes);
+    }
+}
+
+bool
+BinaryTraceFile::ReadHeader (std::istream *is)
+{
+  NS_LOG_FUNCTION (this << is);
+  BinaryTraceFileHeader header;
+  is->read (reinterpret_cast<char *> (&header), sizeof (header));
+  if (is->gcount () != sizeof (header) || header.magic != MAGIC || header.versionMajor != VERSION_MAJOR)
+    {
+      return false;
+    }
+  m_nPacketBytes = header.nPacketBytes;
+  m_strings.clear ();
+  return true;
+}
+
+bool
+BinaryTraceFile::Read (std::istream *is, Record &record, std::vector<uint8_t> &bytes)
+{
+  NS_LOG_FUNCTION (this << is);
+  while (true)
+    {
+      is->read (reinterpret_cast<char *> (&record), sizeof (record));
+      if (is->gcount () != sizeof (record))
+        {
+          return false;
+        }
+      bytes.resize (record.nBytes);
+      if (record.nBytes > 0)
+        {
+          is->read (reinterpret_cast<char *> (&bytes[0]), record.nBytes);
+          if (is->gcount () != record.nBytes)
+            {
+              return false;
+            }
+        }
+      if (record.type != STRING)
+        {
+          return true;
+        }
+      if (record.uid != m_strings.size ())
+        {
+          NS_LOG_WARN ("String " << record.uid << " found instead of " << m_strings.size ());
+          return false;
+        }
+      m_strings.push_back (std::string (bytes.begin (), bytes.end ()));
+    }
+}
+
+std::string
+BinaryTraceFile::GetString (uint32_t index) const
+{
+  if (index == NONE || index >= m_strings.size ())
+    {
+      return "";
+    }
+  return m_strings[index];
+}
+
+uint16_t
+BinaryTraceFile::GetNPacketBytes (void) const
+{
+  return m_nPacketBytes;
+}
+
+} // namespace ns3
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \brief A compact binary alternative to the ASCII trace files
+ *
+ * The default sinks of AsciiTraceHelper print each event on a line, with
+ * the packet formatted by Packet::Print.  When the stream they are given
+ * is in binary mode (see AsciiTraceHelper::CreateBinaryFileStream), they
+ * write the events with this class instead, as fixed-size records which
+ * can be converted back to text offline by the decode-binary-trace
+ * program of utils/.
+ *
+ * A file starts with a header of 16 bytes:
+ *  - the magic number, 0x6e733374 ("ns3t" when read as big endian);
+ *  - the major and minor versions of the format (16 bits each);
+ *  - the maximum number of bytes of each packet stored after its record;
+ *  - 4 reserved bytes.
+ *
+ * It is followed by records of 40 bytes (see BinaryTraceFile::Record),
+ * each followed by nBytes bytes.  The trace contexts and the other strings
+ * of the events (such as the mode of the wifi transmissions) are written
+ * once, in a STRING record followed by the characters, and the events
+ * refer to them by their index.  The records are written in the byte
+ * order of the host which wrote them.
+ *
+ * Packet::Print needs the metadata of the packet, which is not stored:
+ * a decoded event shows the UID and the size of the packet instead, and
+ * its first bytes, if they were stored.
+ */
+class BinaryTraceFile
+{
+public:
+  static const uint32_t MAGIC = 0x6e733374; //!< Magic number identifying a binary trace file
+  static const uint16_t VERSION_MAJOR = 1;  //!< Major version of the format
+  static const uint16_t VERSION_MINOR = 0;  //!< Minor version of the format
+  static const uint32_t NONE = 0xffffffff;  //!< Value of the absent string, node and device indexes
+
+  /// The types of the records, which are the first characters of the ASCII trace lines
+  enum RecordType
+  {
+    STRING = 's',
+    ENQUEUE = '+',
+    DEQUEUE = '-',
+    DROP = 'd',
+    RECEIVE = 'r',
+    TRANSMIT = 't'
+  };
+
+  /// A record of the file
+  struct Record
+  {
+    uint8_t type;     //!< the RecordType
+    uint8_t reserved; //!< reserved, zero
+    uint16_t nBytes;  //!< the number of bytes following the record
+    uint32_t context; //!< the index of the trace context, or NONE
+    int64_t time;     //!< the time of the event (ns)
+    uint64_t uid;     //!< the UID of the packet, or the index of a STRING record
+    uint32_t size;    //!< the size of the packet (bytes)
+    uint32_t node;    //!< the node of the trace context, or NONE
+    uint32_t device;  //!< the device of the trace context, or NONE
+    uint32_t info;    //!< the index of the string describing the event, or NONE
+  };
+
+  BinaryTraceFile ();
+
+  /**
+   * Write the header of the file.
+   *
+   * \param os the output stream
+   * \param nPacketBytes the maximum number of bytes of each packet to store
+   */
+  void WriteHeader (std::ostream *os, uint16_t nPacketBytes);
+  /**
+   * Write an event.
+   *
+   * The node and device indexes are parsed from the context, when it
+   * starts with /NodeList/<node>/DeviceList/<device>.
+   *
+   * \param os the output stream
+   * \param type the type of the event
+   * \param time the time of the event
+   * \param context the trace context, or an empty string
+   * \param p the packet
+   * \param info the string describing the event, or an empty string
+   */
+  void Write (std::ostream *os, RecordType type, Time time, const std::string &context,
+              Ptr<const Packet> p, const std::string &info = "");
+
+  /**
+   * Read the header of the file.
+   *
+   * \param is the input stream
+   * \returns true if the header is valid
+   */
+  bool ReadHeader (std::istream *is);
+  /**
+   * Read the next event, and the strings defined before it.
+   *
+   * \param is the input stream
+   * \param record the record of the event
+   * \param bytes the bytes of the packet stored after the record
+   * \returns false at the end of the file or if it is truncated
+   */
+  bool Read (std::istream *is, Record &record, std::vector<uint8_t> &bytes);
+  /**
+   * \param index the index of a string
+   * \returns the string, or an empty string if index is NONE
+   */
+  std::string GetString (uint32_t index) const;
+  /**
+   * \returns the maximum number of bytes of each packet stored
+   */
+  uint16_t GetNPacketBytes (void) const;
+
+private:
+  /// The indexes of a trace context
+  struct Context
+  {
+    uint32_t index;  //!< the index of the context string
+    uint32_t node;   //!< the node of the context, or NONE
+    uint32_t device; //!< the device of the context, or NONE
+  };
+
+  /**
+   * Get the index of a string, and write it if it is new.
+   *
+   * \param os the output stream
+   * \param s the string
+   * \returns the index of the string
+   */
+  uint32_t WriteString (std::ostream *os, const std::string &s);
+  /**
+   * Get the indexes of a trace context, and write it if it is new.
+   *
+   * \param os the output stream
+   * \param context the trace context
+   * \returns the indexes of the context
+   */
+  const Context & WriteContext (std::ostream *os, const std::string &context);
+
+  uint16_t m_nPacketBytes;                     //!< the maximum number of bytes of each packet stored
+  std::map<std::string, uint32_t> m_indexes;   //!< the indexes of the strings written
+  std::map<std::string, Context> m_contexts;   //!< the trace contexts written
+  std::vector<std::string> m_strings;          //!< the strings read
+  std::vector<uint8_t> m_buffer;               //!< the bytes of the packet to write
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
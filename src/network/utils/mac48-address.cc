@@ -291,5 +291,19 @@ std::istream& operator>> (std::istream& is, Mac48Address & address)
   return is;
 }
 
+size_t
+Mac48AddressHash::operator () (Mac48Address const &x) const
+{
+  uint8_t buf[6];
+  x.CopyTo (buf);
+  // The addresses allocated by Mac48Address::Allocate() differ in their
+  // last bytes, so keep these in the low bits of the hash.
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      value = (value << 8) | buf[i];
+    }
+  return static_cast<size_t> (value);
+}
 
 } // namespace ns3
@@ -17,9 +17,12 @@
  */
 
 #include "output-stream-wrapper.h"
+#include "binary-trace-file.h"
 #include "ns3/log.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
 #include <fstream>
 
 namespace ns3 {
@@ -27,7 +30,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("OutputStreamWrapper");
 
 OutputStreamWrapper::OutputStreamWrapper (std::string filename, std::ios::openmode filemode)
-  : m_destroyable (true)
+  : m_destroyable (true),
+    m_binary (0)
 {
   NS_LOG_FUNCTION (this << filename << filemode);
   std::ofstream* os = new std::ofstream ();
@@ -39,7 +43,7 @@ OutputStreamWrapper::OutputStreamWrapper (std::string filename, std::ios::openmo
 }
 
 OutputStreamWrapper::OutputStreamWrapper (std::ostream* os)
-  : m_ostream (os), m_destroyable (false)
+  : m_ostream (os), m_destroyable (false), m_binary (0)
 {
   NS_LOG_FUNCTION (this << os);
   FatalImpl::RegisterStream (m_ostream);
@@ -52,13 +56,44 @@ OutputStreamWrapper::~OutputStreamWrapper ()
   FatalImpl::UnregisterStream (m_ostream);
   if (m_destroyable) delete m_ostream;
   m_ostream = 0;
+  delete m_binary;
+  m_binary = 0;
 }
 
 std::ostream *
 OutputStreamWrapper::GetStream (void)
 {
   NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_binary != 0, "Text written to a binary trace file: this trace sink "
+                   "does not support the binary format");
   return m_ostream;
 }
 
+void
+OutputStreamWrapper::SetBinary (uint16_t nPacketBytes)
+{
+  NS_LOG_FUNCTION (this << nPacketBytes);
+  NS_ABORT_MSG_IF (m_binary != 0, "The stream is already binary");
+  m_binary = new BinaryTraceFile ();
+  m_binary->WriteHeader (m_ostream, nPacketBytes);
+}
+
+BinaryTraceFile *
+OutputStreamWrapper::GetBinaryTraceFile (void)
+{
+  return m_binary;
+}
+
+bool
+OutputStreamWrapper::WriteBinaryRecord (BinaryTraceFile::RecordType type, const std::string &context,
+                                        Ptr<const Packet> p, const std::string &info)
+{
+  if (m_binary == 0)
+    {
+      return false;
+    }
+  m_binary->Write (m_ostream, type, Simulator::Now (), context, p, info);
+  return true;
+}
+
 } // namespace ns3
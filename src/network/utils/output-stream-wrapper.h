@@ -23,6 +23,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "binary-trace-file.h"
 
 namespace ns3 {
 
@@ -86,15 +87,53 @@ public:
   /**
    * Return a pointer to an ostream previously set in the wrapper.
    *
+   * The text written to a binary stream would corrupt the binary trace
+   * file, so this aborts if SetBinary has been called: the trace sinks
+   * which do not support the binary format, e.g., those of the IP
+   * helpers, cannot be connected to a binary stream.
+   *
    * \see SetStream
    *
    * \returns a pointer to the encapsulated std::ostream
    */
   std::ostream *GetStream (void);
 
+  /**
+   * Write the traced events in the compact binary format of
+   * BinaryTraceFile instead of text, and write the header of the file.
+   *
+   * The default trace sinks of AsciiTraceHelper, and the sinks which
+   * support it, then write their events with WriteBinaryRecord.
+   *
+   * \param nPacketBytes the maximum number of bytes of each packet stored
+   */
+  void SetBinary (uint16_t nPacketBytes);
+  /**
+   * \returns the binary trace file of the stream, or 0 if the events are
+   * written as text
+   */
+  BinaryTraceFile *GetBinaryTraceFile (void);
+  /**
+   * Write an event at the current simulation time in the binary trace
+   * file, if the events are not written as text.
+   *
+   * The trace sinks supporting the binary format call this first, and
+   * write their text line only if it returns false.
+   *
+   * \param type the type of the event
+   * \param context the trace context, or an empty string
+   * \param p the packet
+   * \param info the string describing the event, or an empty string
+   * \returns true if the event was written in the binary trace file, false
+   * if the events are written as text
+   */
+  bool WriteBinaryRecord (BinaryTraceFile::RecordType type, const std::string &context,
+                          Ptr<const Packet> p, const std::string &info = "");
+
 private:
   std::ostream *m_ostream; //!< The output stream
   bool m_destroyable; //!< Can be destroyed
+  BinaryTraceFile *m_binary; //!< The binary trace file, if the events are not written as text
 };
 
 } // namespace ns3
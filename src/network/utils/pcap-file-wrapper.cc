@@ -19,6 +19,8 @@
 #include "ns3/log.h"
 #include "ns3/boolean.h"
 #include "ns3/uinteger.h"
+#include "ns3/enum.h"
+#include "ns3/simulator.h"
 #include "ns3/buffer.h"
 #include "ns3/header.h"
 #include "pcap-file-wrapper.h"
@@ -46,12 +48,39 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("Asynchronous",
+                   "Whether the records are buffered and written by a writer thread.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapFileWrapper::m_asynchronous),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BufferSize",
+                   "The size in bytes of each buffer of records, in asynchronous mode.",
+                   UintegerValue (1 << 20),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_bufferSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("NBuffers",
+                   "The number of buffers of records, in asynchronous mode.",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_nBuffers),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("OverflowPolicy",
+                   "What to do with a record when all the buffers are full, in asynchronous mode.",
+                   EnumValue (PcapFileWrapper::BLOCK),
+                   MakeEnumAccessor (&PcapFileWrapper::m_overflowPolicy),
+                   MakeEnumChecker (PcapFileWrapper::BLOCK, "Block",
+                                    PcapFileWrapper::DROP, "Drop"))
   ;
   return tid;
 }
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_writerStarted (false),
+    m_current (-1),
+    m_used (0),
+    m_writing (false),
+    m_stop (false),
+    m_nDropped (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -86,9 +115,187 @@ void
 PcapFileWrapper::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writerStarted)
+    {
+      Flush ();
+#ifdef HAVE_PTHREAD_H
+      {
+        std::unique_lock<std::mutex> lock (m_mutex);
+        m_stop = true;
+        m_condition.notify_all ();
+      }
+      m_writer->Join ();
+      m_writer = 0;
+      m_stop = false;
+#endif
+      m_flushEvent.Cancel ();
+      m_buffers.clear ();
+      m_free.clear ();
+      m_writerStarted = false;
+    }
   m_file.Close ();
 }
 
+void
+PcapFileWrapper::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_writerStarted)
+    {
+      return;
+    }
+  if (m_current >= 0)
+    {
+      SubmitBuffer ();
+    }
+  std::unique_lock<std::mutex> lock (m_mutex);
+  m_condition.wait (lock, [this] { return m_full.empty () && !m_writing; });
+}
+
+uint64_t
+PcapFileWrapper::GetNDroppedRecords (void) const
+{
+  return m_nDropped;
+}
+
+void
+PcapFileWrapper::StartWriter (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_writerStarted);
+  m_buffers.assign (m_nBuffers, std::vector<uint8_t> (m_bufferSize));
+  for (uint32_t i = 0; i < m_nBuffers; i++)
+    {
+      m_free.push_back (i);
+    }
+  m_writerStarted = true;
+#ifdef HAVE_PTHREAD_H
+  m_writer = Create<SystemThread> (MakeCallback (&PcapFileWrapper::RunWriter, this));
+  m_writer->Start ();
+#endif
+  m_flushEvent = Simulator::ScheduleDestroy (&PcapFileWrapper::Flush, this);
+}
+
+void
+PcapFileWrapper::SubmitBuffer (void)
+{
+  NS_LOG_FUNCTION (this << m_current << m_used);
+  NS_ASSERT (m_current >= 0);
+#ifdef HAVE_PTHREAD_H
+  std::unique_lock<std::mutex> lock (m_mutex);
+  m_full.push_back (std::make_pair (m_current, m_used));
+  m_condition.notify_all ();
+#else
+  m_file.WriteRecords (m_buffers[m_current].data (), m_used);
+  m_free.push_back (m_current);
+#endif
+  m_current = -1;
+  m_used = 0;
+}
+
+bool
+PcapFileWrapper::AcquireBuffer (void)
+{
+  NS_ASSERT (m_current < 0);
+  std::unique_lock<std::mutex> lock (m_mutex);
+  if (m_overflowPolicy == BLOCK)
+    {
+      m_condition.wait (lock, [this] { return !m_free.empty (); });
+    }
+  else if (m_free.empty ())
+    {
+      return false;
+    }
+  m_current = m_free.front ();
+  m_free.pop_front ();
+  m_used = 0;
+  return true;
+}
+
+void
+PcapFileWrapper::RunWriter (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::unique_lock<std::mutex> lock (m_mutex);
+  while (true)
+    {
+      m_condition.wait (lock, [this] { return m_stop || !m_full.empty (); });
+      if (m_full.empty ())
+        {
+          return;
+        }
+      std::pair<uint32_t, uint32_t> buffer = m_full.front ();
+      m_full.pop_front ();
+      m_writing = true;
+      lock.unlock ();
+      // One write for all the records of the buffer
+      m_file.WriteRecords (m_buffers[buffer.first].data (), buffer.second);
+      lock.lock ();
+      m_writing = false;
+      m_free.push_back (buffer.first);
+      m_condition.notify_all ();
+    }
+}
+
+uint8_t *
+PcapFileWrapper::StartRecord (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint32_t &inclLen)
+{
+  if (!m_writerStarted)
+    {
+      StartWriter ();
+    }
+  uint32_t snapLen = m_file.GetSnapLen ();
+  inclLen = totalLen > snapLen ? snapLen : totalLen;
+  uint32_t size = 4 * sizeof (uint32_t) + inclLen;
+  if (m_current >= 0 && m_used + size > m_buffers[m_current].size ())
+    {
+      SubmitBuffer ();
+    }
+  if (m_current < 0 && !AcquireBuffer ())
+    {
+      NS_LOG_LOGIC ("All the buffers are full, drop the record");
+      m_nDropped++;
+      return 0;
+    }
+  std::vector<uint8_t> &buffer = m_buffers[m_current];
+  if (size > buffer.size ())
+    {
+      // The record does not fit in an empty buffer
+      buffer.resize (size);
+    }
+  uint32_t fields[4] = {tsSec, tsUsec, inclLen, totalLen};
+  if (m_file.GetSwapMode ())
+    {
+      for (uint32_t &field : fields)
+        {
+          field = ((field >> 24) & 0x000000ff) | ((field >> 8) & 0x0000ff00)
+            | ((field << 8) & 0x00ff0000) | ((field << 24) & 0xff000000);
+        }
+    }
+  // Same layout as the record headers written by PcapFile
+  uint8_t *record = buffer.data () + m_used;
+  std::memcpy (record, fields, sizeof (fields));
+  m_used += size;
+  return record + sizeof (fields);
+}
+
+void
+PcapFileWrapper::GetTimestamp (Time t, uint32_t &tsSec, uint32_t &tsUsec)
+{
+  if (m_file.IsNanoSecMode ())
+    {
+      uint64_t current = t.GetNanoSeconds ();
+      tsSec  = current / 1000000000;
+      tsUsec = current % 1000000000;
+    }
+  else
+    {
+      uint64_t current = t.GetMicroSeconds ();
+      tsSec  = current / 1000000;
+      tsUsec = current % 1000000;
+    }
+}
+
 void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
@@ -119,60 +326,66 @@ void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
-  if (m_file.IsNanoSecMode())
-    {
-      uint64_t current = t.GetNanoSeconds ();
-      uint64_t s       = current / 1000000000;
-      uint64_t ns      = current % 1000000000;
-      m_file.Write (s, ns, p);
-    }
-  else
+  uint32_t s;
+  uint32_t us;
+  GetTimestamp (t, s, us);
+  if (m_asynchronous)
     {
-      uint64_t current = t.GetMicroSeconds ();
-      uint64_t s       = current / 1000000;
-      uint64_t us      = current % 1000000;
-      m_file.Write (s, us, p);
+      uint32_t inclLen;
+      uint8_t *data = StartRecord (s, us, p->GetSize (), inclLen);
+      if (data != 0)
+        {
+          p->CopyData (data, inclLen);
+        }
+      return;
     }
+  m_file.Write (s, us, p);
 }
 
 void
 PcapFileWrapper::Write (Time t, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
-  if (m_file.IsNanoSecMode())
-    {
-      uint64_t current = t.GetNanoSeconds ();
-      uint64_t s       = current / 1000000000;
-      uint64_t ns      = current % 1000000000;
-      m_file.Write (s, ns, header, p);
-    }
-  else
+  uint32_t s;
+  uint32_t us;
+  GetTimestamp (t, s, us);
+  if (m_asynchronous)
     {
-      uint64_t current = t.GetMicroSeconds ();
-      uint64_t s       = current / 1000000;
-      uint64_t us      = current % 1000000;
-      m_file.Write (s, us, header, p);
+      uint32_t headerSize = header.GetSerializedSize ();
+      uint32_t inclLen;
+      uint8_t *data = StartRecord (s, us, headerSize + p->GetSize (), inclLen);
+      if (data != 0)
+        {
+          Buffer headerBuffer;
+          headerBuffer.AddAtStart (headerSize);
+          header.Serialize (headerBuffer.Begin ());
+          uint32_t toCopy = std::min (headerSize, inclLen);
+          headerBuffer.CopyData (data, toCopy);
+          p->CopyData (data + toCopy, inclLen - toCopy);
+        }
+      return;
     }
+  m_file.Write (s, us, header, p);
 }
 
 void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
-  if (m_file.IsNanoSecMode())
+  uint32_t s;
+  uint32_t us;
+  GetTimestamp (t, s, us);
+  if (m_asynchronous)
     {
-      uint64_t current = t.GetNanoSeconds ();
-      uint64_t s       = current / 1000000000;
-      uint64_t ns      = current % 1000000000;
-      m_file.Write (s, ns, buffer, length);
-    }
-  else
-    {
-      uint64_t current = t.GetMicroSeconds ();
-      uint64_t s       = current / 1000000;
-      uint64_t us      = current % 1000000;
-      m_file.Write (s, us, buffer, length);
+      uint32_t inclLen;
+      uint8_t *data = StartRecord (s, us, length, inclLen);
+      if (data != 0)
+        {
+          std::memcpy (data, buffer, inclLen);
+        }
+      return;
     }
+  m_file.Write (s, us, buffer, length);
 }
 
 Ptr<Packet> 
@@ -22,10 +22,20 @@
 #include <cstring>
 #include <limits>
 #include <fstream>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "ns3/core-config.h"
 #include "ns3/ptr.h"
 #include "ns3/packet.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 #include "pcap-file.h"
 
 namespace ns3 {
@@ -35,6 +45,16 @@ namespace ns3 {
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * In asynchronous mode (the "Asynchronous" attribute), the records are
+ * formatted into a ring of preallocated buffers on the simulation thread,
+ * and each full buffer is written at once by a writer thread.  The
+ * "BufferSize" and "NBuffers" attributes bound the memory used by the
+ * buffers, and the "OverflowPolicy" attribute tells whether a record is
+ * dropped, or waits for the writer thread to free a buffer, when all the
+ * buffers are full.  The buffered records are written by Flush (), which
+ * is called on Simulator::Destroy, and by Close ().  Without thread
+ * support, the full buffers are written by the simulation thread.
  */
 class PcapFileWrapper : public Object
 {
@@ -45,6 +65,13 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /// What to do with a record when all the buffers are full, in asynchronous mode
+  enum OverflowPolicy
+  {
+    BLOCK, //!< Wait for the writer thread to write a buffer
+    DROP   //!< Drop the record
+  };
+
   PcapFileWrapper ();
   ~PcapFileWrapper ();
 
@@ -82,6 +109,18 @@ public:
    */
   void Close (void);
 
+  /**
+   * Write the buffered records to the file, in asynchronous mode, and wait
+   * until they are written.
+   */
+  void Flush (void);
+
+  /**
+   * \return the number of records dropped because all the buffers were
+   * full, in asynchronous mode with the DROP policy.
+   */
+  uint64_t GetNDroppedRecords (void) const;
+
   /**
    * Initialize the pcap file associated with this wrapper.  This file must have
    * been previously opened with write permissions.
@@ -221,9 +260,64 @@ public:
   uint32_t GetDataLinkType (void);
 
 private:
+  /**
+   * \brief Get the pcap timestamp of a packet
+   * \param t Packet timestamp as ns3::Time.
+   * \param tsSec [out] Time stamp (seconds part)
+   * \param tsUsec [out] Time stamp (microseconds or nanoseconds part)
+   */
+  void GetTimestamp (Time t, uint32_t &tsSec, uint32_t &tsUsec);
+  /**
+   * \brief Format the header of a record in the current buffer, in
+   * asynchronous mode, and reserve room for the included bytes
+   * \param tsSec Time stamp (seconds part)
+   * \param tsUsec Time stamp (microseconds or nanoseconds part)
+   * \param totalLen total packet length
+   * \param inclLen [out] the number of bytes of the packet to include
+   * \returns where to copy the included bytes, or 0 if the record is dropped
+   */
+  uint8_t * StartRecord (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint32_t &inclLen);
+  /**
+   * Allocate the buffers and start the writer thread.
+   */
+  void StartWriter (void);
+  /**
+   * Hand the current buffer to the writer thread.
+   */
+  void SubmitBuffer (void);
+  /**
+   * Take a free buffer as the current buffer.
+   * \returns false if no buffer is free and the record must be dropped
+   */
+  bool AcquireBuffer (void);
+  /**
+   * The loop of the writer thread.
+   */
+  void RunWriter (void);
+
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
   bool     m_nanosecMode; //!< Timestamps in nanosecond mode
+
+  bool m_asynchronous;              //!< Asynchronous mode
+  uint32_t m_bufferSize;            //!< size of each buffer
+  uint32_t m_nBuffers;              //!< number of buffers
+  OverflowPolicy m_overflowPolicy;  //!< what to do when all the buffers are full
+  bool m_writerStarted;             //!< whether the buffers are allocated
+  std::vector<std::vector<uint8_t> > m_buffers; //!< the buffers
+  int32_t m_current;                //!< index of the buffer being filled, or -1
+  uint32_t m_used;                  //!< number of bytes used in the current buffer
+  std::deque<uint32_t> m_free;      //!< indexes of the free buffers
+  std::deque<std::pair<uint32_t, uint32_t> > m_full; //!< indexes and sizes of the buffers to write
+  bool m_writing;                   //!< whether the writer thread is writing a buffer
+  bool m_stop;                      //!< whether the writer thread must stop
+  uint64_t m_nDropped;              //!< number of dropped records
+  std::mutex m_mutex;               //!< protects the queues of buffers
+  std::condition_variable m_condition; //!< notified when the queues change
+  EventId m_flushEvent;             //!< flush on Simulator::Destroy
+#ifdef HAVE_PTHREAD_H
+  Ptr<SystemThread> m_writer;       //!< the writer thread
+#endif
 };
 
 } // namespace ns3
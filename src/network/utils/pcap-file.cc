@@ -465,6 +465,15 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<cons
   p->CopyData (&m_file, inclLen);
 }
 
+void
+PcapFile::WriteRecords (uint8_t const * const records, uint32_t size)
+{
+  NS_LOG_FUNCTION (this << &records << size);
+  NS_ASSERT (m_file.good ());
+  m_file.write ((const char *)records, size);
+  NS_BUILD_DEBUG(m_file.flush());
+}
+
 void
 PcapFile::Read (
   uint8_t * const data, 
@@ -153,6 +153,19 @@ public:
    */
   void Write (uint32_t tsSec, uint32_t tsUsec, const Header &header, Ptr<const Packet> p);
 
+  /**
+   * \brief Write records already formatted to file
+   *
+   * Each record is a record header, as written by the other Write methods,
+   * followed by the included bytes of the packet.  This lets a caller
+   * format the records in memory, and write many of them at once.
+   *
+   * \param records     Buffer of formatted records
+   * \param size        Size of the buffer
+   *
+   */
+  void WriteRecords (uint8_t const * const records, uint32_t size);
+
 
   /**
    * \brief Read next packet from file
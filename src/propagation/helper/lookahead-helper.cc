@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lookahead-helper.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/mobility-model.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LookaheadHelper");
+
+Time
+LookaheadHelper::Calculate (Callback<uint32_t, uint32_t> partitionOf)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Time lookahead = Time::Max ();
+  for (ChannelList::Iterator i = ChannelList::Begin (); i != ChannelList::End (); ++i)
+    {
+      lookahead = std::min (lookahead, Calculate (*i, partitionOf));
+    }
+  return lookahead;
+}
+
+Time
+LookaheadHelper::Calculate (Ptr<Channel> channel, Callback<uint32_t, uint32_t> partitionOf)
+{
+  NS_LOG_FUNCTION (channel);
+  Time lookahead = Time::Max ();
+
+  PointerValue delayModelValue;
+  TimeValue delayValue;
+  Ptr<PropagationDelayModel> delayModel;
+  bool fixedDelay = false;
+  if (channel->GetAttributeFailSafe ("PropagationDelayModel", delayModelValue))
+    {
+      delayModel = delayModelValue.Get<PropagationDelayModel> ();
+    }
+  else if (channel->GetAttributeFailSafe ("Delay", delayValue))
+    {
+      fixedDelay = true;
+    }
+  bool constantSpeed = (DynamicCast<ConstantSpeedPropagationDelayModel> (delayModel) != 0);
+  // This module does not depend on the spectrum module
+  TypeId spectrumChannel;
+  bool spectrum = TypeId::LookupByNameFailSafe ("ns3::SpectrumChannel", &spectrumChannel)
+    && channel->GetInstanceTypeId ().IsChildOf (spectrumChannel);
+
+  for (uint32_t i = 0; i < channel->GetNDevices (); ++i)
+    {
+      Ptr<Node> a = channel->GetDevice (i)->GetNode ();
+      for (uint32_t j = i + 1; j < channel->GetNDevices (); ++j)
+        {
+          Ptr<Node> b = channel->GetDevice (j)->GetNode ();
+          if (partitionOf (a->GetId ()) == partitionOf (b->GetId ()))
+            {
+              continue;
+            }
+          NS_ABORT_MSG_IF (spectrum, "Channel " << channel->GetId () << " is a SpectrumChannel "
+                           "connecting partitions, which MultithreadedSimulatorImpl does not support");
+          if (fixedDelay)
+            {
+              return delayValue.Get ();
+            }
+          if (!constantSpeed)
+            {
+              NS_LOG_WARN ("Channel " << channel->GetId () << " connects partitions "
+                           "without a constant speed propagation delay: zero lookahead");
+              return Seconds (0);
+            }
+          Ptr<MobilityModel> ma = a->GetObject<MobilityModel> ();
+          Ptr<MobilityModel> mb = b->GetObject<MobilityModel> ();
+          NS_ABORT_MSG_IF (ma == 0 || mb == 0, "Nodes " << a->GetId () << " and "
+                           << b->GetId () << " need a MobilityModel");
+          // The delay only bounds the lookahead if the nodes do not move
+          NS_ABORT_MSG_IF (ma->GetVelocity ().GetLength () != 0 || mb->GetVelocity ().GetLength () != 0,
+                           "Nodes " << a->GetId () << " and " << b->GetId () << " must not move");
+          if (ma->GetDistanceFrom (mb) == 0)
+            {
+              NS_LOG_WARN ("Nodes " << a->GetId () << " and " << b->GetId () <<
+                           " of different partitions are at the same position: zero lookahead");
+              return Seconds (0);
+            }
+          lookahead = std::min (lookahead, delayModel->GetDelay (ma, mb));
+        }
+    }
+  NS_LOG_DEBUG ("Channel " << channel->GetId () << " lookahead " << lookahead);
+  return lookahead;
+}
+
+} // namespace ns3
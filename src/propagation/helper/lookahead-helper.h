@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LOOKAHEAD_HELPER_H
+#define LOOKAHEAD_HELPER_H
+
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Channel;
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Compute the lookahead of a parallel simulation from the
+ * propagation delays of the channels.
+ *
+ * Every channel delivers a transmission to its receivers with
+ * Simulator::ScheduleWithContext after the propagation delay, so the
+ * smallest delay between two nodes of different partitions bounds
+ * how far each partition can safely run ahead of the others (see
+ * ns3::MultithreadedSimulatorImpl).
+ *
+ * Channels with a "PropagationDelayModel" attribute (e.g.,
+ * YansWifiChannel) are evaluated for every pair of devices in different
+ * partitions, using the current positions of the nodes; only
+ * ConstantSpeedPropagationDelayModel gives a non-zero bound.  Channels
+ * with a "Delay" attribute (e.g., point-to-point and CSMA channels)
+ * contribute this delay.  Other channels which connect different
+ * partitions yield a zero lookahead.  The spectrum channels share the
+ * signals of a transmission with all their receivers, so they are not
+ * supported: Calculate aborts if a SpectrumChannel connects different
+ * partitions.
+ *
+ * The positions are sampled once, so the nodes of the wireless channels
+ * must not move: Calculate aborts if one of the nodes it evaluates has
+ * a non-zero velocity.  Two nodes of different partitions at the same
+ * position yield a zero lookahead, with a warning.
+ */
+class LookaheadHelper
+{
+public:
+  /**
+   * Compute the lookahead over all the channels in the ChannelList.
+   *
+   * \param partitionOf Callback giving the partition of a node id, e.g.,
+   *        MultithreadedSimulatorImpl::GetPartition.
+   * \return The smallest delay between nodes of different partitions,
+   *         or Time::Max () if no channel crosses partitions.
+   */
+  static Time Calculate (Callback<uint32_t, uint32_t> partitionOf);
+  /**
+   * Compute the lookahead of a single channel.
+   *
+   * \param channel The channel.
+   * \param partitionOf Callback giving the partition of a node id.
+   * \return The smallest delay between nodes of different partitions
+   *         attached to this channel, or Time::Max () if there is none.
+   */
+  static Time Calculate (Ptr<Channel> channel, Callback<uint32_t, uint32_t> partitionOf);
+};
+
+} // namespace ns3
+
+#endif /* LOOKAHEAD_HELPER_H */
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/pointer.h"
+#include "ns3/nstime.h"
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/lookahead-helper.h"
+
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup propagation-tests
+ *
+ * A channel with a propagation delay model, as the wireless channels.
+ */
+class LookaheadTestChannel : public Channel
+{
+public:
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * Attach a device.
+   * \param device The device.
+   */
+  void Add (Ptr<NetDevice> device);
+  virtual std::size_t GetNDevices (void) const;
+  virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
+
+private:
+  virtual void DoDispose (void);
+
+  Ptr<PropagationDelayModel> m_delay;     //!< The propagation delay model
+  std::vector<Ptr<NetDevice> > m_devices; //!< The attached devices
+};
+
+TypeId
+LookaheadTestChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LookaheadTestChannel")
+    .SetParent<Channel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<LookaheadTestChannel> ()
+    .AddAttribute ("PropagationDelayModel",
+                   "The propagation delay model of the channel.",
+                   PointerValue (),
+                   MakePointerAccessor (&LookaheadTestChannel::m_delay),
+                   MakePointerChecker<PropagationDelayModel> ())
+  ;
+  return tid;
+}
+
+void
+LookaheadTestChannel::Add (Ptr<NetDevice> device)
+{
+  m_devices.push_back (device);
+}
+
+std::size_t
+LookaheadTestChannel::GetNDevices (void) const
+{
+  return m_devices.size ();
+}
+
+Ptr<NetDevice>
+LookaheadTestChannel::GetDevice (std::size_t i) const
+{
+  return m_devices[i];
+}
+
+void
+LookaheadTestChannel::DoDispose (void)
+{
+  m_devices.clear ();
+  m_delay = 0;
+  Channel::DoDispose ();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * Check the lookahead computed from the channels.
+ */
+class LookaheadHelperTestCase : public TestCase
+{
+public:
+  LookaheadHelperTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Create a node with a device and a position.
+   * \param partition The partition of the node.
+   * \param position The position of the node.
+   * \return The device.
+   */
+  Ptr<SimpleNetDevice> CreateDevice (uint32_t partition, Vector position);
+  /**
+   * \param node The node id.
+   * \return The partition of the node.
+   */
+  uint32_t GetPartition (uint32_t node);
+
+  std::map<uint32_t, uint32_t> m_partitions; //!< The partition of each node
+};
+
+LookaheadHelperTestCase::LookaheadHelperTestCase ()
+  : TestCase ("Check the lookahead of the channels")
+{
+}
+
+Ptr<SimpleNetDevice>
+LookaheadHelperTestCase::CreateDevice (uint32_t partition, Vector position)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (position);
+  node->AggregateObject (mobility);
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  node->AddDevice (device);
+  m_partitions[node->GetId ()] = partition;
+  return device;
+}
+
+uint32_t
+LookaheadHelperTestCase::GetPartition (uint32_t node)
+{
+  return m_partitions[node];
+}
+
+void
+LookaheadHelperTestCase::DoRun (void)
+{
+  Callback<uint32_t, uint32_t> partitionOf = MakeCallback (&LookaheadHelperTestCase::GetPartition, this);
+
+  // A wireless channel: 300 m between the partitions, i.e., 1 us
+  Ptr<LookaheadTestChannel> wireless = CreateObject<LookaheadTestChannel> ();
+  wireless->SetAttribute ("PropagationDelayModel", PointerValue (CreateObject<ConstantSpeedPropagationDelayModel> ()));
+  wireless->Add (CreateDevice (0, Vector (0, 0, 0)));
+  wireless->Add (CreateDevice (0, Vector (10, 0, 0)));
+  wireless->Add (CreateDevice (1, Vector (310, 0, 0)));
+  wireless->Add (CreateDevice (1, Vector (320, 0, 0)));
+  Time expected = Seconds (300.0 / 299792458.0);
+  NS_TEST_EXPECT_MSG_EQ (LookaheadHelper::Calculate (wireless, partitionOf), expected,
+                         "Wrong lookahead of the propagation delay");
+
+  // A channel with a fixed delay
+  Ptr<SimpleChannel> wired = CreateObject<SimpleChannel> ();
+  wired->SetAttribute ("Delay", TimeValue (MicroSeconds (50)));
+  Ptr<SimpleNetDevice> device = CreateDevice (0, Vector (0, 0, 0));
+  device->SetChannel (wired);
+  device = CreateDevice (0, Vector (0, 0, 0));
+  device->SetChannel (wired);
+  NS_TEST_EXPECT_MSG_EQ (LookaheadHelper::Calculate (wired, partitionOf), Time::Max (),
+                         "A channel within a partition does not bound the lookahead");
+  device = CreateDevice (1, Vector (0, 0, 0));
+  device->SetChannel (wired);
+  NS_TEST_EXPECT_MSG_EQ (LookaheadHelper::Calculate (wired, partitionOf), MicroSeconds (50),
+                         "Wrong lookahead of the fixed delay");
+
+  // All the channels
+  NS_TEST_EXPECT_MSG_EQ (LookaheadHelper::Calculate (partitionOf), expected,
+                         "Wrong lookahead of the channel list");
+
+  // Two nodes of different partitions at the same position
+  wireless->Add (CreateDevice (2, Vector (10, 0, 0)));
+  NS_TEST_EXPECT_MSG_EQ (LookaheadHelper::Calculate (wireless, partitionOf), Seconds (0),
+                         "Nodes at the same position give a zero lookahead");
+
+  // A delay model without a lower bound
+  Ptr<LookaheadTestChannel> random = CreateObject<LookaheadTestChannel> ();
+  random->SetAttribute ("PropagationDelayModel", PointerValue (CreateObject<RandomPropagationDelayModel> ()));
+  random->Add (CreateDevice (0, Vector (0, 0, 0)));
+  random->Add (CreateDevice (1, Vector (1000, 0, 0)));
+  NS_TEST_EXPECT_MSG_EQ (LookaheadHelper::Calculate (random, partitionOf), Seconds (0),
+                         "A random delay gives a zero lookahead");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * The LookaheadHelper test suite.
+ */
+class LookaheadHelperTestSuite : public TestSuite
+{
+public:
+  LookaheadHelperTestSuite ();
+};
+
+LookaheadHelperTestSuite::LookaheadHelperTestSuite ()
+  : TestSuite ("lookahead-helper", UNIT)
+{
+  AddTestCase (new LookaheadHelperTestCase, TestCase::QUICK);
+}
+
+static LookaheadHelperTestSuite g_lookaheadHelperTestSuite; //!< Static variable for test initialization
@@ -296,6 +296,17 @@ def register_types(module):
     typehandlers.add_type_alias(u'void ( * ) ( ns3::Ptr< ns3::SpectrumValue > )', u'ns3::SpectrumValue::TracedCallback')
     typehandlers.add_type_alias(u'void ( * ) ( ns3::Ptr< ns3::SpectrumValue > )*', u'ns3::SpectrumValue::TracedCallback*')
     typehandlers.add_type_alias(u'void ( * ) ( ns3::Ptr< ns3::SpectrumValue > )&', u'ns3::SpectrumValue::TracedCallback&')
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::ConstValuesIterator [class]
+    module.add_class('ConstValuesIterator', outer_class=root_module['ns3::SpectrumValue'])
+    typehandlers.add_type_alias(u'double', u'ns3::SpectrumValue::ConstValuesIterator::value_type')
+    typehandlers.add_type_alias(u'double*', u'ns3::SpectrumValue::ConstValuesIterator::value_type*')
+    typehandlers.add_type_alias(u'double&', u'ns3::SpectrumValue::ConstValuesIterator::value_type&')
+    typehandlers.add_type_alias(u'int', u'ns3::SpectrumValue::ConstValuesIterator::difference_type')
+    typehandlers.add_type_alias(u'int*', u'ns3::SpectrumValue::ConstValuesIterator::difference_type*')
+    typehandlers.add_type_alias(u'int&', u'ns3::SpectrumValue::ConstValuesIterator::difference_type&')
+    typehandlers.add_type_alias(u'double', u'ns3::SpectrumValue::ConstValuesIterator::reference')
+    typehandlers.add_type_alias(u'double*', u'ns3::SpectrumValue::ConstValuesIterator::reference*')
+    typehandlers.add_type_alias(u'double&', u'ns3::SpectrumValue::ConstValuesIterator::reference&')
     ## propagation-loss-model.h (module 'propagation'): ns3::ThreeLogDistancePropagationLossModel [class]
     module.add_class('ThreeLogDistancePropagationLossModel', import_from_module='ns.propagation', parent=root_module['ns3::PropagationLossModel'])
     ## nstime.h (module 'core'): ns3::Time [class]
@@ -884,6 +895,7 @@ def register_methods(root_module):
     register_Ns3SpectrumPropagationLossModel_methods(root_module, root_module['ns3::SpectrumPropagationLossModel'])
     register_Ns3SpectrumSignalParameters_methods(root_module, root_module['ns3::SpectrumSignalParameters'])
     register_Ns3SpectrumValue_methods(root_module, root_module['ns3::SpectrumValue'])
+    register_Ns3SpectrumValueConstValuesIterator_methods(root_module, root_module['ns3::SpectrumValue::ConstValuesIterator'])
     register_Ns3ThreeLogDistancePropagationLossModel_methods(root_module, root_module['ns3::ThreeLogDistancePropagationLossModel'])
     register_Ns3Time_methods(root_module, root_module['ns3::Time'])
     register_Ns3TraceFadingLossModel_methods(root_module, root_module['ns3::TraceFadingLossModel'])
@@ -4584,12 +4596,20 @@ def register_Ns3SpectrumValue_methods(root_module, cls):
     cls.add_inplace_numeric_operator('-=', param('double', u'right'))
     cls.add_inplace_numeric_operator('/=', param('ns3::SpectrumValue const &', u'right'))
     cls.add_inplace_numeric_operator('/=', param('double', u'right'))
-    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::SpectrumValue(ns3::SpectrumValue const & arg0) [constructor]
-    cls.add_constructor([param('ns3::SpectrumValue const &', 'arg0')])
     ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::SpectrumValue(ns3::Ptr<const ns3::SpectrumModel> sm) [constructor]
     cls.add_constructor([param('ns3::Ptr< ns3::SpectrumModel const >', 'sm')])
     ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::SpectrumValue() [constructor]
     cls.add_constructor([])
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::SpectrumValue(ns3::SpectrumValue const & o) [constructor]
+    cls.add_constructor([param('ns3::SpectrumValue const &', 'o')])
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue & ns3::SpectrumValue::AddProduct(ns3::SpectrumValue const & x, ns3::SpectrumValue const & y) [member function]
+    cls.add_method('AddProduct', 
+                   'ns3::SpectrumValue &', 
+                   [param('ns3::SpectrumValue const &', 'x'), param('ns3::SpectrumValue const &', 'y')])
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue & ns3::SpectrumValue::AddScaled(ns3::SpectrumValue const & x, double s) [member function]
+    cls.add_method('AddScaled', 
+                   'ns3::SpectrumValue &', 
+                   [param('ns3::SpectrumValue const &', 'x'), param('double', 's')])
     ## spectrum-value.h (module 'spectrum'): std::vector<ns3::BandInfo, std::allocator<ns3::BandInfo> >::const_iterator ns3::SpectrumValue::ConstBandsBegin() const [member function]
     cls.add_method('ConstBandsBegin', 
                    'std::vector< ns3::BandInfo > const_iterator', 
@@ -4600,14 +4620,14 @@ def register_Ns3SpectrumValue_methods(root_module, cls):
                    'std::vector< ns3::BandInfo > const_iterator', 
                    [], 
                    is_const=True)
-    ## spectrum-value.h (module 'spectrum'): std::vector<double, std::allocator<double> >::const_iterator ns3::SpectrumValue::ConstValuesBegin() const [member function]
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::ConstValuesIterator ns3::SpectrumValue::ConstValuesBegin() const [member function]
     cls.add_method('ConstValuesBegin', 
-                   'std::vector< double > const_iterator', 
+                   'ns3::SpectrumValue::ConstValuesIterator', 
                    [], 
                    is_const=True)
-    ## spectrum-value.h (module 'spectrum'): std::vector<double, std::allocator<double> >::const_iterator ns3::SpectrumValue::ConstValuesEnd() const [member function]
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::ConstValuesIterator ns3::SpectrumValue::ConstValuesEnd() const [member function]
     cls.add_method('ConstValuesEnd', 
-                   'std::vector< double > const_iterator', 
+                   'ns3::SpectrumValue::ConstValuesIterator', 
                    [], 
                    is_const=True)
     ## spectrum-value.h (module 'spectrum'): ns3::Ptr<ns3::SpectrumValue> ns3::SpectrumValue::Copy() const [member function]
@@ -4615,6 +4635,16 @@ def register_Ns3SpectrumValue_methods(root_module, cls):
                    'ns3::Ptr< ns3::SpectrumValue >', 
                    [], 
                    is_const=True)
+    ## spectrum-value.h (module 'spectrum'): uint32_t ns3::SpectrumValue::GetOccupiedEnd() const [member function]
+    cls.add_method('GetOccupiedEnd', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## spectrum-value.h (module 'spectrum'): uint32_t ns3::SpectrumValue::GetOccupiedStart() const [member function]
+    cls.add_method('GetOccupiedStart', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
     ## spectrum-value.h (module 'spectrum'): ns3::Ptr<const ns3::SpectrumModel> ns3::SpectrumValue::GetSpectrumModel() const [member function]
     cls.add_method('GetSpectrumModel', 
                    'ns3::Ptr< ns3::SpectrumModel const >', 
@@ -4630,9 +4660,13 @@ def register_Ns3SpectrumValue_methods(root_module, cls):
                    'uint32_t', 
                    [], 
                    is_const=True)
-    ## spectrum-value.h (module 'spectrum'): double const & ns3::SpectrumValue::ValuesAt(uint32_t pos) const [member function]
+    ## spectrum-value.h (module 'spectrum'): void ns3::SpectrumValue::SetOccupiedRange(uint32_t start, uint32_t end) [member function]
+    cls.add_method('SetOccupiedRange', 
+                   'void', 
+                   [param('uint32_t', 'start'), param('uint32_t', 'end')])
+    ## spectrum-value.h (module 'spectrum'): double ns3::SpectrumValue::ValuesAt(uint32_t pos) const [member function]
     cls.add_method('ValuesAt', 
-                   'double const &', 
+                   'double', 
                    [param('uint32_t', 'pos')], 
                    is_const=True)
     ## spectrum-value.h (module 'spectrum'): std::vector<double, std::allocator<double> >::iterator ns3::SpectrumValue::ValuesBegin() [member function]
@@ -4645,6 +4679,25 @@ def register_Ns3SpectrumValue_methods(root_module, cls):
                    [])
     return
 
+def register_Ns3SpectrumValueConstValuesIterator_methods(root_module, cls):
+    cls.add_binary_comparison_operator('!=')
+    cls.add_binary_comparison_operator('<')
+    cls.add_binary_comparison_operator('<=')
+    cls.add_binary_comparison_operator('==')
+    cls.add_binary_comparison_operator('>')
+    cls.add_binary_comparison_operator('>=')
+    cls.add_binary_numeric_operator('+', root_module['ns3::SpectrumValue::ConstValuesIterator'], root_module['ns3::SpectrumValue::ConstValuesIterator'], param('int', u'right'))
+    cls.add_binary_numeric_operator('-', root_module['ns3::SpectrumValue::ConstValuesIterator'], root_module['ns3::SpectrumValue::ConstValuesIterator'], param('int', u'right'))
+    cls.add_inplace_numeric_operator('+=', param('int', u'right'))
+    cls.add_inplace_numeric_operator('-=', param('int', u'right'))
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::ConstValuesIterator::ConstValuesIterator(ns3::SpectrumValue::ConstValuesIterator const & arg0) [constructor]
+    cls.add_constructor([param('ns3::SpectrumValue::ConstValuesIterator const &', 'arg0')])
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::ConstValuesIterator::ConstValuesIterator() [constructor]
+    cls.add_constructor([])
+    ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue::ConstValuesIterator::ConstValuesIterator(ns3::SpectrumValue::Values const * values, uint32_t start, double gain, uint32_t index) [constructor]
+    cls.add_constructor([param('std::vector< double > const *', 'values'), param('uint32_t', 'start'), param('double', 'gain'), param('uint32_t', 'index')])
+    return
+
 def register_Ns3ThreeLogDistancePropagationLossModel_methods(root_module, cls):
     ## propagation-loss-model.h (module 'propagation'): static ns3::TypeId ns3::ThreeLogDistancePropagationLossModel::GetTypeId() [member function]
     cls.add_method('GetTypeId', 
@@ -9056,6 +9109,10 @@ def register_functions(root_module):
     module.add_function('Integral', 
                         'double', 
                         [param('ns3::SpectrumValue const &', 'arg')])
+    ## spectrum-value.h (module 'spectrum'): double ns3::IntegralOfProduct(ns3::SpectrumValue const & lhs, ns3::SpectrumValue const & rhs) [free function]
+    module.add_function('IntegralOfProduct', 
+                        'double', 
+                        [param('ns3::SpectrumValue const &', 'lhs'), param('ns3::SpectrumValue const &', 'rhs')])
     ## spectrum-value.h (module 'spectrum'): ns3::SpectrumValue ns3::Log(ns3::SpectrumValue const & arg) [free function]
     module.add_function('Log', 
                         'ns3::SpectrumValue', 
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the cost of the SpectrumValue arithmetic on the
+// power spectral densities of HE signals, as computed by the interference
+// models of the spectrum based PHYs.
+//
+// Each iteration computes, with the operators creating a new SpectrumValue
+// for each result and then with the in-place and fused operations:
+//  - the SINR of a signal, rx / (all - rx + noise);
+//  - the sum of the products of two signals with a filter, and of the
+//    signals scaled by a path gain;
+//  - the integral of a signal and of its product with a filter;
+//  - the power through the filter of a 20 MHz signal converted to the
+//    model of the receiver, with only the occupied bands stored and then
+//    with all the bands stored.
+//
+// The program can be configured at run-time by passing command-line
+// arguments: the channel width in MHz (--channelWidth) and the number of
+// iterations (--nIterations).  It outputs the wall-clock time of each
+// variant, in microseconds per iteration, and the sum of the computed
+// values, which must be the same for both variants of each operation.
+//
+
+#include <iomanip>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/spectrum-converter.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+
+using namespace ns3;
+
+/**
+ * Print the wall-clock time per iteration and the sum of the values.
+ * \param name the name of the variant
+ * \param elapsed the wall-clock time (ms)
+ * \param nIterations the number of iterations
+ * \param sum the sum of the values
+ */
+static void
+Print (std::string name, int64_t elapsed, uint32_t nIterations, double sum)
+{
+  std::cout << std::left << std::setw (28) << name
+            << std::right << std::setw (10) << std::fixed << std::setprecision (3)
+            << elapsed * 1000.0 / nIterations << " us"
+            << "   sum " << std::scientific << std::setprecision (17) << sum << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint16_t channelWidth = 160;
+  uint32_t nIterations = 2000;
+
+  CommandLine cmd;
+  cmd.AddValue ("channelWidth", "Channel width in MHz", channelWidth);
+  cmd.AddValue ("nIterations", "Number of iterations", nIterations);
+  cmd.Parse (argc, argv);
+
+  uint32_t centerFrequency = channelWidth == 160 ? 5570 : 5180 + (channelWidth - 20) / 2;
+  Ptr<SpectrumValue> rx = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1e-9, channelWidth);
+  Ptr<SpectrumValue> other = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 3e-10, channelWidth);
+  Ptr<SpectrumValue> noise = WifiSpectrumValueHelper::CreateNoisePowerSpectralDensity (centerFrequency, channelWidth, 78125, 7, channelWidth);
+  Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (centerFrequency, channelWidth, 78125, channelWidth);
+  SpectrumValue all = (*rx) + (*other);
+  std::cout << channelWidth << " MHz, " << rx->GetValuesN () << " bands" << std::endl;
+
+  SystemWallClockMs clock;
+  double sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      SpectrumValue sinr = (*rx) / (all - (*rx) + (*noise));
+      sum += sinr[i % sinr.GetValuesN ()];
+    }
+  Print ("SINR, temporaries", clock.End (), nIterations, sum);
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      SpectrumValue interference = all - (*rx);
+      interference += (*noise);
+      SpectrumValue sinr = (*rx) / interference;
+      sum += sinr[i % sinr.GetValuesN ()];
+    }
+  Print ("SINR, in place", clock.End (), nIterations, sum);
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      SpectrumValue acc = (*rx) * (*filter);
+      acc += (*other) * (*filter);
+      acc += (*rx) * 0.5;
+      acc += (*other) * 0.25;
+      sum += acc[i % acc.GetValuesN ()];
+    }
+  Print ("Accumulate, temporaries", clock.End (), nIterations, sum);
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      SpectrumValue acc = (*rx) * (*filter);
+      acc.AddProduct (*other, *filter);
+      acc.AddScaled (*rx, 0.5);
+      acc.AddScaled (*other, 0.25);
+      sum += acc[i % acc.GetValuesN ()];
+    }
+  Print ("Accumulate, fused", clock.End (), nIterations, sum);
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      sum += Integral (*rx) + Integral ((*rx) * (*filter));
+    }
+  Print ("Integral, temporaries", clock.End (), nIterations, sum);
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      sum += Integral (*rx) + IntegralOfProduct (*rx, *filter);
+    }
+  Print ("Integral, fused", clock.End (), nIterations, sum);
+
+  Ptr<SpectrumValue> narrow = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (centerFrequency - (channelWidth - 20) / 2, 20, 1e-9, 20);
+  SpectrumConverter converter (narrow->GetSpectrumModel (), rx->GetSpectrumModel ());
+  Ptr<SpectrumValue> converted = converter.Convert (narrow);
+  std::cout << "20 MHz signal: " << converted->GetOccupiedEnd () - converted->GetOccupiedStart ()
+            << " occupied bands" << std::endl;
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      SpectrumValue signal = *converter.Convert (narrow);
+      signal *= 0.5;
+      signal.ValuesBegin (); // Stores all the bands
+      sum += IntegralOfProduct (signal, *filter);
+    }
+  Print ("Converted, all bands", clock.End (), nIterations, sum);
+
+  sum = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nIterations; i++)
+    {
+      SpectrumValue signal = *converter.Convert (narrow);
+      signal *= 0.5;
+      sum += IntegralOfProduct (signal, *filter);
+    }
+  Print ("Converted, occupied bands", clock.End (), nIterations, sum);
+
+  return 0;
+}
@@ -54,7 +54,7 @@ WriteAveragePowerSpectralDensityReport (Ptr<OutputStreamWrapper> streamWrapper,
   if (ostream->good ())
     {
       Bands::const_iterator fi = avgPowerSpectralDensity->ConstBandsBegin ();
-      Values::const_iterator vi = avgPowerSpectralDensity->ConstValuesBegin ();
+      SpectrumValue::ConstValuesIterator vi = avgPowerSpectralDensity->ConstValuesBegin ();
       while (fi != avgPowerSpectralDensity->ConstBandsEnd ())
         {
           NS_ASSERT (vi != avgPowerSpectralDensity->ConstValuesEnd ());
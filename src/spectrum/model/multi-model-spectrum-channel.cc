@@ -79,7 +79,10 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_maxRange (0),
+    m_minRxPowerDbm (-1e9),
+    m_txCount (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,6 +93,13 @@ MultiModelSpectrumChannel::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_grid.Clear ();
+  m_gridPhyIds.clear ();
+  m_gridMobilities.clear ();
+  m_gridIndexes.clear ();
+  m_phyIds.clear ();
+  m_phys.clear ();
+  m_inRange.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -100,7 +110,22 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("MaxRange",
+                   "The distance (m) beyond which receivers are skipped without computing "
+                   "the path loss, or 0 to consider all the receivers.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::SetMaxRange,
+                                       &MultiModelSpectrumChannel::GetMaxRange),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("MinRxPowerDbm",
+                   "The total received power (dBm), including the antenna gains and the "
+                   "PropagationLossModel but not the SpectrumPropagationLossModel, below "
+                   "which transmissions are not passed to the receiving PHY. Like MaxLossDb, "
+                   "it reduces the computational load by not propagating signals that are "
+                   "far below the interference level.",
+                   DoubleValue (-1.0e9),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_minRxPowerDbm),
+                   MakeDoubleChecker<double> ())
   ;
   return tid;
 }
@@ -116,6 +141,17 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 
   SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
 
+  std::pair<std::map<Ptr<SpectrumPhy>, uint32_t>::iterator, bool> id;
+  id = m_phyIds.insert (std::make_pair (phy, m_phys.size ()));
+  if (id.second)
+    {
+      m_phys.push_back (phy);
+      m_inRange.push_back (0);
+      m_gridMobilities.push_back (0);
+      m_gridIndexes.push_back (0);
+    }
+  uint32_t phyId = id.first->second;
+
   // remove a previous entry of this phy if it exists
   // we need to scan for all rxSpectrumModel values since we don't
   // know which spectrum model the phy had when it was previously added
@@ -127,6 +163,8 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       auto phyIt = std::find (rxInfoIterator->second.m_rxPhys.begin(), rxInfoIterator->second.m_rxPhys.end(), phy);
       if (phyIt != rxInfoIterator->second.m_rxPhys.end ())
         {
+          rxInfoIterator->second.m_rxPhyIds.erase (rxInfoIterator->second.m_rxPhyIds.begin ()
+                                                   + (phyIt - rxInfoIterator->second.m_rxPhys.begin ()));
           rxInfoIterator->second.m_rxPhys.erase (phyIt);
           --m_numDevices;
           break; // there should be at most one entry
@@ -145,6 +183,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       NS_ASSERT (ret.second);
       // also add the phy to the newly created set of SpectrumPhy for this RxSpectrumModel
       ret.first->second.m_rxPhys.push_back (phy);
+      ret.first->second.m_rxPhyIds.push_back (phyId);
 
       // and create the necessary converters for all the TX spectrum models that we know of
       for (TxSpectrumModelInfoMap_t::iterator txInfoIterator = m_txSpectrumModelInfoMap.begin ();
@@ -168,6 +207,59 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
     {
       // spectrum model is already known, just add the device to the corresponding list
       rxInfoIterator->second.m_rxPhys.push_back (phy);
+      rxInfoIterator->second.m_rxPhyIds.push_back (phyId);
+    }
+}
+
+void
+MultiModelSpectrumChannel::SetMaxRange (double maxRange)
+{
+  NS_LOG_FUNCTION (this << maxRange);
+  m_maxRange = maxRange;
+  if (maxRange > 0)
+    {
+      // The receivers in range are in the cell of the transmitter or in
+      // its neighbors.
+      m_grid.SetCellSize (maxRange);
+    }
+}
+
+double
+MultiModelSpectrumChannel::GetMaxRange (void) const
+{
+  return m_maxRange;
+}
+
+void
+MultiModelSpectrumChannel::MarkReceiversInRange (Ptr<MobilityModel> txMobility)
+{
+  NS_LOG_FUNCTION (this << txMobility);
+  // The mobility model of a phy may be set, or replaced, after the
+  // previous transmissions.  The phys without a mobility model are never
+  // skipped.
+  for (uint32_t id = 0; id < m_phys.size (); id++)
+    {
+      Ptr<MobilityModel> mobility = m_phys[id]->GetMobility ();
+      if (mobility == 0 || mobility == m_gridMobilities[id])
+        {
+          continue;
+        }
+      if (m_gridMobilities[id] == 0)
+        {
+          m_gridIndexes[id] = m_grid.Add (mobility);
+          m_gridPhyIds.push_back (id);
+        }
+      else
+        {
+          m_grid.Replace (m_gridIndexes[id], mobility);
+        }
+      m_gridMobilities[id] = mobility;
+    }
+  ++m_txCount;
+  std::vector<uint32_t> inRange = m_grid.GetInRange (txMobility->GetPosition (), m_maxRange);
+  for (std::vector<uint32_t>::const_iterator i = inRange.begin (); i != inRange.end (); ++i)
+    {
+      m_inRange[m_gridPhyIds[*i]] = m_txCount;
     }
 }
 
@@ -235,6 +327,13 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  bool cull = (m_maxRange > 0 && txMobility);
+  if (cull)
+    {
+      MarkReceiversInRange (txMobility);
+    }
+  double minRxPowerW = std::pow (10.0, (m_minRxPowerDbm - 30) / 10.0);
+
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -259,89 +358,114 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
             }
           convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
         }
+      // computed on the first receiver with a path loss
+      double convertedTxPowerW = -1;
 
-      for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhys.end ();
-           ++rxPhyIterator)
+      for (std::size_t i = 0; i < rxInfoIterator->second.m_rxPhys.size (); ++i)
         {
-          NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
+          Ptr<SpectrumPhy> rxPhy = rxInfoIterator->second.m_rxPhys[i];
+          NS_ASSERT_MSG (rxPhy->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
-          if ((*rxPhyIterator) != txParams->txPhy)
+          if (rxPhy == txParams->txPhy)
             {
-              NS_LOG_LOGIC ("copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
-
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+              continue;
+            }
+          Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility ();
+          if (cull && receiverMobility && m_inRange[rxInfoIterator->second.m_rxPhyIds[i]] != m_txCount)
+            {
+              NS_LOG_LOGIC ("receiver " << rxPhy << " beyond MaxRange");
+              continue;
+            }
 
-              if (txMobility && receiverMobility)
+          Time delay = MicroSeconds (0);
+          double pathGainLinear = 1;
+          bool scale = false;
+          if (txMobility && receiverMobility)
+            {
+              double txAntennaGain = 0;
+              double rxAntennaGain = 0;
+              double propagationGainDb = 0;
+              double pathLossDb = 0;
+              if (txParams->txAntenna != 0)
                 {
-                  double txAntennaGain = 0;
-                  double rxAntennaGain = 0;
-                  double propagationGainDb = 0;
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
+                  Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+                  txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+                  NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+                  pathLossDb -= txAntennaGain;
+                }
+              Ptr<AntennaModel> rxAntenna = rxPhy->GetRxAntenna ();
+              if (rxAntenna != 0)
+                {
+                  Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+                  rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+                  NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+                  pathLossDb -= rxAntennaGain;
+                }
+              if (m_propagationLoss)
+                {
+                  propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+                  NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+                  pathLossDb -= propagationGainDb;
+                }
+              NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+              // Gain trace
+              m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+              // Pathloss trace
+              m_pathLossTrace (txParams->txPhy, rxPhy, pathLossDb);
+              if (pathLossDb > m_maxLossDb)
+                {
+                  // beyond range
+                  continue;
+                }
+              pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+              if (minRxPowerW > 0)
+                {
+                  if (convertedTxPowerW < 0)
                     {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
+                      convertedTxPowerW = Integral (*convertedTxPowerSpectrum);
                     }
-                  if (m_propagationLoss)
+                  if (convertedTxPowerW * pathGainLinear < minRxPowerW)
                     {
-                      propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
-                  // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
-                  // Pathloss trace
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if (pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
+                      NS_LOG_LOGIC ("received power below MinRxPowerDbm");
                       continue;
                     }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
-
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
                 }
+              scale = true;
+            }
 
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
+          NS_LOG_LOGIC ("copying signal parameters " << txParams);
+          Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+          rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+          if (scale)
+            {
+              *(rxParams->psd) *= pathGainLinear;
+
+              if (m_spectrumPropagationLoss)
                 {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
                 }
-              else
+
+              if (m_propagationDelay)
                 {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
+                  delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
                 }
             }
+
+          Ptr<NetDevice> netDev = rxPhy->GetDevice ();
+          if (netDev)
+            {
+              // the receiver has a NetDevice, so we expect that it is attached to a Node
+              uint32_t dstNode =  netDev->GetNode ()->GetId ();
+              Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                              rxParams, rxPhy);
+            }
+          else
+            {
+              // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+              Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                                   rxParams, rxPhy);
+            }
         }
 
     }
@@ -27,6 +27,7 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/mobility-grid.h>
 #include <map>
 #include <set>
 
@@ -81,6 +82,7 @@ public:
 
   Ptr<const SpectrumModel> m_rxSpectrumModel;  //!< Rx Spectrum model.
   std::vector<Ptr<SpectrumPhy> > m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
+  std::vector<uint32_t> m_rxPhyIds;            //!< The channel ids of the Rx Spectrum phy objects.
 };
 
 /**
@@ -102,6 +104,19 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * StartTx computes the path loss to a receiver before copying the
+ * signal parameters and the PSD for it, so that the receivers dropped
+ * by the MaxLossDb and MinRxPowerDbm attributes cost no copy.
+ * MinRxPowerDbm is a threshold on the total power of the received PSD,
+ * before the SpectrumPropagationLossModel is applied.
+ *
+ * When the MaxRange attribute is set, the channel also keeps a grid of
+ * the positions of the receivers (see MobilityGrid), and StartTx skips
+ * the receivers further than MaxRange from the transmitter without
+ * computing their path loss, nor firing the gain and path loss traces
+ * for them.  The mobility models of the receivers are looked up on each
+ * transmission, so they can be set or replaced at any time.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -124,6 +139,16 @@ public:
   virtual std::size_t GetNDevices (void) const;
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \param maxRange the distance, in meters, beyond which receivers
+   *        are skipped, or 0 to consider all the receivers
+   */
+  void SetMaxRange (double maxRange);
+  /**
+   * \return the distance, in meters, beyond which receivers are skipped
+   */
+  double GetMaxRange (void) const;
+
 
 protected:
   void DoDispose ();
@@ -149,6 +174,14 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Put the mobility models set or replaced since the last transmission
+   * in the grid, and mark the receivers within MaxRange of a transmitter.
+   *
+   * \param txMobility the mobility model of the transmitter
+   */
+  void MarkReceiversInRange (Ptr<MobilityModel> txMobility);
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
@@ -169,6 +202,17 @@ private:
    */
   std::size_t m_numDevices;
 
+  std::map<Ptr<SpectrumPhy>, uint32_t> m_phyIds;  //!< The id of each phy ever added
+  std::vector<Ptr<SpectrumPhy> > m_phys;           //!< The phys, by id
+  double m_maxRange;                               //!< Range beyond which receivers are skipped (m)
+  double m_minRxPowerDbm;                          //!< Power below which receivers are skipped (dBm)
+  MobilityGrid m_grid;                             //!< The positions of the receivers, if MaxRange is set
+  std::vector<uint32_t> m_gridPhyIds;              //!< The id of the phy of each model in the grid
+  std::vector<Ptr<MobilityModel> > m_gridMobilities; //!< The model of each phy in the grid, if any
+  std::vector<uint32_t> m_gridIndexes;             //!< The index in the grid of each phy with a model
+  std::vector<uint64_t> m_inRange;                 //!< The last transmission each phy was in range of
+  uint64_t m_txCount;                              //!< The number of transmissions
+
 };
 
 
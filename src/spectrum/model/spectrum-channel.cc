@@ -76,6 +76,12 @@ SpectrumChannel::GetTypeId (void)
                    MakePointerAccessor (&SpectrumChannel::m_propagationLoss),
                    MakePointerChecker<PropagationLossModel> ())
 
+    .AddAttribute ("PropagationDelayModel",
+                   "A pointer to the propagation delay model attached to this channel.",
+                   PointerValue (0),
+                   MakePointerAccessor (&SpectrumChannel::m_propagationDelay),
+                   MakePointerChecker<PropagationDelayModel> ())
+
     .AddTraceSource ("Gain",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The parameters to this trace are : "
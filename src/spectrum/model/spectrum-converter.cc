@@ -82,21 +82,50 @@ SpectrumConverter::Convert (Ptr<const SpectrumValue> fvvf) const
 
   Ptr<SpectrumValue> tvvf = Create<SpectrumValue> (m_toSpectrumModel);
 
-  Values::iterator tvit = tvvf->ValuesBegin ();
-  size_t i = 0; // Index of conversion coefficient
+  // Only the bands which overlap the occupied range of fvvf are not zero
+  size_t fromStart = fvvf->GetOccupiedStart ();
+  size_t fromEnd = fvvf->GetOccupiedEnd ();
+  size_t toStart = m_conversionRowPtr.size ();
+  size_t toEnd = 0;
+  size_t rowStart = 0;
+  for (size_t row = 0; row < m_conversionRowPtr.size (); row++)
+    {
+      size_t rowEnd = m_conversionRowPtr[row];
+      if (rowStart < rowEnd
+          && m_conversionColInd[rowStart] < fromEnd
+          && m_conversionColInd[rowEnd - 1] >= fromStart)
+        {
+          toStart = std::min (toStart, row);
+          toEnd = row + 1;
+        }
+      rowStart = rowEnd;
+    }
+  if (toStart >= toEnd)
+    {
+      return tvvf;
+    }
+  tvvf->SetOccupiedRange (toStart, toEnd);
+
+  SpectrumValue::ConstValuesIterator from = fvvf->ConstValuesBegin ();
+  // The values of the occupied range of tvvf are contiguous, and remain
+  // shareable by its copies
+  double *to = tvvf->WriteValues (toStart, toEnd).data ();
+  size_t i = toStart > 0 ? m_conversionRowPtr[toStart - 1] : 0; // Index of conversion coefficient
 
-  for (std::vector<size_t>::const_iterator convIt = m_conversionRowPtr.begin ();
-       convIt != m_conversionRowPtr.end ();
-       ++convIt)
+  for (size_t row = toStart; row < toEnd; row++)
     {
       double sum = 0;
-      while (i < *convIt)
+      while (i < m_conversionRowPtr[row])
         {
-          sum += (*fvvf)[m_conversionColInd.at (i)] * m_conversionMatrix.at (i);
+          size_t col = m_conversionColInd[i];
+          // The values out of the occupied range of fvvf are zero
+          if (col >= fromStart && col < fromEnd)
+            {
+              sum += from[col] * m_conversionMatrix[i];
+            }
           i++;
         }
-      *tvit = sum;
-      ++tvit;
+      to[row - toStart] = sum;
     }
 
   return tvvf;
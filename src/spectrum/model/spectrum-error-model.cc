@@ -83,7 +83,7 @@ ShannonSpectrumErrorModel::EvaluateChunk (const SpectrumValue& sinr, Time durati
   double capacity = 0;
 
   Bands::const_iterator bi = CapacityPerHertz.ConstBandsBegin ();
-  Values::const_iterator vi = CapacityPerHertz.ConstValuesBegin ();
+  SpectrumValue::ConstValuesIterator vi = CapacityPerHertz.ConstValuesBegin ();
 
   while (bi != CapacityPerHertz.ConstBandsEnd ())
     {
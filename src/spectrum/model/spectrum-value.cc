@@ -22,32 +22,345 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
+#include <ns3/abort.h>
+#include <algorithm>
+#include <functional>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumValue");
 
+/// The values of a SpectrumValue without SpectrumModel
+static const Values g_noValues;
+
+/**
+ * Compute r[i] = op (a[i] * aGain, b[i] * bGain) for each element.
+ *
+ * The iterations are independent and only use an index, so that the
+ * compiler can vectorize the loop.  r may be a or b.
+ *
+ * \tparam Operation \deduced the type of the operation
+ * \param r the result
+ * \param a the first operand
+ * \param aGain the flat value by which a is multiplied
+ * \param b the second operand
+ * \param bGain the flat value by which b is multiplied
+ * \param n the number of elements
+ * \param op the operation
+ */
+template <class Operation>
+static void
+BinaryKernel (double *r, const double *a, double aGain, const double *b, double bGain, std::size_t n, Operation op)
+{
+  for (std::size_t i = 0; i < n; i++)
+    {
+      r[i] = op (a[i] * aGain, b[i] * bGain);
+    }
+}
+
+/**
+ * Compute r[i] = op (a[i] * aGain) for each element.
+ *
+ * \tparam Operation \deduced the type of the operation
+ * \param r the result, which may be a
+ * \param a the operand
+ * \param aGain the flat value by which a is multiplied
+ * \param n the number of elements
+ * \param op the operation
+ */
+template <class Operation>
+static void
+UnaryKernel (double *r, const double *a, double aGain, std::size_t n, Operation op)
+{
+  for (std::size_t i = 0; i < n; i++)
+    {
+      r[i] = op (a[i] * aGain);
+    }
+}
+
+/**
+ * \param x the first operand
+ * \param y the second operand
+ * \return the index of the first band of the union of the occupied
+ * ranges of the operands
+ */
+static uint32_t
+GetUnionStart (const SpectrumValue& x, const SpectrumValue& y)
+{
+  if (x.GetOccupiedStart () == x.GetOccupiedEnd ())
+    {
+      return y.GetOccupiedStart ();
+    }
+  if (y.GetOccupiedStart () == y.GetOccupiedEnd ())
+    {
+      return x.GetOccupiedStart ();
+    }
+  return std::min (x.GetOccupiedStart (), y.GetOccupiedStart ());
+}
+
+/**
+ * \param x the first operand
+ * \param y the second operand
+ * \return the index of the band following the union of the occupied
+ * ranges of the operands
+ */
+static uint32_t
+GetUnionEnd (const SpectrumValue& x, const SpectrumValue& y)
+{
+  if (x.GetOccupiedStart () == x.GetOccupiedEnd ())
+    {
+      return y.GetOccupiedEnd ();
+    }
+  if (y.GetOccupiedStart () == y.GetOccupiedEnd ())
+    {
+      return x.GetOccupiedEnd ();
+    }
+  return std::max (x.GetOccupiedEnd (), y.GetOccupiedEnd ());
+}
+
+SpectrumValue::SharedValues::SharedValues (const Values &values, uint32_t start)
+  : values (values),
+    start (start),
+    unshareable (false)
+{
+}
+
+SpectrumValue::ConstValuesIterator::ConstValuesIterator ()
+  : m_values (&g_noValues),
+    m_start (0),
+    m_gain (1),
+    m_index (0)
+{
+}
+
+SpectrumValue::ConstValuesIterator::ConstValuesIterator (const Values *values, uint32_t start, double gain, uint32_t index)
+  : m_values (values),
+    m_start (start),
+    m_gain (gain),
+    m_index (index)
+{
+}
+
 SpectrumValue::SpectrumValue ()
+  : m_gain (1)
 {
 }
 
 SpectrumValue::SpectrumValue (Ptr<const SpectrumModel> sof)
   : m_spectrumModel (sof),
-    m_values (sof->GetNumBands ())
+    m_gain (1)
+{
+  // No band is occupied
+}
+
+SpectrumValue::SpectrumValue (const SpectrumValue& o)
+  : SimpleRefCount<SpectrumValue> (o),
+    m_spectrumModel (o.m_spectrumModel),
+    m_values (o.ShareValues ()),
+    m_gain (o.m_gain)
+{
+}
+
+SpectrumValue&
+SpectrumValue::operator= (const SpectrumValue& o)
+{
+  if (this != &o)
+    {
+      m_spectrumModel = o.m_spectrumModel;
+      m_values = o.ShareValues ();
+      m_gain = o.m_gain;
+    }
+  return *this;
+}
+
+Ptr<SpectrumValue::SharedValues>
+SpectrumValue::ShareValues () const
+{
+  if (m_values && m_values->unshareable)
+    {
+      return Create<SharedValues> (m_values->values, m_values->start);
+    }
+  return m_values;
+}
+
+const Values &
+SpectrumValue::PeekValues (double &gain, uint32_t &start) const
 {
+  gain = m_gain;
+  start = GetOccupiedStart ();
+  return m_values ? m_values->values : g_noValues;
+}
 
+Values &
+SpectrumValue::WriteValues ()
+{
+  return WriteValues (0, GetValuesN ());
+}
+
+Values &
+SpectrumValue::WriteValues (uint32_t start, uint32_t end)
+{
+  StoreRange (start, end);
+  if (!m_values)
+    {
+      m_values = Create<SharedValues> (Values (), start);
+    }
+  else if (m_values->GetReferenceCount () > 1)
+    {
+      m_values = Create<SharedValues> (m_values->values, m_values->start);
+    }
+  return m_values->values;
+}
+
+void
+SpectrumValue::StoreRange (uint32_t start, uint32_t end)
+{
+  double gain;
+  uint32_t valuesStart;
+  const Values &values = PeekValues (gain, valuesStart);
+  uint32_t valuesEnd = valuesStart + values.size ();
+  if (start >= end)
+    {
+      m_values = 0;
+      m_gain = 1;
+      return;
+    }
+  if (start == valuesStart && end == valuesEnd && gain == 1)
+    {
+      return;
+    }
+  Ptr<SharedValues> result = GetResultValues (start, end);
+  uint32_t first = std::max (start, valuesStart);
+  uint32_t last = std::min (end, valuesEnd);
+  if (first < last)
+    {
+      UnaryKernel (result->values.data () + (first - start), values.data () + (first - valuesStart), gain,
+                   last - first, [] (double v) { return v; });
+    }
+  m_values = result;
+  m_gain = 1;
+}
+
+Ptr<SpectrumValue::SharedValues>
+SpectrumValue::GetResultValues (uint32_t start, uint32_t end) const
+{
+  if (m_values && m_values->GetReferenceCount () == 1
+      && m_values->start == start && m_values->values.size () == end - start)
+    {
+      return m_values;
+    }
+  return Create<SharedValues> (Values (end - start), start);
+}
+
+template <class Operation>
+void
+SpectrumValue::Apply (const SpectrumValue& x, uint32_t start, uint32_t end, Operation op)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  double gain;
+  uint32_t aStart;
+  const Values &a = PeekValues (gain, aStart);
+  uint32_t aEnd = aStart + a.size ();
+  double xGain;
+  uint32_t bStart;
+  const Values &b = x.PeekValues (xGain, bStart);
+  uint32_t bEnd = bStart + b.size ();
+  if (start >= end)
+    {
+      m_values = 0;
+      m_gain = 1;
+      return;
+    }
+  Ptr<SharedValues> result = GetResultValues (start, end);
+  double *r = result->values.data () - start;
+  // Split the range at the bounds of the occupied ranges of the operands,
+  // so that each part is computed by one loop
+  uint32_t i = start;
+  while (i < end)
+    {
+      uint32_t next = end;
+      for (uint32_t bound : {aStart, aEnd, bStart, bEnd})
+        {
+          if (bound > i && bound < next)
+            {
+              next = bound;
+            }
+        }
+      bool inA = i >= aStart && i < aEnd;
+      bool inB = i >= bStart && i < bEnd;
+      if (inA && inB)
+        {
+          BinaryKernel (r + i, a.data () + (i - aStart), gain, b.data () + (i - bStart), xGain, next - i, op);
+        }
+      else if (inA)
+        {
+          UnaryKernel (r + i, a.data () + (i - aStart), gain, next - i, [op] (double v) { return op (v, 0.0); });
+        }
+      else if (inB)
+        {
+          UnaryKernel (r + i, b.data () + (i - bStart), xGain, next - i, [op] (double w) { return op (0.0, w); });
+        }
+      else
+        {
+          std::fill (r + i, r + next, op (0.0, 0.0));
+        }
+      i = next;
+    }
+  m_values = result;
+  m_gain = 1;
+}
+
+template <class Operation>
+void
+SpectrumValue::Apply (Operation op)
+{
+  double gain;
+  uint32_t aStart;
+  const Values &a = PeekValues (gain, aStart);
+  uint32_t aEnd = aStart + a.size ();
+  double zero = op (0.0);
+  if (zero == 0)
+    {
+      if (aStart < aEnd)
+        {
+          Ptr<SharedValues> result = GetResultValues (aStart, aEnd);
+          UnaryKernel (result->values.data (), a.data (), gain, a.size (), op);
+          m_values = result;
+        }
+      m_gain = 1;
+      return;
+    }
+  // The bands out of the occupied range are not zero anymore
+  uint32_t end = GetValuesN ();
+  Ptr<SharedValues> result = GetResultValues (0, end);
+  double *r = result->values.data ();
+  std::fill (r, r + aStart, zero);
+  UnaryKernel (r + aStart, a.data (), gain, a.size (), op);
+  std::fill (r + aEnd, r + end, zero);
+  m_values = result;
+  m_gain = 1;
 }
 
 double&
 SpectrumValue::operator[] (size_t index)
 {
-  return m_values.at (index);
+  if (index < GetOccupiedStart () || index >= GetOccupiedEnd ())
+    {
+      // All the bands are stored, so that the range does not change
+      // when another band is accessed
+      Values &values = WriteValues ();
+      m_values->unshareable = true;
+      return values.at (index);
+    }
+  Values &values = WriteValues (GetOccupiedStart (), GetOccupiedEnd ());
+  m_values->unshareable = true;
+  return values[index - m_values->start];
 }
 
-const double&
+double
 SpectrumValue::operator[] (size_t index) const
 {
-  return m_values.at (index);
+  return ValuesAt (index);
 }
 
 
@@ -65,29 +378,39 @@ SpectrumValue::GetSpectrumModel () const
 }
 
 
-Values::const_iterator
+SpectrumValue::ConstValuesIterator
 SpectrumValue::ConstValuesBegin () const
 {
-  return m_values.begin ();
+  double gain;
+  uint32_t start;
+  const Values &values = PeekValues (gain, start);
+  return ConstValuesIterator (&values, start, gain, 0);
 }
 
-Values::const_iterator
+SpectrumValue::ConstValuesIterator
 SpectrumValue::ConstValuesEnd () const
 {
-  return m_values.end ();
+  double gain;
+  uint32_t start;
+  const Values &values = PeekValues (gain, start);
+  return ConstValuesIterator (&values, start, gain, GetValuesN ());
 }
 
 
 Values::iterator
 SpectrumValue::ValuesBegin ()
 {
-  return m_values.begin ();
+  Values &values = WriteValues ();
+  m_values->unshareable = true;
+  return values.begin ();
 }
 
 Values::iterator
 SpectrumValue::ValuesEnd ()
 {
-  return m_values.end ();
+  Values &values = WriteValues ();
+  m_values->unshareable = true;
+  return values.end ();
 }
 
 Bands::const_iterator
@@ -106,31 +429,14 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
-  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 += *it2;
-      ++it1;
-      ++it2;
-    }
+  Apply (x, GetUnionStart (*this, x), GetUnionEnd (*this, x), std::plus<double> ());
 }
 
 
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 += s;
-      ++it1;
-    }
+  Apply ([s] (double v) { return v + s; });
 }
 
 
@@ -138,18 +444,7 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
-  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
-    }
+  Apply (x, GetUnionStart (*this, x), GetUnionEnd (*this, x), std::minus<double> ());
 }
 
 
@@ -164,31 +459,22 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
-  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
-    }
+  Apply (x, std::max (GetOccupiedStart (), x.GetOccupiedStart ()),
+         std::min (GetOccupiedEnd (), x.GetOccupiedEnd ()), std::multiplies<double> ());
 }
 
 
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
+  if (m_values && m_values->unshareable)
     {
-      *it1 *= s;
-      ++it1;
+      // The values may be accessed through an iterator or a reference
+      Apply ([s] (double v) { return v * s; });
+      return;
     }
+  // Applied when the values are modified
+  m_gain *= s;
 }
 
 
@@ -197,18 +483,7 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
-  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
-    }
+  Apply (x, GetOccupiedStart (), GetOccupiedEnd (), std::divides<double> ());
 }
 
 
@@ -216,13 +491,7 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 /= s;
-      ++it1;
-    }
+  Apply ([s] (double v) { return v / s; });
 }
 
 
@@ -231,28 +500,23 @@ SpectrumValue::Divide (double s)
 void
 SpectrumValue::ChangeSign ()
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = -(*it1);
-      ++it1;
-    }
+  Apply (std::negate<double> ());
 }
 
 
 void
 SpectrumValue::ShiftLeft (int n)
 {
+  Values &values = WriteValues ();
   int i = 0;
-  while (i < (int) m_values.size () - n)
+  while (i < (int) values.size () - n)
     {
-      m_values.at (i) = m_values.at (i + n);
+      values.at (i) = values.at (i + n);
       i++;
     }
-  while (i < (int)m_values.size ())
+  while (i < (int)values.size ())
     {
-      m_values.at (i) = 0;
+      values.at (i) = 0;
       i++;
     }
 }
@@ -261,15 +525,16 @@ SpectrumValue::ShiftLeft (int n)
 void
 SpectrumValue::ShiftRight (int n)
 {
-  int i = m_values.size () - 1;
+  Values &values = WriteValues ();
+  int i = values.size () - 1;
   while (i - n >= 0)
     {
-      m_values.at (i) = m_values.at (i - n);
+      values.at (i) = values.at (i - n);
       i = i - 1;
     }
   while (i >= 0)
     {
-      m_values.at (i) = 0;
+      values.at (i) = 0;
       --i;
     }
 }
@@ -280,13 +545,7 @@ void
 SpectrumValue::Pow (double exp)
 {
   NS_LOG_FUNCTION (this << exp);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = std::pow (*it1, exp);
-      ++it1;
-    }
+  Apply ([exp] (double v) { return std::pow (v, exp); });
 }
 
 
@@ -294,13 +553,7 @@ void
 SpectrumValue::Exp (double base)
 {
   NS_LOG_FUNCTION (this << base);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = std::pow (base, *it1);
-      ++it1;
-    }
+  Apply ([base] (double v) { return std::pow (base, v); });
 }
 
 
@@ -308,26 +561,14 @@ void
 SpectrumValue::Log10 ()
 {
   NS_LOG_FUNCTION (this);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = std::log10 (*it1);
-      ++it1;
-    }
+  Apply ([] (double v) { return std::log10 (v); });
 }
 
 void
 SpectrumValue::Log2 ()
 {
   NS_LOG_FUNCTION (this);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = log2 (*it1);
-      ++it1;
-    }
+  Apply ([] (double v) { return log2 (v); });
 }
 
 
@@ -335,23 +576,21 @@ void
 SpectrumValue::Log ()
 {
   NS_LOG_FUNCTION (this);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = std::log (*it1);
-      ++it1;
-    }
+  Apply ([] (double v) { return std::log (v); });
 }
 
 double
 Norm (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  double gain;
+  uint32_t start;
+  const Values &values = x.PeekValues (gain, start);
+  Values::const_iterator it1 = values.begin ();
+  while (it1 != values.end ())
     {
-      s += (*it1) * (*it1);
+      double v = (*it1) * gain;
+      s += v * v;
       ++it1;
     }
   return std::sqrt (s);
@@ -362,10 +601,13 @@ double
 Sum (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
+  double gain;
+  uint32_t start;
+  const Values &values = x.PeekValues (gain, start);
+  Values::const_iterator it1 = values.begin ();
+  while (it1 != values.end ())
     {
-      s += (*it1);
+      s += (*it1) * gain;
       ++it1;
     }
   return s;
@@ -377,7 +619,7 @@ double
 Prod (const SpectrumValue& x)
 {
   double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
+  SpectrumValue::ConstValuesIterator it1 = x.ConstValuesBegin ();
   while (it1 != x.ConstValuesEnd ())
     {
       s *= (*it1);
@@ -390,16 +632,44 @@ double
 Integral (const SpectrumValue& arg)
 {
   double i = 0;
-  Values::const_iterator vit = arg.ConstValuesBegin ();
-  Bands::const_iterator bit = arg.ConstBandsBegin ();
-  while (vit != arg.ConstValuesEnd ())
+  double gain;
+  uint32_t start;
+  const Values &values = arg.PeekValues (gain, start);
+  NS_ASSERT (start + values.size () <= arg.GetValuesN ());
+  Values::const_iterator vit = values.begin ();
+  // The other bands are zero
+  Bands::const_iterator bit = arg.ConstBandsBegin () + start;
+  while (vit != values.end ())
     {
-      NS_ASSERT (bit != arg.ConstBandsEnd ());
-      i += (*vit) * (bit->fh - bit->fl);
+      i += ((*vit) * gain) * (bit->fh - bit->fl);
       ++vit;
       ++bit;
     }
-  NS_ASSERT (bit == arg.ConstBandsEnd ());
+  return i;
+}
+
+double
+IntegralOfProduct (const SpectrumValue& lhs, const SpectrumValue& rhs)
+{
+  NS_ASSERT (lhs.m_spectrumModel == rhs.m_spectrumModel);
+  double i = 0;
+  double lhsGain;
+  uint32_t lhsStart;
+  const Values &lhsValues = lhs.PeekValues (lhsGain, lhsStart);
+  double rhsGain;
+  uint32_t rhsStart;
+  const Values &rhsValues = rhs.PeekValues (rhsGain, rhsStart);
+  // The product is zero out of the intersection of the occupied ranges
+  uint32_t start = std::max (lhsStart, rhsStart);
+  uint32_t end = std::min<uint32_t> (lhsStart + lhsValues.size (), rhsStart + rhsValues.size ());
+  NS_ASSERT (start >= end || end <= lhs.GetValuesN ());
+  Bands::const_iterator bit = lhs.ConstBandsBegin () + start;
+  // Same operations as Integral (lhs * rhs), so that the result is the same
+  for (uint32_t j = start; j < end; j++)
+    {
+      i += ((lhsValues[j - lhsStart] * lhsGain) * (rhsValues[j - rhsStart] * rhsGain)) * (bit->fh - bit->fl);
+      ++bit;
+    }
   return i;
 }
 
@@ -408,11 +678,8 @@ Integral (const SpectrumValue& arg)
 Ptr<SpectrumValue>
 SpectrumValue::Copy () const
 {
-  Ptr<SpectrumValue> p = Create<SpectrumValue> (m_spectrumModel);
-  *p = *this;
-  return p;
-
-  //  return Copy<SpectrumValue> (*this)
+  // The copy shares the values until one of them is modified
+  return Create<SpectrumValue> (*this);
 }
 
 
@@ -425,7 +692,7 @@ SpectrumValue::Copy () const
 std::ostream&
 operator << (std::ostream& os, const SpectrumValue& pvf)
 {
-  Values::const_iterator it1 = pvf.ConstValuesBegin ();
+  SpectrumValue::ConstValuesIterator it1 = pvf.ConstValuesBegin ();
   while (it1 != pvf.ConstValuesEnd ())
     {
       os << *it1 << " ";
@@ -467,9 +734,8 @@ operator+ (double lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  res.Add (lhs);
+  SpectrumValue res = lhs;
+  res.Subtract (rhs);
   return res;
 }
 
@@ -664,13 +930,59 @@ SpectrumValue::operator/= (double rhs)
 SpectrumValue&
 SpectrumValue::operator= (double rhs)
 {
-  Values::iterator it1 = m_values.begin ();
+  // The current values are not read
+  if (rhs == 0)
+    {
+      m_values = 0;
+    }
+  else
+    {
+      m_values = GetResultValues (0, GetValuesN ());
+      std::fill (m_values->values.begin (), m_values->values.end (), rhs);
+    }
+  m_gain = 1;
+  return *this;
+}
 
-  while (it1 != m_values.end ())
+SpectrumValue&
+SpectrumValue::AddProduct (const SpectrumValue& x, const SpectrumValue& y)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_spectrumModel == y.m_spectrumModel);
+  // The product is zero out of the intersection of the occupied ranges
+  uint32_t productStart = std::max (x.GetOccupiedStart (), y.GetOccupiedStart ());
+  uint32_t productEnd = std::min (x.GetOccupiedEnd (), y.GetOccupiedEnd ());
+  if (productStart >= productEnd)
     {
-      *it1 = rhs;
-      ++it1;
+      return *this;
     }
+  uint32_t start = productStart;
+  uint32_t end = productEnd;
+  if (GetOccupiedStart () < GetOccupiedEnd ())
+    {
+      start = std::min (start, GetOccupiedStart ());
+      end = std::max (end, GetOccupiedEnd ());
+    }
+  // x or y may be *this: they are read once the gain is applied
+  double *r = WriteValues (start, end).data () + (productStart - start);
+  double xGain;
+  uint32_t xStart;
+  const double *b = x.PeekValues (xGain, xStart).data () + (productStart - xStart);
+  double yGain;
+  uint32_t yStart;
+  const double *c = y.PeekValues (yGain, yStart).data () + (productStart - yStart);
+  for (std::size_t i = 0; i < productEnd - productStart; i++)
+    {
+      r[i] = r[i] + (b[i] * xGain) * (c[i] * yGain);
+    }
+  return *this;
+}
+
+SpectrumValue&
+SpectrumValue::AddScaled (const SpectrumValue& x, double s)
+{
+  Apply (x, GetUnionStart (*this, x), GetUnionEnd (*this, x),
+         [s] (double v, double w) { return v + w * s; });
   return *this;
 }
 
@@ -695,13 +1007,34 @@ SpectrumValue::operator>> (int n) const
 uint32_t
 SpectrumValue::GetValuesN () const
 {
-  return m_values.size ();
+  return m_spectrumModel ? m_spectrumModel->GetNumBands () : 0;
 }
 
-const double &
+double
 SpectrumValue::ValuesAt (uint32_t pos) const
 {
-  return m_values.at (pos);
+  NS_ABORT_MSG_IF (pos >= GetValuesN (), "No band " << pos);
+  return ConstValuesBegin ()[pos];
+}
+
+uint32_t
+SpectrumValue::GetOccupiedStart () const
+{
+  return m_values ? m_values->start : 0;
+}
+
+uint32_t
+SpectrumValue::GetOccupiedEnd () const
+{
+  return m_values ? m_values->start + m_values->values.size () : 0;
+}
+
+void
+SpectrumValue::SetOccupiedRange (uint32_t start, uint32_t end)
+{
+  NS_LOG_FUNCTION (this << start << end);
+  NS_ASSERT (start <= end && end <= GetValuesN ());
+  StoreRange (start, end);
 }
 
 } // namespace ns3
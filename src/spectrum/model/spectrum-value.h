@@ -24,6 +24,7 @@
 #include <ns3/ptr.h>
 #include <ns3/simple-ref-count.h>
 #include <ns3/spectrum-model.h>
+#include <iterator>
 #include <ostream>
 #include <vector>
 
@@ -54,6 +55,44 @@ typedef std::vector<double> Values;
  * The intended use of this class is to represent frequency-dependent
  * things, such as power spectral densities, frequency-dependent
  * propagation losses, spectral masks, etc.
+ *
+ * The copies of a SpectrumValue share its values until one of them is
+ * modified, and the multiplication by a flat value is only applied to
+ * the values when they are modified, the successive flat values being
+ * combined, so that the copies of a transmitted PSD scaled by a path
+ * gain cost no allocation until a receiver needs the values of each
+ * frequency.  The const accessors, Integral(), Sum(), Norm() and the
+ * operators taking a SpectrumValue operand read the scaled values
+ * without storing them, and thus never modify a SpectrumValue.  Once
+ * ValuesBegin(), ValuesEnd() or the non-const operator[] has given
+ * access to the values, they are not shared anymore: the later copies
+ * of the SpectrumValue copy them, and the later multiplications by a
+ * flat value are applied to them at once.
+ *
+ * The operators compute their result in a single pass over contiguous
+ * arrays, writing in place when the values are not shared, with loops
+ * which the compiler can vectorize (e.g. with SSE or AVX2 in the
+ * optimized build profile, which uses -march=native).  Each element
+ * goes through the same operations whatever the vector width, so the
+ * results do not depend on the instruction set.  AddProduct() and
+ * AddScaled() fuse a product and an accumulation without creating a
+ * temporary SpectrumValue.
+ *
+ * Only the values of an occupied range of bands are stored, the values
+ * of the other bands being zero.  A SpectrumValue created from a
+ * SpectrumModel has no occupied band, SpectrumConverter::Convert()
+ * only stores the bands which overlap the converted values, and
+ * SetOccupiedRange() restricts a band-limited SpectrumValue to its
+ * bands.  The operators compute the values of the occupied range of
+ * their result only: the union of the ranges of the operands for the
+ * addition and the subtraction, their intersection for the
+ * multiplication, and the range of the dividend for the division, the
+ * values being assumed to be finite.  An operation which gives a
+ * non-zero value from zero, such as the addition of a flat value, the
+ * exponential or the logarithm, stores all the bands, as do the
+ * iterators and the access to a band out of the occupied range by the
+ * non-const operator[], which may thus invalidate the references to
+ * the other values.
  */
 class SpectrumValue : public SimpleRefCount<SpectrumValue>
 {
@@ -80,6 +119,137 @@ public:
 
   SpectrumValue ();
 
+  /**
+   * Copy constructor: the copy shares the values unless they may be
+   * modified through an iterator or a reference.
+   *
+   * @param o the SpectrumValue to copy
+   */
+  SpectrumValue (const SpectrumValue& o);
+
+  /**
+   * Copy assignment operator: *this shares the values of o unless
+   * they may be modified through an iterator or a reference.
+   *
+   * @param o the SpectrumValue to copy
+   * @return a reference to *this
+   */
+  SpectrumValue& operator= (const SpectrumValue& o);
+
+  /**
+   * \brief A random access iterator over the values of all the bands
+   *
+   * Each value is computed from the stored values and the pending flat
+   * value by which they are multiplied, so that reading the values
+   * does not modify the SpectrumValue.  The iterator is invalidated
+   * by the modifications of the SpectrumValue.
+   */
+  class ConstValuesIterator
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category; //!< The category of the iterator
+    typedef double value_type;                                 //!< The type of the values
+    typedef std::ptrdiff_t difference_type;                    //!< The type of the distances
+    typedef const double* pointer;                             //!< The type of the pointers to the values
+    typedef double reference;                                  //!< The type returned by operator*
+
+    ConstValuesIterator ();
+    /**
+     * \param values the stored values
+     * \param start the index of the band of the first stored value
+     * \param gain the flat value by which the stored values are multiplied
+     * \param index the index of the band
+     */
+    ConstValuesIterator (const Values *values, uint32_t start, double gain, uint32_t index);
+
+    /**
+     * \return the value of the band
+     */
+    double operator* () const;
+    /**
+     * \param n the offset of the band
+     * \return the value of the band
+     */
+    double operator[] (difference_type n) const;
+    /**
+     * \return the iterator on the next band
+     */
+    ConstValuesIterator& operator++ ();
+    /**
+     * \return the iterator on the current band
+     */
+    ConstValuesIterator operator++ (int);
+    /**
+     * \return the iterator on the previous band
+     */
+    ConstValuesIterator& operator-- ();
+    /**
+     * \return the iterator on the current band
+     */
+    ConstValuesIterator operator-- (int);
+    /**
+     * \param n the offset
+     * \return the iterator on the band n bands further
+     */
+    ConstValuesIterator& operator+= (difference_type n);
+    /**
+     * \param n the offset
+     * \return the iterator on the band n bands before
+     */
+    ConstValuesIterator& operator-= (difference_type n);
+    /**
+     * \param n the offset
+     * \return an iterator on the band n bands further
+     */
+    ConstValuesIterator operator+ (difference_type n) const;
+    /**
+     * \param n the offset
+     * \return an iterator on the band n bands before
+     */
+    ConstValuesIterator operator- (difference_type n) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return the number of bands from o to this iterator
+     */
+    difference_type operator- (const ConstValuesIterator& o) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return true if both iterators are on the same band
+     */
+    bool operator== (const ConstValuesIterator& o) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return true if the iterators are on different bands
+     */
+    bool operator!= (const ConstValuesIterator& o) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return true if this iterator is before o
+     */
+    bool operator< (const ConstValuesIterator& o) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return true if this iterator is after o
+     */
+    bool operator> (const ConstValuesIterator& o) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return true if this iterator is not after o
+     */
+    bool operator<= (const ConstValuesIterator& o) const;
+    /**
+     * \param o another iterator on the same SpectrumValue
+     * \return true if this iterator is not before o
+     */
+    bool operator>= (const ConstValuesIterator& o) const;
+
+  private:
+    const Values *m_values; //!< The stored values
+    uint32_t m_start;       //!< The index of the band of the first stored value
+    double m_gain;          //!< The flat value by which the stored values are multiplied
+    uint32_t m_index;       //!< The index of the band
+  };
+
 
   /**
    * Access value at given frequency index
@@ -95,9 +265,9 @@ public:
    *
    * @param index the given frequency index
    *
-   * @return const reference to the value
+   * @return the value
    */
-  const double& operator[] (size_t index) const;
+  double operator[] (size_t index) const;
 
 
   /**
@@ -132,26 +302,26 @@ public:
   /**
    *
    *
-   * @return a const iterator pointing to the beginning of the embedded Values
+   * @return a const iterator pointing to the beginning of the values
    */
-  Values::const_iterator ConstValuesBegin () const;
+  ConstValuesIterator ConstValuesBegin () const;
 
   /**
    *
    *
-   * @return a const iterator pointing to the end of the embedded Values
+   * @return a const iterator pointing to the end of the values
    */
-  Values::const_iterator ConstValuesEnd () const;
+  ConstValuesIterator ConstValuesEnd () const;
 
   /**
-   *
+   * The values are not shared anymore once this method is called.
    *
    * @return an iterator pointing to the beginning of the embedded Values
    */
   Values::iterator ValuesBegin ();
 
   /**
-   *
+   * The values are not shared anymore once this method is called.
    *
    * @return an iterator pointing to the end of the embedded Values
    */
@@ -168,7 +338,28 @@ public:
    * \param pos position
    * \return the value element in that position (with bounds checking)
    */
-  const double & ValuesAt (uint32_t pos) const;
+  double ValuesAt (uint32_t pos) const;
+
+  /**
+   * \brief Get the first band whose value is stored
+   * \return the index of the first band of the occupied range
+   */
+  uint32_t GetOccupiedStart () const;
+
+  /**
+   * \brief Get the band after the last one whose value is stored
+   * \return the index of the band following the occupied range, which
+   * is equal to GetOccupiedStart () if no band is occupied
+   */
+  uint32_t GetOccupiedEnd () const;
+
+  /**
+   * \brief Set to zero the values of the bands out of a range, and
+   * only store the values of the range
+   * \param start the index of the first band of the range
+   * \param end the index of the band following the range
+   */
+  void SetOccupiedRange (uint32_t start, uint32_t end);
 
   /**
    *  addition operator
@@ -420,6 +611,30 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Add the product of two SpectrumValues to *this, component by
+   * component, without creating the product: same result as
+   * *this += x * y.
+   *
+   * @param x the first factor
+   * @param y the second factor
+   *
+   * @return  a reference to *this
+   */
+  SpectrumValue& AddProduct (const SpectrumValue& x, const SpectrumValue& y);
+
+  /**
+   * Add a SpectrumValue multiplied by a flat value to *this,
+   * component by component, without creating the scaled copy: same
+   * result as *this += x * s.
+   *
+   * @param x the SpectrumValue to scale
+   * @param s the flat value
+   *
+   * @return  a reference to *this
+   */
+  SpectrumValue& AddScaled (const SpectrumValue& x, double s);
+
 
 
   /**
@@ -508,6 +723,17 @@ public:
    */
   friend double Integral (const SpectrumValue&  arg);
 
+  /**
+   * Compute Integral (lhs * rhs) without creating the product, for
+   * example to find the power of a signal through a filter.
+   *
+   * @param lhs the first factor
+   * @param rhs the second factor
+   *
+   * @return the value of the integral \f$\int_F g(f) h(f) df  \f$
+   */
+  friend double IntegralOfProduct (const SpectrumValue& lhs, const SpectrumValue& rhs);
+
   /**
    *
    * @return a Ptr to a copy of this instance
@@ -526,6 +752,9 @@ public:
 
 
 private:
+  /// Writes the values of the converted SpectrumValues
+  friend class SpectrumConverter;
+
   /**
    * Add a SpectrumValue (element to element addition)
    * \param x SpectrumValue
@@ -604,6 +833,90 @@ private:
    */
   void Log ();
 
+  /**
+   * Values shared by the copies of a SpectrumValue.
+   */
+  class SharedValues : public SimpleRefCount<SharedValues>
+  {
+  public:
+    /**
+     * \param values the values
+     * \param start the index of the band of the first value
+     */
+    SharedValues (const Values &values, uint32_t start);
+
+    Values values;    //!< The values of the occupied range
+    uint32_t start;   //!< The index of the band of the first value
+    bool unshareable; //!< Whether the values may be modified through an iterator or a reference
+  };
+
+  /**
+   * \return the values to be used by a copy of *this: m_values, or a
+   * copy of them if they may be modified through an iterator or a
+   * reference
+   */
+  Ptr<SharedValues> ShareValues () const;
+
+  /**
+   * \param gain the flat value by which the values are to be multiplied
+   * \param start the index of the band of the first value
+   * \return the values of the occupied range, not multiplied by gain
+   */
+  const Values & PeekValues (double &gain, uint32_t &start) const;
+  /**
+   * \return the values of all the bands, to be modified
+   */
+  Values & WriteValues ();
+  /**
+   * \param start the index of the first band of the range
+   * \param end the index of the band following the range
+   * \return the values of the bands of the range, to be modified
+   */
+  Values & WriteValues (uint32_t start, uint32_t end);
+  /**
+   * Store the values of the bands of a range, multiplied by the
+   * pending gain, and discard the values of the other bands, which are
+   * zero.  The values are only shared if they are unchanged.
+   *
+   * \param start the index of the first band of the range
+   * \param end the index of the band following the range
+   */
+  void StoreRange (uint32_t start, uint32_t end);
+
+  /**
+   * Replace each element v of *this with op (v, w), w being the
+   * element of x of the same frequency, in one pass, and in place if
+   * the values are not shared.  The values out of the occupied ranges
+   * of the operands are zero, and the result is only computed for the
+   * bands of a range, the other bands being zero.
+   *
+   * \tparam Operation \deduced the type of the operation
+   * \param x the second operand
+   * \param start the index of the first band of the range of the result
+   * \param end the index of the band following the range of the result
+   * \param op the operation
+   */
+  template <class Operation>
+  void Apply (const SpectrumValue& x, uint32_t start, uint32_t end, Operation op);
+  /**
+   * Replace each element v of *this with op (v), in one pass, and in
+   * place if the values are not shared.  All the bands are stored if
+   * op (0) is not zero.
+   *
+   * \tparam Operation \deduced the type of the operation
+   * \param op the operation
+   */
+  template <class Operation>
+  void Apply (Operation op);
+  /**
+   * \param start the index of the first band of the range
+   * \param end the index of the band following the range
+   * \return room for the values of a range, computed by an operation
+   * which reads the current values: the values themselves if they are
+   * stored for the same range and are not shared, new values otherwise.
+   */
+  Ptr<SharedValues> GetResultValues (uint32_t start, uint32_t end) const;
+
   Ptr<const SpectrumModel> m_spectrumModel; //!< The spectrum model
 
 
@@ -613,12 +926,136 @@ private:
    * on what these values represent (a transmission power density, a
    * propagation loss, etc.).
    *
+   * The values are shared with the copies of this SpectrumValue until
+   * one of them is modified.  They are only stored for the occupied
+   * range of bands, and not at all if no band is occupied.
+   */
+  Ptr<SharedValues> m_values;
+  /**
+   * The flat value by which the values are to be multiplied, when
+   * they are accessed.
    */
-  Values m_values;
+  double m_gain;
 
 
 };
 
+inline double
+SpectrumValue::ConstValuesIterator::operator* () const
+{
+  // The bands out of the stored range are zero
+  uint32_t i = m_index - m_start;
+  return (m_index >= m_start && i < m_values->size ()) ? (*m_values)[i] * m_gain : 0;
+}
+
+inline double
+SpectrumValue::ConstValuesIterator::operator[] (difference_type n) const
+{
+  return *(*this + n);
+}
+
+inline SpectrumValue::ConstValuesIterator&
+SpectrumValue::ConstValuesIterator::operator++ ()
+{
+  m_index++;
+  return *this;
+}
+
+inline SpectrumValue::ConstValuesIterator
+SpectrumValue::ConstValuesIterator::operator++ (int)
+{
+  ConstValuesIterator it = *this;
+  m_index++;
+  return it;
+}
+
+inline SpectrumValue::ConstValuesIterator&
+SpectrumValue::ConstValuesIterator::operator-- ()
+{
+  m_index--;
+  return *this;
+}
+
+inline SpectrumValue::ConstValuesIterator
+SpectrumValue::ConstValuesIterator::operator-- (int)
+{
+  ConstValuesIterator it = *this;
+  m_index--;
+  return it;
+}
+
+inline SpectrumValue::ConstValuesIterator&
+SpectrumValue::ConstValuesIterator::operator+= (difference_type n)
+{
+  m_index += n;
+  return *this;
+}
+
+inline SpectrumValue::ConstValuesIterator&
+SpectrumValue::ConstValuesIterator::operator-= (difference_type n)
+{
+  m_index -= n;
+  return *this;
+}
+
+inline SpectrumValue::ConstValuesIterator
+SpectrumValue::ConstValuesIterator::operator+ (difference_type n) const
+{
+  ConstValuesIterator it = *this;
+  it += n;
+  return it;
+}
+
+inline SpectrumValue::ConstValuesIterator
+SpectrumValue::ConstValuesIterator::operator- (difference_type n) const
+{
+  ConstValuesIterator it = *this;
+  it -= n;
+  return it;
+}
+
+inline SpectrumValue::ConstValuesIterator::difference_type
+SpectrumValue::ConstValuesIterator::operator- (const ConstValuesIterator& o) const
+{
+  return static_cast<difference_type> (m_index) - static_cast<difference_type> (o.m_index);
+}
+
+inline bool
+SpectrumValue::ConstValuesIterator::operator== (const ConstValuesIterator& o) const
+{
+  return m_index == o.m_index;
+}
+
+inline bool
+SpectrumValue::ConstValuesIterator::operator!= (const ConstValuesIterator& o) const
+{
+  return m_index != o.m_index;
+}
+
+inline bool
+SpectrumValue::ConstValuesIterator::operator< (const ConstValuesIterator& o) const
+{
+  return m_index < o.m_index;
+}
+
+inline bool
+SpectrumValue::ConstValuesIterator::operator> (const ConstValuesIterator& o) const
+{
+  return m_index > o.m_index;
+}
+
+inline bool
+SpectrumValue::ConstValuesIterator::operator<= (const ConstValuesIterator& o) const
+{
+  return m_index <= o.m_index;
+}
+
+inline bool
+SpectrumValue::ConstValuesIterator::operator>= (const ConstValuesIterator& o) const
+{
+  return m_index >= o.m_index;
+}
+
 std::ostream& operator << (std::ostream& os, const SpectrumValue& pvf);
 
 double Norm (const SpectrumValue& x);
@@ -630,6 +1067,7 @@ SpectrumValue Log10 (const SpectrumValue& arg);
 SpectrumValue Log2 (const SpectrumValue& arg);
 SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
+double IntegralOfProduct (const SpectrumValue& lhs, const SpectrumValue& rhs);
 
 
 } // namespace ns3
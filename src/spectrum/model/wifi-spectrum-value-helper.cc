@@ -81,6 +81,7 @@ operator < (const WifiSpectrumModelId& a, const WifiSpectrumModelId& b)
 }
 
 static std::map<WifiSpectrumModelId, Ptr<SpectrumModel> > g_wifiSpectrumModelMap; ///< static initializer for the class
+static std::map<WifiSpectrumModelId, Ptr<const SpectrumValue> > g_wifiRfFilterMap; ///< RF filters, shared by the returned copies
 
 Ptr<SpectrumModel>
 WifiSpectrumValueHelper::GetSpectrumModel (uint32_t centerFrequency, uint16_t channelWidth, double bandBandwidth, uint16_t guardBandwidth)
@@ -452,6 +453,13 @@ Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateRfFilter (uint32_t centerFrequency, uint16_t channelWidth, double bandGranularity, uint16_t guardBandwidth)
 {
   NS_LOG_FUNCTION (centerFrequency << channelWidth << bandGranularity << guardBandwidth);
+  WifiSpectrumModelId key (centerFrequency, channelWidth, bandGranularity, guardBandwidth);
+  std::map<WifiSpectrumModelId, Ptr<const SpectrumValue> >::const_iterator it = g_wifiRfFilterMap.find (key);
+  if (it != g_wifiRfFilterMap.end ())
+    {
+      // The copy shares the values of the filter until it is modified
+      return Create<SpectrumValue> (*it->second);
+    }
   Ptr<SpectrumValue> c = Create <SpectrumValue> (GetSpectrumModel (centerFrequency, channelWidth, bandGranularity, guardBandwidth));
   size_t numBands = c->GetSpectrumModel ()->GetNumBands ();
   Bands::const_iterator bit = c->ConstBandsBegin ();
@@ -473,6 +481,7 @@ WifiSpectrumValueHelper::CreateRfFilter (uint32_t centerFrequency, uint16_t chan
       *vit = 1;
     }
   NS_LOG_LOGIC ("Added subbands " << startIndex << " to " << startIndex + numBandsInFilter << " to filter");
+  g_wifiRfFilterMap.insert (std::make_pair (key, Create<const SpectrumValue> (*c)));
   return c;
 }
 
@@ -135,7 +135,9 @@ public:
   static Ptr<SpectrumValue> CreateNoisePowerSpectralDensity (double noiseFigure, Ptr<SpectrumModel> spectrumModel);
 
   /**
-   * Create a spectral density corresponding to the RF filter
+   * Create a spectral density corresponding to the RF filter.  The filters
+   * are kept, and the returned value shares the values of the filter with
+   * the same parameters until it is modified.
    *
    * \param centerFrequency center frequency (MHz)
    * \param channelWidth channel width (MHz)
@@ -0,0 +1,353 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * A reception recorded by CullingTestPhy.
+ */
+struct CullingTestReception
+{
+  Ptr<const SpectrumPhy> txPhy;  //!< The transmitter
+  uint32_t tx;                   //!< The index of the transmitter
+  Time time;                     //!< The time of the reception
+  double distance;               //!< The distance to the transmitter (m)
+  std::vector<double> psd;       //!< The received PSD
+};
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * A SpectrumPhy recording its receptions.
+ */
+class CullingTestPhy : public SpectrumPhy
+{
+public:
+  /**
+   * \param rxSpectrumModel the spectrum model of the receptions
+   */
+  CullingTestPhy (Ptr<const SpectrumModel> rxSpectrumModel);
+
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice () const;
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility ();
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna ();
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+
+  std::vector<CullingTestReception> m_receptions; //!< The receptions
+
+private:
+  virtual void DoDispose (void);
+
+  Ptr<const SpectrumModel> m_rxSpectrumModel; //!< The spectrum model of the receptions
+  Ptr<MobilityModel> m_mobility;              //!< The mobility model
+};
+
+CullingTestPhy::CullingTestPhy (Ptr<const SpectrumModel> rxSpectrumModel)
+  : m_rxSpectrumModel (rxSpectrumModel)
+{
+}
+
+void
+CullingTestPhy::DoDispose (void)
+{
+  m_mobility = 0;
+  SpectrumPhy::DoDispose ();
+}
+
+void
+CullingTestPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+CullingTestPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+CullingTestPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+CullingTestPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+CullingTestPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+CullingTestPhy::GetRxSpectrumModel () const
+{
+  return m_rxSpectrumModel;
+}
+
+Ptr<AntennaModel>
+CullingTestPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+CullingTestPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  CullingTestReception reception;
+  reception.txPhy = params->txPhy;
+  reception.tx = 0;
+  reception.time = Simulator::Now ();
+  // The phys without a mobility model receive everything
+  reception.distance = m_mobility ? m_mobility->GetDistanceFrom (params->txPhy->GetMobility ()) : 0;
+  for (SpectrumValue::ConstValuesIterator i = params->psd->ConstValuesBegin (); i != params->psd->ConstValuesEnd (); ++i)
+    {
+      reception.psd.push_back (*i);
+    }
+  m_receptions.push_back (reception);
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Check that the MaxRange and MinRxPowerDbm attributes of
+ * MultiModelSpectrumChannel only remove the receptions beyond the range
+ * or below the power threshold: the other receptions must be identical,
+ * and in the same order, as without them.  The receivers use two
+ * spectrum models, one of them converted, and two of them move.  One
+ * receiver gets its mobility model after the first transmissions, and
+ * another one has its mobility model replaced.
+ */
+class SpectrumChannelCullingTestCase : public TestCase
+{
+public:
+  SpectrumChannelCullingTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the scenario.
+   *
+   * \param maxRange the MaxRange attribute of the channel
+   * \param minRxPowerDbm the MinRxPowerDbm attribute of the channel
+   * \return the receptions of each phy
+   */
+  std::vector<std::vector<CullingTestReception> > Run (double maxRange, double minRxPowerDbm);
+};
+
+SpectrumChannelCullingTestCase::SpectrumChannelCullingTestCase ()
+  : TestCase ("Check the receptions skipped by MaxRange and MinRxPowerDbm")
+{
+}
+
+std::vector<std::vector<CullingTestReception> >
+SpectrumChannelCullingTestCase::Run (double maxRange, double minRxPowerDbm)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      freqs.push_back (2400e6 + i * 1e6);
+    }
+  Ptr<SpectrumModel> modelA = Create<SpectrumModel> (freqs);
+  for (uint32_t i = 0; i < freqs.size (); i++)
+    {
+      freqs[i] += 0.5e6;
+    }
+  Ptr<SpectrumModel> modelB = Create<SpectrumModel> (freqs);
+
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->SetAttribute ("MinRxPowerDbm", DoubleValue (minRxPowerDbm));
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  // An 8 x 5 grid of phys, 25 m apart, alternating between the two
+  // spectrum models
+  std::vector<Ptr<CullingTestPhy> > phys;
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      Ptr<CullingTestPhy> phy = CreateObject<CullingTestPhy> (i % 2 ? modelB : modelA);
+      Vector position (25.0 * (i % 8), 25.0 * (i / 8), 0);
+      Ptr<MobilityModel> mobility;
+      if (i == 11 || i == 30)
+        {
+          Ptr<ConstantVelocityMobilityModel> velocity = CreateObject<ConstantVelocityMobilityModel> ();
+          velocity->SetPosition (position);
+          velocity->SetVelocity (Vector (i == 11 ? 20 : -20, 3, 0));
+          mobility = velocity;
+        }
+      else
+        {
+          mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (position);
+        }
+      if (i == 8)
+        {
+          // Set after the first transmissions
+          Simulator::Schedule (Seconds (1.5), &CullingTestPhy::SetMobility, phy, mobility);
+        }
+      else
+        {
+          phy->SetMobility (mobility);
+        }
+      channel->AddRx (phy);
+      phys.push_back (phy);
+    }
+
+  // Each transmitter sends once per second, phy 5 jumps to the other
+  // end of the grid in the middle of the run, and phy 12 gets a new
+  // mobility model, near the other end of the grid
+  uint32_t txPhys[] = { 0, 7, 11, 20, 30, 38 };
+  for (uint32_t t = 0; t < 5; t++)
+    {
+      for (uint32_t j = 0; j < sizeof (txPhys) / sizeof (txPhys[0]); j++)
+        {
+          Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+          params->duration = MicroSeconds (100);
+          params->txPhy = phys[txPhys[j]];
+          params->psd = Create<SpectrumValue> (modelA);
+          for (uint32_t k = 0; k < 20; k++)
+            {
+              (*params->psd)[k] = 1e-11 * (1 + k % 3);
+            }
+          Simulator::Schedule (Seconds (t + 1) + MicroSeconds (j), &MultiModelSpectrumChannel::StartTx, channel, params);
+        }
+    }
+  Simulator::Schedule (Seconds (2.5), &MobilityModel::SetPosition, phys[5]->GetMobility (), Vector (175, 100, 0));
+  Ptr<MobilityModel> replacement = CreateObject<ConstantPositionMobilityModel> ();
+  replacement->SetPosition (Vector (170, 0, 0));
+  Simulator::Schedule (Seconds (3.5), &CullingTestPhy::SetMobility, phys[12], replacement);
+  Simulator::Run ();
+
+  std::vector<std::vector<CullingTestReception> > receptions;
+  for (uint32_t i = 0; i < phys.size (); i++)
+    {
+      receptions.push_back (phys[i]->m_receptions);
+      for (std::vector<CullingTestReception>::iterator r = receptions[i].begin (); r != receptions[i].end (); ++r)
+        {
+          while (phys[r->tx] != r->txPhy)
+            {
+              r->tx++;
+            }
+          r->txPhy = 0;
+        }
+    }
+  Simulator::Destroy ();
+  return receptions;
+}
+
+void
+SpectrumChannelCullingTestCase::DoRun (void)
+{
+  double maxRange = 60;
+  double minRxPowerDbm = -100;
+  std::vector<std::vector<CullingTestReception> > all = Run (0, -1e9);
+  std::vector<std::vector<CullingTestReception> > culled = Run (maxRange, minRxPowerDbm);
+
+  uint32_t nAll = 0;
+  uint32_t nCulled = 0;
+  uint32_t nBelowThreshold = 0;
+  for (uint32_t i = 0; i < all.size (); i++)
+    {
+      std::vector<CullingTestReception>::const_iterator c = culled[i].begin ();
+      for (std::vector<CullingTestReception>::const_iterator a = all[i].begin (); a != all[i].end (); ++a)
+        {
+          nAll++;
+          double powerW = 0;
+          for (uint32_t k = 0; k < a->psd.size (); k++)
+            {
+              powerW += a->psd[k] * 1e6;
+            }
+          double powerDbm = 10 * std::log10 (powerW) + 30;
+          if (a->distance > maxRange)
+            {
+              continue;
+            }
+          if (powerDbm < minRxPowerDbm)
+            {
+              nBelowThreshold++;
+              continue;
+            }
+          NS_TEST_EXPECT_MSG_EQ ((c != culled[i].end ()), true, "Missing reception by phy " << i);
+          if (c == culled[i].end ())
+            {
+              break;
+            }
+          NS_TEST_EXPECT_MSG_EQ (c->tx, a->tx, "Wrong transmitter for phy " << i);
+          NS_TEST_EXPECT_MSG_EQ (c->time, a->time, "Wrong reception time for phy " << i);
+          NS_TEST_EXPECT_MSG_EQ (c->psd.size (), a->psd.size (), "Wrong PSD size for phy " << i);
+          // The positions of the moving phys are updated by each call
+          // to GetPosition (), which the grid makes more often, so their
+          // path loss can differ in the last bits.
+          for (uint32_t k = 0; k < a->psd.size () && k < c->psd.size (); k++)
+            {
+              NS_TEST_EXPECT_MSG_EQ_TOL (c->psd[k], a->psd[k], a->psd[k] * 1e-12, "Wrong PSD for phy " << i);
+            }
+          ++c;
+          nCulled++;
+        }
+      NS_TEST_EXPECT_MSG_EQ ((c == culled[i].end ()), true, "Unexpected reception by phy " << i);
+    }
+  // Both cutoffs must have skipped receptions
+  NS_TEST_EXPECT_MSG_GT (nAll, nCulled + nBelowThreshold, "No reception beyond MaxRange");
+  NS_TEST_EXPECT_MSG_GT (nBelowThreshold, 0, "No reception below MinRxPowerDbm");
+  NS_TEST_EXPECT_MSG_GT (nCulled, 0, "No reception left");
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * The MultiModelSpectrumChannel culling test suite.
+ */
+class SpectrumChannelCullingTestSuite : public TestSuite
+{
+public:
+  SpectrumChannelCullingTestSuite ();
+};
+
+SpectrumChannelCullingTestSuite::SpectrumChannelCullingTestSuite ()
+  : TestSuite ("spectrum-channel-culling", UNIT)
+{
+  AddTestCase (new SpectrumChannelCullingTestCase, TestCase::QUICK);
+}
+
+static SpectrumChannelCullingTestSuite g_spectrumChannelCullingTestSuite; //!< Static variable for test initialization
@@ -105,8 +105,8 @@
 #define NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL_INTERNAL(actual, expected, tol, msg, file, line) \
   do                                                                           \
     {                                                                          \
-      Values::const_iterator i = (actual).ConstValuesBegin ();          \
-      Values::const_iterator j = (expected).ConstValuesBegin ();        \
+      SpectrumValue::ConstValuesIterator i = (actual).ConstValuesBegin ();      \
+      SpectrumValue::ConstValuesIterator j = (expected).ConstValuesBegin ();    \
       uint32_t k = 0;                                                          \
       while (i != (actual).ConstValuesEnd () && j != (expected).ConstValuesEnd ()) \
         {                                                                      \
@@ -137,7 +137,7 @@
           actualStream << (i != (actual).ConstValuesEnd ());        \
           std::ostringstream expectedStream;        \
           expectedStream <<  (j != (expected).ConstValuesEnd ());   \
-          ReportTestFailure ("Values::const_iterator == ConstValuesEnd ()",                                        \
+          ReportTestFailure ("SpectrumValue::ConstValuesIterator == ConstValuesEnd ()",                                        \
                              actualStream.str (), expectedStream.str (), msgStream.str (), (file), (line)); \
         } \
     }            \
@@ -82,6 +82,455 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * Check that the copies of a SpectrumValue, which share its values, and
+ * the multiplications by flat values, which are combined and applied to
+ * the values when they are accessed, give exactly the values of an
+ * independent copy multiplied element by element, and that the values
+ * accessed through an iterator or a reference are not shared.
+ */
+class SpectrumValueSharingTestCase : public TestCase
+{
+public:
+  SpectrumValueSharingTestCase ();
+  virtual void DoRun (void);
+};
+
+SpectrumValueSharingTestCase::SpectrumValueSharingTestCase ()
+  : TestCase ("Check the sharing of the values of copied and scaled SpectrumValues")
+{
+}
+
+void
+SpectrumValueSharingTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (int i = 1; i <= 5; i++)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> f = Create<SpectrumModel> (freqs);
+
+  SpectrumValue values (f);
+  SpectrumValue expected (f);
+  SpectrumValue twice (f);
+  for (uint32_t k = 0; k < 5; k++)
+    {
+      values[k] = 0.1 + 0.3 * k;
+      expected[k] = (0.1 + 0.3 * k) * 0.7;
+      twice[k] = (0.1 + 0.3 * k) * (0.7 * 1.3);
+    }
+  // The values of a copy are shareable, unlike the ones written through
+  // operator[]
+  Ptr<SpectrumValue> a = Create<SpectrumValue> (values);
+
+  // A scaled copy, read without storing the scaled values
+  Ptr<SpectrumValue> b = a->Copy ();
+  *b *= 0.7;
+  NS_TEST_EXPECT_MSG_EQ (Integral (*b), Integral (expected), "Wrong integral of a scaled copy");
+  NS_TEST_EXPECT_MSG_EQ (Sum (*b), Sum (expected), "Wrong sum of a scaled copy");
+  NS_TEST_EXPECT_MSG_EQ (Norm (*b), Norm (expected), "Wrong norm of a scaled copy");
+  SpectrumValue product = expected * (*b);
+  SpectrumValue sum = expected + (*b);
+  for (uint32_t k = 0; k < 5; k++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (product[k], expected[k] * expected[k], "Wrong product with a scaled copy");
+      NS_TEST_EXPECT_MSG_EQ (sum[k], expected[k] + expected[k], "Wrong sum with a scaled copy");
+    }
+
+  // Reading and modifying the copies
+  Ptr<SpectrumValue> c = b->Copy ();
+  *c *= 1.3;
+  const SpectrumValue &constB = *b;
+  for (uint32_t k = 0; k < 5; k++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (constB[k], expected[k], "Wrong value of a scaled copy");
+      NS_TEST_EXPECT_MSG_EQ (c->ValuesAt (k), twice[k], "Wrong value of a copy scaled twice");
+    }
+  (*b)[0] = 7;
+  (*a)[1] = 9;
+  NS_TEST_EXPECT_MSG_EQ ((*a)[0], 0.1, "Original modified through a copy");
+  NS_TEST_EXPECT_MSG_EQ ((*b)[1], expected[1], "Copy modified through the original");
+  NS_TEST_EXPECT_MSG_EQ ((*c)[0], twice[0], "Copy modified through another copy");
+
+  // Assigning a flat value discards the pending gain
+  Ptr<SpectrumValue> d = a->Copy ();
+  *d *= 0.7;
+  *d = 2;
+  NS_TEST_EXPECT_MSG_EQ (Sum (*d), 10, "Wrong sum after assignment");
+  NS_TEST_EXPECT_MSG_EQ ((*a)[2], 0.1 + 0.3 * 2, "Original modified by an assignment to a copy");
+
+  // The integral of a product, with pending gains on either side
+  Ptr<SpectrumValue> e = a->Copy ();
+  *e *= 0.3;
+  NS_TEST_EXPECT_MSG_EQ (IntegralOfProduct (*a, expected), Integral ((*a) * expected), "Wrong integral of a product");
+  NS_TEST_EXPECT_MSG_EQ (IntegralOfProduct (*e, *c), Integral ((*e) * (*c)), "Wrong integral of a product of scaled copies");
+  NS_TEST_EXPECT_MSG_EQ (IntegralOfProduct (*c, *e), Integral ((*c) * (*e)), "Wrong integral of a product of scaled copies");
+
+  // The const iterators read the scaled values, the other bands being zero
+  const SpectrumValue &constC = *c;
+  SpectrumValue::ConstValuesIterator it = constC.ConstValuesBegin ();
+  NS_TEST_EXPECT_MSG_EQ (constC.ConstValuesEnd () - it, 5, "Wrong number of values");
+  for (uint32_t k = 0; k < 5; k++, it++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (*it, twice[k], "Wrong value read through a const iterator");
+      NS_TEST_EXPECT_MSG_EQ (constC.ConstValuesBegin ()[k], twice[k], "Wrong value read by index");
+    }
+  NS_TEST_EXPECT_MSG_EQ ((it == constC.ConstValuesEnd ()), true, "Wrong end of the values");
+  SpectrumValue range = *a;
+  range.SetOccupiedRange (1, 3);
+  range *= 2;
+  const SpectrumValue &constRange = range;
+  NS_TEST_EXPECT_MSG_EQ (*constRange.ConstValuesBegin (), 0, "Wrong value out of the occupied range");
+  NS_TEST_EXPECT_MSG_EQ (constRange.ConstValuesBegin ()[2], (0.1 + 0.3 * 2) * 2, "Wrong value in the occupied range");
+  NS_TEST_EXPECT_MSG_EQ (constRange.ValuesAt (4), 0, "Wrong value out of the occupied range");
+
+  // The values accessed through an iterator or a reference are copied by
+  // the later copies, and the multiplications apply to them at once
+  Ptr<SpectrumValue> g = a->Copy ();
+  Values::iterator vit = g->ValuesBegin ();
+  SpectrumValue h = *g;
+  *vit = 5;
+  NS_TEST_EXPECT_MSG_EQ (h[0], 0.1, "Copy modified through an iterator taken before the copy");
+  *g *= 2;
+  NS_TEST_EXPECT_MSG_EQ (*vit, 10, "Value of the iterator not multiplied");
+  double &ref = (*g)[1];
+  SpectrumValue i = *g;
+  ref = 3;
+  NS_TEST_EXPECT_MSG_EQ (i[1], 18, "Copy modified through a reference taken before the copy");
+  NS_TEST_EXPECT_MSG_EQ ((*g)[1], 3, "Value not modified through the reference");
+}
+
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Check that the operators and the fused operations of SpectrumValue,
+ * which work on contiguous arrays in one pass, give the values computed
+ * element by element, for numbers of bands which are and are not
+ * multiples of the vector widths, on shared and not shared values with
+ * and without a pending flat gain.
+ */
+class SpectrumValueKernelsTestCase : public TestCase
+{
+public:
+  SpectrumValueKernelsTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Check the values of a SpectrumValue.
+   * \param actual the SpectrumValue
+   * \param expected the expected values
+   * \param name the name of the operation
+   */
+  void Check (const SpectrumValue &actual, const std::vector<double> &expected, std::string name);
+};
+
+SpectrumValueKernelsTestCase::SpectrumValueKernelsTestCase ()
+  : TestCase ("Check the element by element operations of SpectrumValue")
+{
+}
+
+void
+SpectrumValueKernelsTestCase::Check (const SpectrumValue &actual, const std::vector<double> &expected, std::string name)
+{
+  NS_TEST_ASSERT_MSG_EQ (actual.GetValuesN (), expected.size (), "Wrong number of values for " << name);
+  for (uint32_t k = 0; k < expected.size (); k++)
+    {
+      // The compiler may fuse a multiplication and an addition
+      NS_TEST_EXPECT_MSG_EQ_TOL (actual.ValuesAt (k), expected[k], std::abs (expected[k]) * 1e-14,
+                                 "Wrong value " << k << " of " << actual.GetValuesN () << " for " << name);
+    }
+}
+
+void
+SpectrumValueKernelsTestCase::DoRun (void)
+{
+  uint32_t sizes[] = {2, 3, 4, 5, 7, 8, 9, 17, 1027};
+  for (uint32_t n : sizes)
+    {
+      std::vector<double> freqs;
+      for (uint32_t k = 0; k < n; k++)
+        {
+          freqs.push_back (1e3 * (k + 1));
+        }
+      Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+      Ptr<SpectrumValue> a = Create<SpectrumValue> (model);
+      Ptr<SpectrumValue> b = Create<SpectrumValue> (model);
+      for (uint32_t k = 0; k < n; k++)
+        {
+          (*a)[k] = 0.5 + std::sin (k + 1.0) * 0.25;
+          (*b)[k] = 1.5 + std::cos (k * 3.0) * 0.75;
+        }
+      // b is shared with scaled and with its copy
+      double gain = 0.3;
+      Ptr<SpectrumValue> scaled = b->Copy ();
+      *scaled *= gain;
+      std::vector<double> va (n);
+      std::vector<double> vb (n);
+      std::vector<double> vs (n);
+      for (uint32_t k = 0; k < n; k++)
+        {
+          va[k] = a->ValuesAt (k);
+          vb[k] = b->ValuesAt (k);
+          vs[k] = vb[k] * gain;
+        }
+
+      std::vector<double> expected (n);
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = va[k] + vs[k];
+        }
+      Check ((*a) + (*scaled), expected, "a + scaled");
+      SpectrumValue c = *a;
+      c += *scaled;
+      Check (c, expected, "a += scaled");
+      c = *a;
+      c += *b;
+      c -= *b;
+      c *= *b;
+      c /= *b;
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = (((va[k] + vb[k]) - vb[k]) * vb[k]) / vb[k];
+        }
+      Check (c, expected, "in place operations");
+
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = vs[k] - va[k];
+        }
+      Check ((*scaled) - (*a), expected, "scaled - a");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = va[k] * vs[k];
+        }
+      Check ((*a) * (*scaled), expected, "a * scaled");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = vs[k] / va[k];
+        }
+      Check ((*scaled) / (*a), expected, "scaled / a");
+
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = vs[k] + 2.5;
+        }
+      Check ((*scaled) + 2.5, expected, "scaled + 2.5");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = vs[k] / 2.5;
+        }
+      Check ((*scaled) / 2.5, expected, "scaled / 2.5");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = -vs[k];
+        }
+      Check (-(*scaled), expected, "-scaled");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = std::pow (vs[k], 1.7);
+        }
+      Check (Pow (*scaled, 1.7), expected, "Pow (scaled, 1.7)");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = std::pow (1.7, vs[k]);
+        }
+      Check (Pow (1.7, *scaled), expected, "Pow (1.7, scaled)");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = std::log10 (vs[k]);
+        }
+      Check (Log10 (*scaled), expected, "Log10 (scaled)");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = std::log (vs[k]);
+        }
+      Check (Log (*scaled), expected, "Log (scaled)");
+
+      // The fused operations, on shared and not shared values
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = vs[k] + va[k] * vb[k];
+        }
+      SpectrumValue shared = *scaled;
+      shared.AddProduct (*a, *b);
+      Check (shared, expected, "AddProduct on shared values");
+      SpectrumValue own = (*b) * gain;
+      own.ValuesBegin (); // Copies the values, with the gain applied
+      own.AddProduct (*a, *b);
+      Check (own, expected, "AddProduct on values which are not shared");
+      SpectrumValue product = (*scaled) + (*a) * (*b);
+      Check (product, expected, "scaled + a * b");
+      for (uint32_t k = 0; k < n; k++)
+        {
+          expected[k] = va[k] + vs[k] * 0.9;
+        }
+      SpectrumValue sum = *a;
+      sum.AddScaled (*scaled, 0.9);
+      Check (sum, expected, "AddScaled");
+      SpectrumValue composed = *a;
+      composed += (*scaled) * 0.9;
+      Check (composed, expected, "a += scaled * 0.9");
+      Check (*b, vb, "b after the operations");
+      Check (*a, va, "a after the operations");
+    }
+}
+
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the SpectrumValues whose values are only stored for a
+ * range of bands: the results of the operations must be those of the
+ * SpectrumValues storing all the bands.
+ */
+class SpectrumValueOccupiedRangeTestCase : public TestCase
+{
+public:
+  SpectrumValueOccupiedRangeTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the occupied range and the values of a SpectrumValue.
+   * \param actual the SpectrumValue computed from band-limited values
+   * \param expected the SpectrumValue computed from values of all the bands
+   * \param start the expected first band of the occupied range
+   * \param end the expected band following the occupied range
+   * \param name the name of the operation
+   */
+  void Check (const SpectrumValue &actual, const SpectrumValue &expected, uint32_t start, uint32_t end, std::string name);
+};
+
+SpectrumValueOccupiedRangeTestCase::SpectrumValueOccupiedRangeTestCase ()
+  : TestCase ("Check the operations on the occupied range of SpectrumValue")
+{
+}
+
+void
+SpectrumValueOccupiedRangeTestCase::Check (const SpectrumValue &actual, const SpectrumValue &expected,
+                                           uint32_t start, uint32_t end, std::string name)
+{
+  NS_TEST_EXPECT_MSG_EQ (actual.GetOccupiedStart (), start, "Wrong start of the occupied range for " << name);
+  NS_TEST_EXPECT_MSG_EQ (actual.GetOccupiedEnd (), end, "Wrong end of the occupied range for " << name);
+  NS_TEST_ASSERT_MSG_EQ (actual.GetValuesN (), expected.GetValuesN (), "Wrong number of values for " << name);
+  for (uint32_t k = 0; k < expected.GetValuesN (); k++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (actual.ValuesAt (k), expected.ValuesAt (k), "Wrong value " << k << " for " << name);
+    }
+}
+
+void
+SpectrumValueOccupiedRangeTestCase::DoRun (void)
+{
+  uint32_t n = 40;
+  std::vector<double> freqs;
+  for (uint32_t k = 0; k < n; k++)
+    {
+      freqs.push_back (1e3 * (k + 1));
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+  SpectrumValue empty (model);
+  NS_TEST_EXPECT_MSG_EQ (empty.GetOccupiedStart (), empty.GetOccupiedEnd (), "No band should be occupied");
+  NS_TEST_EXPECT_MSG_EQ (empty.GetValuesN (), n, "Wrong number of values");
+  NS_TEST_EXPECT_MSG_EQ (Integral (empty), 0, "Wrong integral");
+
+  // a occupies [5, 20), b [12, 30) and c [14, 18)
+  SpectrumValue a (model);
+  SpectrumValue b (model);
+  SpectrumValue c (model);
+  a.SetOccupiedRange (5, 20);
+  b.SetOccupiedRange (12, 30);
+  c.SetOccupiedRange (14, 18);
+  for (uint32_t k = 5; k < 20; k++)
+    {
+      a[k] = 0.5 + std::sin (k + 1.0) * 0.25;
+    }
+  for (uint32_t k = 12; k < 30; k++)
+    {
+      b[k] = 1.5 + std::cos (k * 3.0) * 0.75;
+    }
+  for (uint32_t k = 14; k < 18; k++)
+    {
+      c[k] = 2.5 + k;
+    }
+  b *= 0.3;
+  NS_TEST_EXPECT_MSG_EQ (a.GetOccupiedStart (), 5, "The writes in the range should not store the other bands");
+  NS_TEST_EXPECT_MSG_EQ (a.GetOccupiedEnd (), 20, "The writes in the range should not store the other bands");
+
+  // The same values, with all the bands stored
+  SpectrumValue da = a;
+  SpectrumValue db = b;
+  SpectrumValue dc = c;
+  da.ValuesBegin ();
+  db.ValuesBegin ();
+  dc.ValuesBegin ();
+  Check (da, a, 0, n, "a with all the bands");
+
+  Check (a + b, da + db, 5, 30, "a + b");
+  Check (b - a, db - da, 5, 30, "b - a");
+  Check (a * b, da * db, 12, 20, "a * b");
+  Check (a * c, da * dc, 14, 18, "a * c");
+  Check (c / (b + 1.0), dc / (db + 1.0), 14, 18, "c / (b + 1)");
+  Check (a * empty, da * empty, 0, 0, "a * empty");
+  Check (empty + b, empty + db, 12, 30, "empty + b");
+  Check (b * 2.0, db * 2.0, 12, 30, "b * 2");
+  Check (-b, -db, 12, 30, "-b");
+  Check (Pow (b, 2.0), Pow (db, 2.0), 12, 30, "Pow (b, 2)");
+  Check (b + 1.0, db + 1.0, 0, n, "b + 1");
+  Check (Pow (2.0, b), Pow (2.0, db), 0, n, "Pow (2, b)");
+
+  SpectrumValue sum = c;
+  sum += a;
+  sum -= b;
+  SpectrumValue dsum = dc;
+  dsum += da;
+  dsum -= db;
+  Check (sum, dsum, 5, 30, "c += a, -= b");
+  sum = c;
+  sum.AddProduct (a, b);
+  sum.AddScaled (b, 0.9);
+  dsum = dc;
+  dsum.AddProduct (da, db);
+  dsum.AddScaled (db, 0.9);
+  Check (sum, dsum, 12, 30, "AddProduct and AddScaled");
+  sum = 0;
+  Check (sum, empty, 0, 0, "= 0");
+
+  NS_TEST_EXPECT_MSG_EQ (Integral (b), Integral (db), "Wrong integral");
+  NS_TEST_EXPECT_MSG_EQ (IntegralOfProduct (a, b), IntegralOfProduct (da, db), "Wrong integral of the product");
+  NS_TEST_EXPECT_MSG_EQ (IntegralOfProduct (a, b), Integral (da * db), "Wrong integral of the product");
+  NS_TEST_EXPECT_MSG_EQ (Sum (b), Sum (db), "Wrong sum");
+  NS_TEST_EXPECT_MSG_EQ (Norm (b), Norm (db), "Wrong norm");
+
+  SpectrumValue restricted = da;
+  restricted.SetOccupiedRange (10, 25);
+  for (uint32_t k = 0; k < n; k++)
+    {
+      double expected = (k >= 10 && k < 20) ? a.ValuesAt (k) : 0;
+      NS_TEST_EXPECT_MSG_EQ (restricted.ValuesAt (k), expected, "Wrong value " << k << " of the restricted range");
+    }
+
+  // A coarser model, with a band every 4 bands
+  std::vector<double> coarseFreqs;
+  for (uint32_t k = 0; k < n; k += 4)
+    {
+      coarseFreqs.push_back (1e3 * (k + 2.5));
+    }
+  Ptr<SpectrumModel> coarseModel = Create<SpectrumModel> (coarseFreqs);
+  SpectrumConverter converter (model, coarseModel);
+  Ptr<SpectrumValue> converted = converter.Convert (Create<SpectrumValue> (b));
+  Ptr<SpectrumValue> denseConverted = converter.Convert (Create<SpectrumValue> (db));
+  Check (*converted, *denseConverted, 3, 8, "Convert (b)");
+  Check (*converter.Convert (Create<SpectrumValue> (empty)), SpectrumValue (coarseModel), 0, 0, "Convert (empty)");
+}
+
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -241,6 +690,10 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  AddTestCase (new SpectrumValueSharingTestCase (), TestCase::QUICK);
+  AddTestCase (new SpectrumValueKernelsTestCase (), TestCase::QUICK);
+  AddTestCase (new SpectrumValueOccupiedRangeTestCase (), TestCase::QUICK);
+
 
 }
 
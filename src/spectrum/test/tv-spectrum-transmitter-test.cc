@@ -109,7 +109,7 @@ TvSpectrumTransmitterTestCase::DoRun (void)
 
   /* Test max PSD value */
   Ptr<SpectrumValue> psd = phy->GetTxPsd ();
-  Values::const_iterator psdIter = psd->ConstValuesBegin ();
+  SpectrumValue::ConstValuesIterator psdIter = psd->ConstValuesBegin ();
   double maxValue = 0;
   while (psdIter != psd->ConstValuesEnd ())
     {
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures the cost of the bookkeeping of InterferenceHelper
+// in a dense OBSS scenario, without the rest of the PHY.
+//
+// A receiver receives back-to-back HE A-MPDUs.  During each of them,
+// signals from overlapping BSSs start at random times, with random
+// durations and powers, so that many noise and interference changes are
+// tracked.  At the end of each A-MPDU, the SNR and PER of the PHY headers
+// and of each MPDU are computed, as WifiPhy does.
+//
+// The program can be configured at run-time by passing command-line
+// arguments: the number of A-MPDUs (--nPpdus), the number of interfering
+// signals per A-MPDU (--nSignals), their maximum duration in microseconds
+// (--maxSignalDuration) and the number of MPDUs per A-MPDU (--nMpdus).
+//
+// The output of the program is the wall-clock time of the simulation, and
+// the sum of the PERs, which does not depend on how the changes are stored.
+//
+
+#include <iomanip>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-utils.h"
+#include "ns3/interference-helper.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/nist-error-rate-model.h"
+
+using namespace ns3;
+
+/// InterferenceHelper benchmark
+class InterferenceBench
+{
+public:
+  /**
+   * Constructor
+   * \param nPpdus the number of received A-MPDUs
+   * \param nSignals the number of interfering signals per A-MPDU
+   * \param maxSignalDuration the maximum duration of an interfering signal
+   * \param nMpdus the number of MPDUs per A-MPDU
+   */
+  InterferenceBench (uint32_t nPpdus, uint32_t nSignals, Time maxSignalDuration, uint32_t nMpdus);
+  /**
+   * Run the benchmark.
+   * \returns the sum of the PERs
+   */
+  double Run (void);
+
+private:
+  /// Start the reception of an A-MPDU, and schedule the interfering signals
+  void StartPpdu (void);
+  /**
+   * End the reception of an A-MPDU.
+   * \param event the received event
+   */
+  void EndPpdu (Ptr<Event> event);
+
+  InterferenceHelper m_interference; ///< the interference helper
+  WifiTxVector m_txVector; ///< the TXVECTOR of the A-MPDUs
+  Time m_ppduDuration; ///< the duration of an A-MPDU
+  uint32_t m_nPpdus; ///< the number of A-MPDUs left to receive
+  uint32_t m_nSignals; ///< the number of interfering signals per A-MPDU
+  Time m_maxSignalDuration; ///< the maximum duration of an interfering signal
+  uint32_t m_nMpdus; ///< the number of MPDUs per A-MPDU
+  Ptr<UniformRandomVariable> m_random; ///< the random variable
+  double m_perSum; ///< the sum of the PERs
+};
+
+InterferenceBench::InterferenceBench (uint32_t nPpdus, uint32_t nSignals, Time maxSignalDuration, uint32_t nMpdus)
+  : m_txVector (WifiPhy::GetHeMcs7 (), 0, WIFI_PREAMBLE_HE_SU, 800, 1, 1, 0, 20, true, false),
+    m_ppduDuration (MilliSeconds (5)),
+    m_nPpdus (nPpdus),
+    m_nSignals (nSignals),
+    m_maxSignalDuration (maxSignalDuration),
+    m_nMpdus (nMpdus),
+    m_random (CreateObject<UniformRandomVariable> ()),
+    m_perSum (0)
+{
+  m_interference.SetNoiseFigure (DbToRatio (7));
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+}
+
+double
+InterferenceBench::Run (void)
+{
+  Simulator::ScheduleNow (&InterferenceBench::StartPpdu, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_perSum;
+}
+
+void
+InterferenceBench::StartPpdu (void)
+{
+  Ptr<Event> event = m_interference.Add (Create<WifiPsdu> (Create<Packet> (1500), WifiMacHeader ()), m_txVector, m_ppduDuration, DbmToW (-45));
+  m_interference.NotifyRxStart ();
+  for (uint32_t i = 0; i < m_nSignals; i++)
+    {
+      Time start = NanoSeconds (m_random->GetInteger (0, m_ppduDuration.GetNanoSeconds ()));
+      Time duration = NanoSeconds (m_random->GetInteger (1, m_maxSignalDuration.GetNanoSeconds ()));
+      double power = DbmToW (m_random->GetValue (-95, -75));
+      Simulator::Schedule (start, &InterferenceHelper::AddForeignSignal, &m_interference, duration, power);
+    }
+  Simulator::Schedule (m_ppduDuration, &InterferenceBench::EndPpdu, this, event);
+}
+
+void
+InterferenceBench::EndPpdu (Ptr<Event> event)
+{
+  m_perSum += m_interference.CalculateLegacyPhyHeaderSnrPer (event).per;
+  m_perSum += m_interference.CalculateNonLegacyPhyHeaderSnrPer (event).per;
+  Time payloadDuration = m_ppduDuration - MicroSeconds (100);
+  for (uint32_t i = 0; i < m_nMpdus; i++)
+    {
+      std::pair<Time, Time> window (payloadDuration * i / m_nMpdus, payloadDuration * (i + 1) / m_nMpdus);
+      m_perSum += m_interference.CalculatePayloadSnrPer (event, window).per;
+    }
+  m_interference.NotifyRxEnd ();
+  if (--m_nPpdus > 0)
+    {
+      StartPpdu ();
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nPpdus = 1000;
+  uint32_t nSignals = 200;
+  uint32_t maxSignalDuration = 1000;
+  uint32_t nMpdus = 64;
+
+  CommandLine cmd;
+  cmd.AddValue ("nPpdus", "Number of received A-MPDUs", nPpdus);
+  cmd.AddValue ("nSignals", "Number of interfering signals per A-MPDU", nSignals);
+  cmd.AddValue ("maxSignalDuration", "Maximum duration in microseconds of an interfering signal", maxSignalDuration);
+  cmd.AddValue ("nMpdus", "Number of MPDUs per A-MPDU", nMpdus);
+  cmd.Parse (argc, argv);
+
+  InterferenceBench bench (nPpdus, nSignals, MicroSeconds (maxSignalDuration), nMpdus);
+  SystemWallClockMs clock;
+  clock.Start ();
+  double perSum = bench.Run ();
+  int64_t elapsed = clock.End ();
+
+  std::cout << nPpdus << " A-MPDUs with " << nSignals << " interfering signals each: "
+            << elapsed / 1000.0 << " s" << std::endl;
+  std::cout << "Sum of the PERs: " << std::setprecision (17) << perSum << std::endl;
+  return 0;
+}
@@ -60,6 +60,7 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-psdu.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simple-frame-capture-model.h"
 
@@ -126,7 +127,11 @@ InterferenceExperiment::SendA (void) const
   txVector.SetTxPowerLevel (0); //only one TX power level
   txVector.SetMode (WifiMode (m_input.txModeA));
   txVector.SetPreambleType (m_input.preamble);
-  m_txA->SendPacket (p, txVector);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (p, hdr);
+  m_txA->Send (psdu, txVector);
 }
 
 void
@@ -137,7 +142,11 @@ InterferenceExperiment::SendB (void) const
   txVector.SetTxPowerLevel (0); //only one TX power level
   txVector.SetMode (WifiMode (m_input.txModeB));
   txVector.SetPreambleType (m_input.preamble);
-  m_txB->SendPacket (p, txVector);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (p, hdr);
+  m_txB->Send (psdu, txVector);
 }
 
 void
@@ -32,6 +32,7 @@
 #include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/wifi-mac-queue.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ht-configuration.h"
@@ -63,6 +64,10 @@ AsciiPhyTransmitSinkWithContext (
   uint8_t txLevel)
 {
   NS_LOG_FUNCTION (stream << context << p << mode << preamble << txLevel);
+  if (stream->WriteBinaryRecord (BinaryTraceFile::TRANSMIT, context, p, mode.GetUniqueName ()))
+    {
+      return;
+    }
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << context << " " << mode << " " << *p << std::endl;
 }
 
@@ -83,6 +88,10 @@ AsciiPhyTransmitSinkWithoutContext (
   uint8_t txLevel)
 {
   NS_LOG_FUNCTION (stream << p << mode << preamble << txLevel);
+  if (stream->WriteBinaryRecord (BinaryTraceFile::TRANSMIT, "", p, mode.GetUniqueName ()))
+    {
+      return;
+    }
   *stream->GetStream () << "t " << Simulator::Now ().GetSeconds () << " " << mode << " " << *p << std::endl;
 }
 
@@ -105,6 +114,10 @@ AsciiPhyReceiveSinkWithContext (
   WifiPreamble preamble)
 {
   NS_LOG_FUNCTION (stream << context << p << snr << mode << preamble);
+  if (stream->WriteBinaryRecord (BinaryTraceFile::RECEIVE, context, p, mode.GetUniqueName ()))
+    {
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << mode << "" << context << " " << *p << std::endl;
 }
 
@@ -125,6 +138,10 @@ AsciiPhyReceiveSinkWithoutContext (
   WifiPreamble preamble)
 {
   NS_LOG_FUNCTION (stream << p << snr << mode << preamble);
+  if (stream->WriteBinaryRecord (BinaryTraceFile::RECEIVE, "", p, mode.GetUniqueName ()))
+    {
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << mode << " " << *p << std::endl;
 }
 
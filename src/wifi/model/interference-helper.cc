@@ -19,13 +19,14 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
-#include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "interference-helper.h"
+#include "wifi-psdu.h"
 #include "wifi-phy.h"
 #include "error-rate-model.h"
 #include "wifi-utils.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -35,8 +36,8 @@ NS_LOG_COMPONENT_DEFINE ("InterferenceHelper");
  *       Phy event class
  ****************************************************************/
 
-Event::Event (Ptr<const Packet> packet, WifiTxVector txVector, Time duration, double rxPower)
-  : m_packet (packet),
+Event::Event (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time duration, double rxPower)
+  : m_psdu (psdu),
     m_txVector (txVector),
     m_startTime (Simulator::Now ()),
     m_endTime (m_startTime + duration),
@@ -48,10 +49,10 @@ Event::~Event ()
 {
 }
 
-Ptr<const Packet>
-Event::GetPacket (void) const
+Ptr<const WifiPsdu>
+Event::GetPsdu (void) const
 {
-  return m_packet;
+  return m_psdu;
 }
 
 Time
@@ -136,9 +137,9 @@ InterferenceHelper::~InterferenceHelper ()
 }
 
 Ptr<Event>
-InterferenceHelper::Add (Ptr<const Packet> packet, WifiTxVector txVector, Time duration, double rxPowerW)
+InterferenceHelper::Add (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time duration, double rxPowerW)
 {
-  Ptr<Event> event = Create<Event> (packet, txVector, duration, rxPowerW);
+  Ptr<Event> event = Create<Event> (psdu, txVector, duration, rxPowerW);
   AppendEvent (event);
   return event;
 }
@@ -149,8 +150,8 @@ InterferenceHelper::AddForeignSignal (Time duration, double rxPowerW)
   // Parameters other than duration and rxPowerW are unused for this type
   // of signal, so we provide dummy versions
   WifiTxVector fakeTxVector;
-  Ptr<const Packet> packet (0);
-  Add (packet, fakeTxVector, duration, rxPowerW);
+  Ptr<const WifiPsdu> fakePsdu (0);
+  Add (fakePsdu, fakeTxVector, duration, rxPowerW);
 }
 
 void
@@ -204,16 +205,31 @@ InterferenceHelper::AppendEvent (Ptr<Event> event)
   previousPowerStart = GetPreviousPosition (event->GetStartTime ())->second.GetPower ();
   previousPowerEnd = GetPreviousPosition (event->GetEndTime ())->second.GetPower ();
 
+  m_payloadCursor.event = 0;
   if (!m_rxing)
     {
       m_firstPower = previousPowerStart;
       // Always leave the first zero power noise event in the list
-      m_niChanges.erase (++(m_niChanges.begin ()),
+      m_niChanges.erase (m_niChanges.begin () + 1,
                          GetNextPosition (event->GetStartTime ()));
     }
+  else
+    {
+      // Erase the changes before the start of the oldest signal still in the air,
+      // but leave the last change before now, which gives the current power
+      auto last = GetPreviousPosition (event->GetStartTime ());
+      auto it = m_niChanges.cbegin () + 1;
+      while (it < last && it->second.GetEvent ()->GetEndTime () < event->GetStartTime ())
+        {
+          ++it;
+        }
+      m_niChanges.erase (m_niChanges.cbegin () + 1, it);
+    }
+  // Adding the end change may reallocate the changes, but does not move the start change
   auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
+  auto offset = first - m_niChanges.begin ();
   auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  for (auto i = m_niChanges.begin () + offset; i != last; ++i)
     {
       i->second.AddPower (event->GetRxPowerW ());
     }
@@ -235,23 +251,35 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint1
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event) const
 {
   double noiseInterferenceW = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->first < Simulator::Now (); ++it)
+  //The power is the one of the last NI change before now, if it is not before the start of the event
+  auto start = GetPosition (event->GetStartTime ());
+  if (start != m_niChanges.end () && start->first == event->GetStartTime ())
     {
-      noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
+      auto it = GetPosition (Simulator::Now ());
+      if (it != m_niChanges.begin () && (--it)->first >= event->GetStartTime ())
+        {
+          noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW ();
+        }
     }
-  it = m_niChanges.find (event->GetStartTime ());
+  NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
+  return noiseInterferenceW;
+}
+
+double
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
+{
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
+  auto it = GetPosition (event->GetStartTime ());
   for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it);
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
+  ni->emplace_back (event->GetStartTime (), NiChange (0, event));
   while (++it != m_niChanges.end () && it->second.GetEvent () != event)
     {
-      ni->insert (*it);
+      ni->push_back (*it);
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
-  NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
+  ni->emplace_back (event->GetEndTime (), NiChange (0, event));
   return noiseInterferenceW;
 }
 
@@ -278,26 +306,50 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double
-InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni, std::pair<Time, Time> window) const
+InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, std::pair<Time, Time> window) const
 {
   NS_LOG_FUNCTION (this << window.first << window.second);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  auto j = ni->begin ();
-  Time previous = j->first;
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = txVector.GetPreambleType ();
-  Time plcpHeaderStart = j->first + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
+  Time plcpHeaderStart = event->GetStartTime () + WifiPhy::GetPlcpPreambleDuration (txVector); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
   Time windowStart = plcpPayloadStart + window.first;
   Time windowEnd = plcpPayloadStart + window.second;
-  double noiseInterferenceW = m_firstPower;
+  if (m_payloadCursor.event != event || windowStart < m_payloadCursor.windowStart)
+    {
+      auto start = GetPosition (event->GetStartTime ());
+      for (; start != m_niChanges.end () && start->second.GetEvent () != event; ++start);
+      NS_ASSERT (start != m_niChanges.end ());
+      m_payloadCursor.event = event;
+      m_payloadCursor.start = start;
+      m_payloadCursor.position = start;
+    }
+  m_payloadCursor.windowStart = windowStart;
   double powerW = event->GetRxPowerW ();
-  while (++j != ni->end ())
+  auto j = m_payloadCursor.position;
+  Time previous = j->first;
+  double noiseInterferenceW = (j == m_payloadCursor.start) ? m_firstPower : j->second.GetPower () - powerW;
+  bool end = false;
+  while (!end)
     {
-      Time current = j->first;
+      //The NI changes of the event are the ones between its own start and end changes
+      Time current;
+      double power;
+      if (++j == m_niChanges.end () || j->second.GetEvent () == event)
+        {
+          current = event->GetEndTime ();
+          power = 0;
+          end = true;
+        }
+      else
+        {
+          current = j->first;
+          power = j->second.GetPower ();
+        }
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: Both previous and current point to the windowed payload
@@ -320,8 +372,12 @@ InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni,
                                             payloadMode, txVector);
           NS_LOG_DEBUG ("previous is before windowed payload and current is in the windowed payload: mode=" << payloadMode << ", psr=" << psr);
         }
-      noiseInterferenceW = j->second.GetPower () - powerW;
-      previous = j->first;
+      noiseInterferenceW = power - powerW;
+      previous = current;
+      if (!end && previous < windowStart)
+        {
+          m_payloadCursor.position = j;
+        }
       if (previous > windowEnd)
         {
           NS_LOG_DEBUG ("Stop: new previous=" << previous << " after time window end=" << windowEnd);
@@ -849,8 +905,7 @@ InterferenceHelper::CalculateNonLegacyPhyHeaderPer (Ptr<const Event> event, NiCh
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Time> relativeMpduStartStop) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -858,7 +913,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Ti
   /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePayloadPer (event, &ni, relativeMpduStartStop);
+  double per = CalculatePayloadPer (event, relativeMpduStartStop);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -869,8 +924,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, std::pair<Time, Ti
 double
 InterferenceHelper::CalculateSnr (Ptr<Event> event) const
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -921,16 +975,25 @@ void
 InterferenceHelper::EraseEvents (void)
 {
   m_niChanges.clear ();
+  m_payloadCursor.event = 0;
   // Always have a zero power noise event in the list
   AddNiChangeEvent (Time (0), NiChange (0.0, 0));
   m_rxing = false;
   m_firstPower = 0;
 }
 
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::GetPosition (Time moment) const
+{
+  return std::lower_bound (m_niChanges.begin (), m_niChanges.end (), moment,
+                           [] (const NiChanges::value_type &change, Time t) { return change.first < t; });
+}
+
 InterferenceHelper::NiChanges::const_iterator
 InterferenceHelper::GetNextPosition (Time moment) const
 {
-  return m_niChanges.upper_bound (moment);
+  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), moment,
+                           [] (Time t, const NiChanges::value_type &change) { return t < change.first; });
 }
 
 InterferenceHelper::NiChanges::const_iterator
@@ -962,7 +1025,7 @@ InterferenceHelper::NotifyRxEnd ()
   NS_LOG_FUNCTION (this);
   m_rxing = false;
   //Update m_firstPower for frame capture
-  auto it = m_niChanges.find (Simulator::Now ());
+  auto it = GetPosition (Simulator::Now ());
   it--;
   m_firstPower = it->second.GetPower ();
 }
@@ -23,11 +23,11 @@
 
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
-#include <map>
+#include <vector>
 
 namespace ns3 {
 
-class Packet;
+class WifiPsdu;
 class ErrorRateModel;
 
 /**
@@ -41,19 +41,19 @@ public:
   /**
    * Create an Event with the given parameters.
    *
-   * \param packet the packet
-   * \param txVector TXVECTOR of the packet
+   * \param psdu the PSDU
+   * \param txVector TXVECTOR of the PSDU
    * \param duration duration of the signal
    * \param rxPower the receive power (w)
    */
-  Event (Ptr<const Packet> packet, WifiTxVector txVector, Time duration, double rxPower);
+  Event (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time duration, double rxPower);
   ~Event ();
 
-  /** Return the packet.
+  /** Return the PSDU.
    *
-   * \return the packet
+   * \return the PSDU
    */
-  Ptr<const Packet> GetPacket (void) const;
+  Ptr<const WifiPsdu> GetPsdu (void) const;
   /**
    * Return the start time of the signal.
    *
@@ -87,7 +87,7 @@ public:
 
 
 private:
-  Ptr<const Packet> m_packet; ///< packet
+  Ptr<const WifiPsdu> m_psdu; ///< PSDU
   WifiTxVector m_txVector; ///< TXVECTOR
   Time m_startTime; ///< start time
   Time m_endTime; ///< end time
@@ -154,16 +154,16 @@ public:
   Time GetEnergyDuration (double energyW) const;
 
   /**
-   * Add the packet-related signal to interference helper.
+   * Add the PSDU-related signal to interference helper.
    *
-   * \param packet the packet
-   * \param txVector TXVECTOR of the packet
+   * \param psdu the PSDU
+   * \param txVector TXVECTOR of the PSDU
    * \param duration the duration of the signal
    * \param rxPower receive power (W)
    *
    * \return Event
    */
-  Ptr<Event> Add (Ptr<const Packet> packet, WifiTxVector txVector, Time duration, double rxPower);
+  Ptr<Event> Add (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time duration, double rxPower);
 
   /**
    * Add a non-Wifi signal to interference helper.
@@ -265,9 +265,10 @@ private:
   };
 
   /**
-   * typedef for a multimap of NiChanges
+   * typedef for a vector of NiChanges, sorted by time. The changes at the
+   * same time are in the order in which they were added.
    */
-  typedef std::multimap<Time, NiChange> NiChanges;
+  typedef std::vector<std::pair<Time, NiChange> > NiChanges;
 
   /**
    * Append the given Event.
@@ -279,6 +280,15 @@ private:
    * Calculate noise and interference power in W.
    *
    * \param event
+   *
+   * \return noise and interference power
+   */
+  double CalculateNoiseInterferenceW (Ptr<Event> event) const;
+  /**
+   * Calculate noise and interference power in W, and copy the NI changes
+   * during the event in ni.
+   *
+   * \param event
    * \param ni
    *
    * \return noise and interference power
@@ -311,13 +321,16 @@ private:
    * window (thus enabling per MPDU PER information). The PLCP payload can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
    *
+   * The NI changes of the event are walked in m_niChanges from the payload
+   * cursor, so that the windows of the successive MPDUs of an A-MPDU
+   * only visit their own chunks.
+   *
    * \param event
-   * \param ni
    * \param window time window (pair of start and end times) of PLCP payload to focus on
    *
    * \return the error rate of the payload
    */
-  double CalculatePayloadPer (Ptr<const Event> event, NiChanges *ni, std::pair<Time, Time> window) const;
+  double CalculatePayloadPer (Ptr<const Event> event, std::pair<Time, Time> window) const;
   /**
    * Calculate the error rate of the legacy PHY header. The legacy PHY header
    * can be divided into multiple chunks (e.g. due to interference from other transmissions).
@@ -347,6 +360,28 @@ private:
   double m_firstPower; ///< first power
   bool m_rxing; ///< flag whether it is in receiving state
 
+  /**
+   * The position reached in m_niChanges by the last PER evaluation of a
+   * payload window. The NI changes before the start of a window do not
+   * change its PER, so the next window of the same event, if it does not
+   * start earlier, resumes from there.
+   */
+  struct PayloadCursor
+  {
+    Ptr<const Event> event; ///< the event whose payload is evaluated, or 0
+    NiChanges::const_iterator start; ///< the NI change of the start of the event
+    NiChanges::const_iterator position; ///< the last NI change before the start of the window
+    Time windowStart; ///< the start of the last window
+  };
+  mutable PayloadCursor m_payloadCursor; ///< the payload cursor, reset whenever m_niChanges changes
+
+  /**
+   * Returns an iterator to the first nichange that is not earlier than moment
+   *
+   * \param moment time to check from
+   * \returns an iterator to the list of NiChanges
+   */
+  NiChanges::const_iterator GetPosition (Time moment) const;
   /**
    * Returns an iterator to the first nichange that is later than moment
    *
@@ -328,22 +328,22 @@ public:
                                   Ptr<Txop> txop);
 
   /**
-   * \param packet packet received
-   * \param rxSnr snr of packet received
-   * \param txVector TXVECTOR of packet received
+   * \param mpdu MPDU received
+   * \param rxSnr snr of MPDU received
+   * \param txVector TXVECTOR of MPDU received
    * \param ampduSubframe true if this MPDU is part of an A-MPDU
    *
    * This method is typically invoked by the lower PHY layer to notify
-   * the MAC layer that a packet was successfully received.
+   * the MAC layer that an MPDU was successfully received.
    */
-  void ReceiveOk (Ptr<Packet> packet, double rxSnr, WifiTxVector txVector, bool ampduSubframe);
+  void ReceiveOk (Ptr<const WifiMacQueueItem> mpdu, double rxSnr, WifiTxVector txVector, bool ampduSubframe);
   /**
-   * \param packet packet received.
+   * \param psdu PSDU received.
    *
    * This method is typically invoked by the lower PHY layer to notify
-   * the MAC layer that a packet was unsuccessfully received.
+   * the MAC layer that a PSDU was unsuccessfully received.
    */
-  void ReceiveError (Ptr<Packet> packet);
+  void ReceiveError (Ptr<const WifiPsdu> psdu);
   /**
    * \param duration switching delay duration.
    *
@@ -400,15 +400,15 @@ public:
    */
   void RegisterEdcaForAc (AcIndex ac, Ptr<QosTxop> edca);
   /**
-   * \param aggregatedPacket which is the current A-MPDU
-   * \param rxSnr snr of packet received
-   * \param txVector TXVECTOR of packet received
+   * \param psdu the PSDU received, which is the current A-MPDU if aggregated
+   * \param rxSnr snr of PSDU received
+   * \param txVector TXVECTOR of PSDU received
    * \param statusPerMpdu reception status per MPDU
    *
-   * This function de-aggregates an A-MPDU and decide if each MPDU is received correctly or not
+   * This function goes through the MPDUs of an A-MPDU and decide if each MPDU is received correctly or not
    *
    */
-  void DeaggregateAmpduAndReceive (Ptr<Packet> aggregatedPacket, double rxSnr, WifiTxVector txVector,
+  void DeaggregateAmpduAndReceive (Ptr<const WifiPsdu> psdu, double rxSnr, WifiTxVector txVector,
                                    std::vector<bool> statusPerMpdu);
 
   /**
@@ -762,7 +762,7 @@ private:
    */
   bool ReceiveMpdu (Ptr<Packet> packet, WifiMacHeader hdr);
   /**
-   * \param packet the packet
+   * \param packet the packet, without the MAC header and trailer
    * \param hdr the header
    * \returns true if the MPDU stored
    *
@@ -90,9 +90,7 @@ MpduAggregator::Aggregate (Ptr<const WifiMacQueueItem> mpdu, Ptr<Packet> ampdu,
     }
 
   // add MPDU header and trailer
-  Ptr<Packet> tmp = mpdu->GetPacket ()->Copy ();
-  tmp->AddHeader (mpdu->GetHeader ());
-  AddWifiMacTrailer (tmp);
+  Ptr<Packet> tmp = mpdu->GetProtocolDataUnit ();
 
   // add A-MPDU subframe header and MPDU to the A-MPDU
   AmpduSubframeHeader hdr;
@@ -92,6 +92,16 @@ public:
    */
   static uint32_t GetSizeIfAggregated (uint32_t mpduSize, uint32_t ampduSize);
 
+  /**
+   * \param ampduSize the size of the A-MPDU that needs to be padded
+   * \return the size of the padding that must be added to the end of an A-MPDU
+   *
+   * Calculates how much padding must be added to the end of an A-MPDU of the given size
+   * (once another MPDU is aggregated).
+   * Each A-MPDU subframe is padded so that its length is multiple of 4 octets.
+   */
+  static uint8_t CalculatePadding (uint32_t ampduSize);
+
   /**
    * Determine the maximum size for an A-MPDU of the given TID that can be sent
    * to the given receiver when using the given modulation class.
@@ -175,16 +185,6 @@ public:
   void SetEdcaQueues (EdcaQueues edcaQueues);
 
 private:
-  /**
-   * \param ampduSize the size of the A-MPDU that needs to be padded
-   * \return the size of the padding that must be added to the end of an A-MPDU
-   *
-   * Calculates how much padding must be added to the end of an A-MPDU of the given size
-   * (once another MPDU is aggregated).
-   * Each A-MPDU subframe is padded so that its length is multiple of 4 octets.
-   */
-  static uint8_t CalculatePadding (uint32_t ampduSize);
-
   EdcaQueues m_edca;   //!< the map of EDCA queues
 };
 
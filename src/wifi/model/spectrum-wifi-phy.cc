@@ -32,6 +32,9 @@
 #include "wifi-spectrum-signal-parameters.h"
 #include "wifi-spectrum-phy-interface.h"
 #include "wifi-utils.h"
+#include "wifi-ppdu.h"
+#include <map>
+#include <tuple>
 
 namespace ns3 {
 
@@ -39,6 +42,18 @@ NS_LOG_COMPONENT_DEFINE ("SpectrumWifiPhy");
 
 NS_OBJECT_ENSURE_REGISTERED (SpectrumWifiPhy);
 
+/**
+ * The parameters of a transmit spectrum mask: the modulation class, the
+ * center frequency, the channel width and the guard bandwidth.
+ */
+typedef std::tuple<WifiModulationClass, uint16_t, uint16_t, uint16_t> TxMaskId;
+
+/**
+ * The transmit spectrum masks for a transmit power of 1 W, shared by all
+ * the PHYs and scaled to the transmit power of each PPDU.
+ */
+static std::map<TxMaskId, Ptr<const SpectrumValue> > g_txMasks;
+
 TypeId
 SpectrumWifiPhy::GetTypeId (void)
 {
@@ -205,10 +220,10 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
   // total energy apparent to the "demodulator".
   uint16_t channelWidth = GetChannelWidth ();
   Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth));
-  SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
+  double filteredPowerW = IntegralOfProduct (*filter, *receivedSignalPsd);
   // Add receiver antenna gain
-  NS_LOG_DEBUG ("Signal power received (watts) before antenna gain: " << Integral (filteredSignal));
-  double rxPowerW = Integral (filteredSignal) * DbToRatio (GetRxGain ());
+  NS_LOG_DEBUG ("Signal power received (watts) before antenna gain: " << filteredPowerW);
+  double rxPowerW = filteredPowerW * DbToRatio (GetRxGain ());
   NS_LOG_DEBUG ("Signal power received after antenna gain: " << rxPowerW << " W (" << WToDbm (rxPowerW) << " dBm)");
 
   Ptr<WifiSpectrumSignalParameters> wifiRxParams = DynamicCast<WifiSpectrumSignalParameters> (rxParams);
@@ -239,8 +254,7 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
     }
 
   NS_LOG_INFO ("Received Wi-Fi signal");
-  Ptr<Packet> packet = wifiRxParams->packet->Copy ();
-  StartReceivePreamble (packet, rxPowerW, rxDuration);
+  StartReceivePreamble (wifiRxParams->ppdu, rxPowerW);
 }
 
 Ptr<AntennaModel>
@@ -269,29 +283,41 @@ Ptr<SpectrumValue>
 SpectrumWifiPhy::GetTxPowerSpectralDensity (uint16_t centerFrequency, uint16_t channelWidth, double txPowerW, WifiModulationClass modulationClass) const
 {
   NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW);
-  Ptr<SpectrumValue> v;
-  switch (modulationClass)
+  uint16_t guardBandwidth = GetGuardBandwidth (channelWidth);
+  TxMaskId key (modulationClass, centerFrequency, channelWidth, guardBandwidth);
+  std::map<TxMaskId, Ptr<const SpectrumValue> >::const_iterator it = g_txMasks.find (key);
+  if (it == g_txMasks.end ())
     {
-    case WIFI_MOD_CLASS_OFDM:
-    case WIFI_MOD_CLASS_ERP_OFDM:
-      v = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW, GetGuardBandwidth (channelWidth));
-      break;
-    case WIFI_MOD_CLASS_DSSS:
-    case WIFI_MOD_CLASS_HR_DSSS:
-      NS_ABORT_MSG_IF (channelWidth != 22, "Invalid channel width for DSSS");
-      v = WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (centerFrequency, txPowerW, GetGuardBandwidth (channelWidth));
-      break;
-    case WIFI_MOD_CLASS_HT:
-    case WIFI_MOD_CLASS_VHT:
-      v = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW, GetGuardBandwidth (channelWidth));
-      break;
-    case WIFI_MOD_CLASS_HE:
-      v = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW, GetGuardBandwidth (channelWidth));
-      break;
-    default:
-      NS_FATAL_ERROR ("modulation class unknown: " << modulationClass);
-      break;
+      Ptr<SpectrumValue> mask;
+      switch (modulationClass)
+        {
+        case WIFI_MOD_CLASS_OFDM:
+        case WIFI_MOD_CLASS_ERP_OFDM:
+          mask = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1, guardBandwidth);
+          break;
+        case WIFI_MOD_CLASS_DSSS:
+        case WIFI_MOD_CLASS_HR_DSSS:
+          NS_ABORT_MSG_IF (channelWidth != 22, "Invalid channel width for DSSS");
+          mask = WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (centerFrequency, 1, guardBandwidth);
+          break;
+        case WIFI_MOD_CLASS_HT:
+        case WIFI_MOD_CLASS_VHT:
+          mask = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1, guardBandwidth);
+          break;
+        case WIFI_MOD_CLASS_HE:
+          mask = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1, guardBandwidth);
+          break;
+        default:
+          NS_FATAL_ERROR ("modulation class unknown: " << modulationClass);
+          break;
+        }
+      // The mask is built through iterators: its copy has values which
+      // the copies of the copy can share
+      it = g_txMasks.insert (std::make_pair (key, Create<SpectrumValue> (*mask))).first;
     }
+  // The copy shares the values of the mask, and is scaled when they are accessed
+  Ptr<SpectrumValue> v = Create<SpectrumValue> (*it->second);
+  *v *= txPowerW;
   return v;
 }
 
@@ -311,19 +337,21 @@ SpectrumWifiPhy::GetCenterFrequencyForChannelWidth (WifiTxVector txVector) const
 }
 
 void
-SpectrumWifiPhy::StartTx (Ptr<Packet> packet, WifiTxVector txVector, Time txDuration)
+SpectrumWifiPhy::StartTx (Ptr<WifiPpdu> ppdu)
 {
+  NS_LOG_FUNCTION (this << *ppdu);
+  WifiTxVector txVector = ppdu->GetTxVector ();
   double txPowerDbm = GetTxPowerForTransmission (txVector) + GetTxGain ();
   NS_LOG_DEBUG ("Start transmission: signal power before antenna gain=" << txPowerDbm << "dBm");
   double txPowerWatts = DbmToW (txPowerDbm);
   Ptr<SpectrumValue> txPowerSpectrum = GetTxPowerSpectralDensity (GetCenterFrequencyForChannelWidth (txVector), txVector.GetChannelWidth (), txPowerWatts, txVector.GetMode ().GetModulationClass ());
   Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
-  txParams->duration = txDuration;
+  txParams->duration = ppdu->GetTxDuration ();
   txParams->psd = txPowerSpectrum;
   NS_ASSERT_MSG (m_wifiSpectrumPhyInterface, "SpectrumPhy() is not set; maybe forgot to call CreateWifiSpectrumPhyInterface?");
   txParams->txPhy = m_wifiSpectrumPhyInterface->GetObject<SpectrumPhy> ();
   txParams->txAntenna = m_antenna;
-  txParams->packet = packet;
+  txParams->ppdu = ppdu;
   NS_LOG_DEBUG ("Starting transmission with power " << WToDbm (txPowerWatts) << " dBm on channel " << +GetChannelNumber ());
   NS_LOG_DEBUG ("Starting transmission with integrated spectrum power " << WToDbm (Integral (*txPowerSpectrum)) << " dBm; spectrum model Uid: " << txPowerSpectrum->GetSpectrumModel ()->GetUid ());
   m_channel->StartTx (txParams);
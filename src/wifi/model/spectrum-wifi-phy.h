@@ -75,13 +75,11 @@ public:
   void StartRx (Ptr<SpectrumSignalParameters> rxParams);
 
   /**
-   * \param packet the packet to send
-   * \param txVector the TXVECTOR that has tx parameters such as mode, the transmission mode to use to send
-   *        this packet, and txPowerLevel, a power level to use to send this packet. The real transmission
-   *        power is calculated as txPowerMin + txPowerLevel * (txPowerMax - txPowerMin) / nTxLevels
-   * \param txDuration duration of the transmission.
+   * \param ppdu the PPDU to send, whose TXVECTOR has tx parameters such as mode, the transmission mode
+   *        to use to send this PPDU, and txPowerLevel, a power level to use to send this PPDU. The real
+   *        transmission power is calculated as txPowerMin + txPowerLevel * (txPowerMax - txPowerMin) / nTxLevels
    */
-  void StartTx (Ptr<Packet> packet, WifiTxVector txVector, Time txDuration);
+  void StartTx (Ptr<WifiPpdu> ppdu);
   /**
    * Get the center frequency of the channel corresponding the current TxVector rather than
    * that of the supported channel width.
@@ -181,7 +179,8 @@ private:
    * \return Ptr to SpectrumValue
    *
    * This is a helper function to create the right Tx PSD corresponding
-   * to the standard in use.
+   * to the standard in use.  The masks are created for 1 W once per set of
+   * parameters, and scaled to txPowerW.
    */
   Ptr<SpectrumValue> GetTxPowerSpectralDensity (uint16_t centerFrequency, uint16_t channelWidth, double txPowerW, WifiModulationClass modulationClass) const;
 
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "table-based-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "wifi-tx-vector.h"
+#include "wifi-mode.h"
+#include "wifi-utils.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TableBasedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TableBasedErrorRateModel);
+
+TypeId
+TableBasedErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableBasedErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TableBasedErrorRateModel> ()
+    .AddAttribute ("ReferenceModel",
+                   "The error rate model whose chunk success rates are tabulated.",
+                   PointerValue (),
+                   MakePointerAccessor (&TableBasedErrorRateModel::GetReferenceModel,
+                                        &TableBasedErrorRateModel::SetReferenceModel),
+                   MakePointerChecker<ErrorRateModel> ())
+    .AddAttribute ("MinSnr",
+                   "The lowest SNR of the table (expressed in dB).",
+                   DoubleValue (-10),
+                   MakeDoubleAccessor (&TableBasedErrorRateModel::GetMinSnr,
+                                       &TableBasedErrorRateModel::SetMinSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The highest SNR of the table (expressed in dB).",
+                   DoubleValue (50),
+                   MakeDoubleAccessor (&TableBasedErrorRateModel::GetMaxSnr,
+                                       &TableBasedErrorRateModel::SetMaxSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Resolution",
+                   "The SNR step of the table (expressed in dB).",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&TableBasedErrorRateModel::GetResolution,
+                                       &TableBasedErrorRateModel::SetResolution),
+                   MakeDoubleChecker<double> (1e-6))
+  ;
+  return tid;
+}
+
+TableBasedErrorRateModel::TableBasedErrorRateModel ()
+  : m_referenceModel (CreateObject<NistErrorRateModel> ())
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TableBasedErrorRateModel::~TableBasedErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TableBasedErrorRateModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_referenceModel = 0;
+  m_tables.clear ();
+  ErrorRateModel::DoDispose ();
+}
+
+void
+TableBasedErrorRateModel::SetReferenceModel (const Ptr<ErrorRateModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  if (model == 0)
+    {
+      // The default value of the attribute
+      return;
+    }
+  m_referenceModel = model;
+  m_tables.clear ();
+}
+
+Ptr<ErrorRateModel>
+TableBasedErrorRateModel::GetReferenceModel (void) const
+{
+  return m_referenceModel;
+}
+
+void
+TableBasedErrorRateModel::SetMinSnr (double snr)
+{
+  NS_LOG_FUNCTION (this << snr);
+  m_minSnr = snr;
+  m_tables.clear ();
+}
+
+double
+TableBasedErrorRateModel::GetMinSnr (void) const
+{
+  return m_minSnr;
+}
+
+void
+TableBasedErrorRateModel::SetMaxSnr (double snr)
+{
+  NS_LOG_FUNCTION (this << snr);
+  m_maxSnr = snr;
+  m_tables.clear ();
+}
+
+double
+TableBasedErrorRateModel::GetMaxSnr (void) const
+{
+  return m_maxSnr;
+}
+
+void
+TableBasedErrorRateModel::SetResolution (double resolution)
+{
+  NS_LOG_FUNCTION (this << resolution);
+  m_resolution = resolution;
+  m_tables.clear ();
+}
+
+double
+TableBasedErrorRateModel::GetResolution (void) const
+{
+  return m_resolution;
+}
+
+const TableBasedErrorRateModel::Table &
+TableBasedErrorRateModel::GetTable (WifiMode mode, WifiTxVector txVector) const
+{
+  TableId id (mode.GetUid (), txVector.GetChannelWidth (), txVector.GetGuardInterval (), txVector.GetNss ());
+  auto it = m_tables.find (id);
+  if (it != m_tables.end ())
+    {
+      return it->second;
+    }
+  NS_LOG_FUNCTION (this << mode);
+  NS_ASSERT (m_maxSnr > m_minSnr);
+  uint32_t size = static_cast<uint32_t> (std::ceil ((m_maxSnr - m_minSnr) / m_resolution)) + 1;
+  Table &table = m_tables[id];
+  table.reserve (size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      double psr = m_referenceModel->GetChunkSuccessRate (mode, txVector, DbToRatio (m_minSnr + i * m_resolution), 1);
+      //-inf if the bits are always received, +inf if they are never received
+      table.push_back (std::log (-std::log (psr)));
+    }
+  return table;
+}
+
+double
+TableBasedErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << snr << nbits);
+  double snrDb = RatioToDb (snr);
+  if (!(snrDb >= m_minSnr && snrDb < m_maxSnr)
+      || mode.GetModulationClass () == WIFI_MOD_CLASS_DSSS
+      || mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS)
+    {
+      //The DSSS success rates have steps, at the SINRs beyond which they are perfect or impossible
+      return m_referenceModel->GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  const Table &table = GetTable (mode, txVector);
+  double position = (snrDb - m_minSnr) / m_resolution;
+  uint32_t index = static_cast<uint32_t> (position);
+  double fraction = position - index;
+  NS_ASSERT (index + 1 < table.size ());
+  double low = table[index];
+  double high = table[index + 1];
+  double value;
+  if (std::isfinite (low) && std::isfinite (high))
+    {
+      value = low + (high - low) * fraction;
+    }
+  else
+    {
+      value = fraction < 0.5 ? low : high;
+    }
+  return std::exp (-std::exp (value) * nbits);
+}
+
+} //namespace ns3
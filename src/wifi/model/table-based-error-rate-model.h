@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABLE_BASED_ERROR_RATE_MODEL_H
+#define TABLE_BASED_ERROR_RATE_MODEL_H
+
+#include "error-rate-model.h"
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model which interpolates the chunk success rates of
+ * another error rate model, tabulated over a grid of SNRs.
+ *
+ * The NIST, YANS and DSSS error rate models compute a bit error rate
+ * from the mode and the SNR, with erfc and long polynomials, and raise
+ * its complement to the number of bits of the chunk.  This model asks
+ * the reference model once for the success rate of a single bit at
+ * each point of the grid, the first time a mode is used, and stores
+ * log (-log (success rate of a bit)), which is smooth in the SNR in
+ * dB.  The success rate of a chunk is then found by linear
+ * interpolation in the table of its mode.
+ *
+ * The reference model must thus give success rates of the form
+ * (1 - ber)^nbits, where ber only depends on the SNR, the mode, and
+ * the channel width, guard interval and number of spatial streams of
+ * the TXVECTOR, which set the PHY rate used by the YANS model.  There
+ * is one table for each of these combinations.  The SNRs out of the
+ * grid, and the DSSS and HR/DSSS modes, whose success rates are not
+ * continuous, are passed to the reference model.  The grid must be set
+ * before the model is used: changing it discards the tables.
+ */
+class TableBasedErrorRateModel : public ErrorRateModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TableBasedErrorRateModel ();
+  virtual ~TableBasedErrorRateModel ();
+
+  /**
+   * \param model the error rate model whose success rates are tabulated
+   */
+  void SetReferenceModel (const Ptr<ErrorRateModel> model);
+  /**
+   * \return the error rate model whose success rates are tabulated
+   */
+  Ptr<ErrorRateModel> GetReferenceModel (void) const;
+  /**
+   * \param snr the lowest SNR of the grid (dB)
+   */
+  void SetMinSnr (double snr);
+  /**
+   * \return the lowest SNR of the grid (dB)
+   */
+  double GetMinSnr (void) const;
+  /**
+   * \param snr the highest SNR of the grid (dB)
+   */
+  void SetMaxSnr (double snr);
+  /**
+   * \return the highest SNR of the grid (dB)
+   */
+  double GetMaxSnr (void) const;
+  /**
+   * \param resolution the SNR step of the grid (dB)
+   */
+  void SetResolution (double resolution);
+  /**
+   * \return the SNR step of the grid (dB)
+   */
+  double GetResolution (void) const;
+
+  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * The table of a mode: log (-log (success rate of a bit)) at each SNR
+   * of the grid.
+   */
+  typedef std::vector<double> Table;
+  /**
+   * The UID of the mode, and the channel width, guard interval and
+   * number of spatial streams of the TXVECTOR of a table.
+   */
+  typedef std::tuple<uint32_t, uint16_t, uint16_t, uint8_t> TableId;
+
+  /**
+   * Get the table of a mode and TXVECTOR, and build it if needed.
+   *
+   * \param mode the Wi-Fi mode
+   * \param txVector the TXVECTOR passed to the reference model
+   *
+   * \return the table
+   */
+  const Table & GetTable (WifiMode mode, WifiTxVector txVector) const;
+
+  Ptr<ErrorRateModel> m_referenceModel; ///< the tabulated error rate model
+  double m_minSnr;     ///< the lowest SNR of the grid (dB)
+  double m_maxSnr;     ///< the highest SNR of the grid (dB)
+  double m_resolution; ///< the SNR step of the grid (dB)
+  mutable std::map<TableId, Table> m_tables; ///< the tables
+};
+
+} //namespace ns3
+
+#endif /* TABLE_BASED_ERROR_RATE_MODEL_H */
@@ -96,6 +96,14 @@ public:
    */
   uint32_t GetSize (void) const;
 
+  /**
+   * \brief Get the MPDU: a copy of the packet stored in this item, with the
+   *        header and the FCS trailer added
+   *
+   * \return the MPDU.
+   */
+  Ptr<Packet> GetProtocolDataUnit (void) const;
+
   /**
    * \brief Print the item contents.
    * \param os output stream in which the data should be printed.
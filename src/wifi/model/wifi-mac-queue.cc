@@ -56,13 +56,16 @@ WifiMacQueue::GetTypeId (void)
     .AddTraceSource ("Expired", "MPDU dropped because its lifetime expired.",
                      MakeTraceSourceAccessor (&WifiMacQueue::m_traceExpired),
                      "ns3::WifiMacQueueItem::TracedCallback")
+    .AddTraceSource ("ExpiredAt", "MPDU dropped because its lifetime expired, "
+                     "and the time at which it expired.",
+                     MakeTraceSourceAccessor (&WifiMacQueue::m_traceExpiredAt),
+                     "ns3::WifiMacQueue::ExpiredAtTracedCallback")
   ;
   return tid;
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : m_expiredPacketsPresent (false),
-    NS_LOG_TEMPLATE_DEFINE ("WifiMacQueue")
+  : NS_LOG_TEMPLATE_DEFINE ("WifiMacQueue")
 {
 }
 
@@ -100,20 +103,119 @@ WifiMacQueue::GetMaxDelay (void) const
 }
 
 bool
-WifiMacQueue::TtlExceeded (ConstIterator &it)
+WifiMacQueue::IsExpired (ConstIterator it) const
 {
-  NS_LOG_FUNCTION (this);
+  return Simulator::Now () > (*it)->GetTimeStamp () + m_maxDelay;
+}
 
-  if (Simulator::Now () > (*it)->GetTimeStamp () + m_maxDelay)
+void
+WifiMacQueue::RemoveExpired (void)
+{
+  while (!m_expiryIndex.empty () && IsExpired (m_expiryIndex.begin ()->second))
     {
+      ConstIterator it = m_expiryIndex.begin ()->second;
       NS_LOG_DEBUG ("Removing packet that stayed in the queue for too long (" <<
                     Simulator::Now () - (*it)->GetTimeStamp () << ")");
       m_traceExpired (*it);
-      auto curr = it++;
-      DoRemove (curr);
-      return true;
+      m_traceExpiredAt (*it, (*it)->GetTimeStamp () + m_maxDelay);
+      DoRemove (it);
     }
-  return false;
+}
+
+std::size_t
+WifiMacQueue::SubQueueIdHash::operator() (const SubQueueId &id) const
+{
+  return Mac48AddressHash () (id.first) * 16 + id.second;
+}
+
+void
+WifiMacQueue::AddToIndex (ConstIterator it)
+{
+  IndexPosition position;
+  // the items with equal timestamps are kept in the order of their insertion
+  position.expiry = m_expiryIndex.insert (m_expiryIndex.end (), std::make_pair ((*it)->GetTimeStamp (), it));
+  position.subQueue = 0;
+
+  const WifiMacHeader &hdr = (*it)->GetHeader ();
+  if (hdr.IsQosData ())
+    {
+      SubQueue &subQueue = m_subQueues[SubQueueId ((*it)->GetDestinationAddress (), hdr.GetQosTid ())];
+      // the item goes before the first item of its sub-queue that follows it in the queue
+      auto subIt = subQueue.end ();
+      if (it == begin ())
+        {
+          subIt = subQueue.begin ();
+        }
+      else
+        {
+          for (ConstIterator next = std::next (it); next != end (); next++)
+            {
+              const IndexPosition &nextPosition = GetIndexPosition (next);
+              if (nextPosition.subQueue == &subQueue)
+                {
+                  subIt = nextPosition.item;
+                  break;
+                }
+            }
+        }
+      position.subQueue = &subQueue;
+      position.item = subQueue.insert (subIt, it);
+    }
+
+  bool inserted = m_indexPositions.insert (std::make_pair (PeekPointer (*it), position)).second;
+  NS_ASSERT_MSG (inserted, "Item " << **it << " queued twice");
+}
+
+void
+WifiMacQueue::RemoveFromIndex (ConstIterator it)
+{
+  auto position = m_indexPositions.find (PeekPointer (*it));
+  NS_ASSERT (position != m_indexPositions.end ());
+  m_expiryIndex.erase (position->second.expiry);
+  if (position->second.subQueue != 0)
+    {
+      position->second.subQueue->erase (position->second.item);
+    }
+  m_indexPositions.erase (position);
+}
+
+const WifiMacQueue::IndexPosition &
+WifiMacQueue::GetIndexPosition (ConstIterator it) const
+{
+  auto position = m_indexPositions.find (PeekPointer (*it));
+  NS_ASSERT (position != m_indexPositions.end ());
+  return position->second;
+}
+
+bool
+WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  if (!Queue<WifiMacQueueItem>::DoEnqueue (pos, item))
+    {
+      return false;
+    }
+  AddToIndex (std::prev (pos));
+  return true;
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DoDequeue (ConstIterator pos)
+{
+  if (pos != end ())
+    {
+      RemoveFromIndex (pos);
+    }
+  return Queue<WifiMacQueueItem>::DoDequeue (pos);
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueue::DoRemove (ConstIterator pos)
+{
+  if (pos != end ())
+    {
+      RemoveFromIndex (pos);
+    }
+  return Queue<WifiMacQueueItem>::DoRemove (pos);
 }
 
 bool
@@ -147,25 +249,26 @@ WifiMacQueue::Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item)
       return DoEnqueue (pos, item);
     }
 
-  // the queue is full; scan the list in the attempt to remove stale packets
-  ConstIterator it = begin ();
-  while (it != end ())
+  // the queue is full; remove stale packets, and insert the item before the
+  // first packet that is not removed from the given position
+  while (pos != end () && IsExpired (pos))
     {
-      if (it == pos && TtlExceeded (it))
-        {
-          return DoEnqueue (it, item);
-        }
-      if (TtlExceeded (it))
-        {
-          return DoEnqueue (pos, item);
-        }
-      it++;
+      pos++;
+    }
+  RemoveExpired ();
+  if (QueueBase::GetNPackets () < GetMaxSize ().GetValue ())
+    {
+      return DoEnqueue (pos, item);
     }
 
   // the queue is still full, remove the oldest item if the policy is drop oldest
   if (m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
+      if (pos == begin ())
+        {
+          pos++;
+        }
       DoRemove (begin ());
     }
 
@@ -176,12 +279,10 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::Dequeue (void)
 {
   NS_LOG_FUNCTION (this);
-  for (ConstIterator it = begin (); it != end (); )
+  RemoveExpired ();
+  if (begin () != end ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoDequeue (it);
-        }
+      return DoDequeue (begin ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -244,38 +345,14 @@ WifiMacQueue::Dequeue (ConstIterator pos)
 {
   NS_LOG_FUNCTION (this);
 
-  if (!m_expiredPacketsPresent)
-    {
-      if (TtlExceeded (pos))
-        {
-          NS_LOG_DEBUG ("Packet lifetime expired");
-          return 0;
-        }
-      return DoDequeue (pos);
-    }
-
-  // remove stale items queued before the given position
-  ConstIterator it = begin ();
-  while (it != end ())
+  if (IsExpired (pos))
     {
-      if (it == pos)
-        {
-          // reset the flag signaling the presence of expired packets before returning
-          m_expiredPacketsPresent = false;
-
-          if (TtlExceeded (it))
-            {
-              return 0;
-            }
-          return DoDequeue (it);
-        }
-      else if (!TtlExceeded (it))
-        {
-          it++;
-        }
+      NS_LOG_DEBUG ("Packet lifetime expired");
+      RemoveExpired ();
+      return 0;
     }
-  NS_LOG_DEBUG ("Invalid iterator");
-  return 0;
+  RemoveExpired ();
+  return DoDequeue (pos);
 }
 
 Ptr<const WifiMacQueueItem>
@@ -286,12 +363,10 @@ WifiMacQueue::Peek (void) const
     {
       // skip packets that stayed in the queue for too long. They will be
       // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      if (!IsExpired (it))
         {
           return DoPeek (it);
         }
-      // signal the presence of expired packets
-      m_expiredPacketsPresent = true;
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -306,7 +381,7 @@ WifiMacQueue::PeekByAddress (Mac48Address dest, ConstIterator pos) const
     {
       // skip packets that stayed in the queue for too long. They will be
       // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      if (!IsExpired (it))
         {
           if (((*it)->GetHeader ().IsData () || (*it)->GetHeader ().IsQosData ())
               && (*it)->GetDestinationAddress () == dest)
@@ -314,11 +389,6 @@ WifiMacQueue::PeekByAddress (Mac48Address dest, ConstIterator pos) const
               return it;
             }
         }
-      else
-        {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
-        }
       it++;
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -334,18 +404,13 @@ WifiMacQueue::PeekByTid (uint8_t tid, ConstIterator pos) const
     {
       // skip packets that stayed in the queue for too long. They will be
       // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      if (!IsExpired (it))
         {
           if ((*it)->GetHeader ().IsQosData () && (*it)->GetHeader ().GetQosTid () == tid)
             {
               return it;
             }
         }
-      else
-        {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
-        }
       it++;
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -356,25 +421,36 @@ WifiMacQueue::ConstIterator
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this << +tid << dest);
-  ConstIterator it = (pos != EMPTY ? pos : begin ());
-  while (it != end ())
+  auto subQueue = m_subQueues.find (SubQueueId (dest, tid));
+  if (subQueue == m_subQueues.end ())
     {
-      // skip packets that stayed in the queue for too long. They will be
-      // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      NS_LOG_DEBUG ("The queue is empty");
+      return end ();
+    }
+  auto subIt = subQueue->second.cbegin ();
+  if (pos != EMPTY)
+    {
+      // find the first item of the sub-queue from the given position
+      while (pos != end () && GetIndexPosition (pos).subQueue != &subQueue->second)
         {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return it;
-            }
+          pos++;
         }
-      else
+      if (pos == end ())
         {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
+          NS_LOG_DEBUG ("The queue is empty");
+          return end ();
         }
-      it++;
+      subIt = GetIndexPosition (pos).item;
+    }
+  while (subIt != subQueue->second.cend ())
+    {
+      // skip packets that stayed in the queue for too long. They will be
+      // actually removed from the queue by the next call to a non-const method
+      if (!IsExpired (*subIt))
+        {
+          return *subIt;
+        }
+      subIt++;
     }
   NS_LOG_DEBUG ("The queue is empty");
   return end ();
@@ -389,7 +465,7 @@ WifiMacQueue::PeekFirstAvailable (const Ptr<QosBlockedDestinations> blockedPacke
     {
       // skip packets that stayed in the queue for too long. They will be
       // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      if (!IsExpired (it))
         {
           if (!(*it)->GetHeader ().IsQosData () || !blockedPackets
               || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
@@ -397,11 +473,6 @@ WifiMacQueue::PeekFirstAvailable (const Ptr<QosBlockedDestinations> blockedPacke
               return it;
             }
         }
-      else
-        {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
-        }
       it++;
     }
   NS_LOG_DEBUG ("The queue is empty");
@@ -412,13 +483,10 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::Remove (void)
 {
   NS_LOG_FUNCTION (this);
-
-  for (ConstIterator it = begin (); it != end (); )
+  RemoveExpired ();
+  if (begin () != end ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoRemove (it);
-        }
+      return DoRemove (begin ());
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -428,17 +496,13 @@ bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
   NS_LOG_FUNCTION (this << packet);
-  for (ConstIterator it = begin (); it != end (); )
+  RemoveExpired ();
+  for (ConstIterator it = begin (); it != end (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetPacket () == packet)
         {
-          if ((*it)->GetPacket () == packet)
-            {
-              DoRemove (it);
-              return true;
-            }
-
-          it++;
+          DoRemove (it);
+          return true;
         }
     }
   NS_LOG_DEBUG ("Packet " << packet << " not found in the queue");
@@ -450,33 +514,18 @@ WifiMacQueue::Remove (ConstIterator pos, bool removeExpired)
 {
   NS_LOG_FUNCTION (this);
 
-  if (!removeExpired)
-    {
-      ConstIterator curr = pos++;
-      DoRemove (curr);
-      return pos;
-    }
-
-  // remove stale items queued before the given position
-  ConstIterator it = begin ();
-  while (it != end ())
+  ConstIterator curr = pos++;
+  DoRemove (curr);
+  if (removeExpired)
     {
-      if (it == pos)
+      // return the first item following the removed one that is not stale
+      while (pos != end () && IsExpired (pos))
         {
-          // reset the flag signaling the presence of expired packets before returning
-          m_expiredPacketsPresent = false;
-
-          ConstIterator curr = pos++;
-          DoRemove (curr);
-          return pos;
-        }
-      else if (!TtlExceeded (it))
-        {
-          it++;
+          pos++;
         }
+      RemoveExpired ();
     }
-  NS_LOG_DEBUG ("Invalid iterator");
-  return end ();
+  return pos;
 }
 
 uint32_t
@@ -484,18 +533,13 @@ WifiMacQueue::GetNPacketsByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
 
+  RemoveExpired ();
   uint32_t nPackets = 0;
-
-  for (ConstIterator it = begin (); it != end (); )
+  for (ConstIterator it = begin (); it != end (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              nPackets++;
-            }
-
-          it++;
+          nPackets++;
         }
     }
   NS_LOG_DEBUG ("returns " << nPackets);
@@ -506,20 +550,9 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  uint32_t nPackets = 0;
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
-        }
-    }
+  RemoveExpired ();
+  auto subQueue = m_subQueues.find (SubQueueId (dest, tid));
+  uint32_t nPackets = (subQueue != m_subQueues.end () ? subQueue->second.size () : 0);
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
 }
@@ -528,13 +561,11 @@ bool
 WifiMacQueue::IsEmpty (void)
 {
   NS_LOG_FUNCTION (this);
-  for (ConstIterator it = begin (); it != end (); )
+  RemoveExpired ();
+  if (QueueBase::GetNPackets () > 0)
     {
-      if (!TtlExceeded (it))
-        {
-          NS_LOG_DEBUG ("returns false");
-          return false;
-        }
+      NS_LOG_DEBUG ("returns false");
+      return false;
     }
   NS_LOG_DEBUG ("returns true");
   return true;
@@ -545,13 +576,7 @@ WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired ();
   return QueueBase::GetNPackets ();
 }
 
@@ -560,13 +585,7 @@ WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired ();
   return QueueBase::GetNBytes ();
 }
 
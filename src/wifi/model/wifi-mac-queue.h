@@ -26,6 +26,8 @@
 
 #include "wifi-mac-queue-item.h"
 #include "ns3/queue.h"
+#include <unordered_map>
+#include <map>
 
 namespace ns3 {
 
@@ -49,10 +51,16 @@ extern template class Queue<WifiMacQueueItem>;
  * it is queued in the internal queue after being tagged by the
  * current time.
  *
- * When a packet is dequeued, the queue checks its timestamp
- * to verify whether or not it should be dropped. If
- * dot11EDCATableMSDULifetime has elapsed, it is dropped.
- * Otherwise, it is returned to the caller.
+ * The packets are also kept in the order of their timestamps.  Before a
+ * packet is dequeued, and before the packets are counted, the packets
+ * whose dot11EDCATableMSDULifetime has elapsed are dropped, oldest first,
+ * which only requires to look at the oldest packet when none has expired.
+ * The methods which do not modify the queue skip the expired packets.
+ *
+ * The QoS Data frames are also indexed by TID and receiver address, in
+ * sub-queues which keep the order of the queue, so that the frames of a
+ * (TID, receiver) pair are found and counted without visiting the frames
+ * of the other pairs.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -313,24 +321,103 @@ public:
 
   static const ConstIterator EMPTY;         //!< Invalid iterator to signal an empty queue
 
+  /**
+   * TracedCallback signature for the MPDUs dropped because their lifetime
+   * expired.
+   *
+   * \param item the dropped MPDU
+   * \param expiry the time at which the lifetime of the MPDU expired
+   */
+  typedef void (* ExpiredAtTracedCallback)(Ptr<const WifiMacQueueItem> item, Time expiry);
+
 private:
   /**
-   * Remove the item pointed to by the iterator <i>it</i> if it has been in the
-   * queue for too long. If the item is removed, the iterator is updated to
-   * point to the item that followed the erased one.
+   * \param it an iterator pointing to an item
+   * \return true if the item has been in the queue for too long
+   */
+  bool IsExpired (ConstIterator it) const;
+  /**
+   * Remove the items which have been in the queue for too long, in the
+   * order of their timestamps.
+   */
+  void RemoveExpired (void);
+
+  /**
+   * Enqueue an item before the given position, and index it.
+   *
+   * \param pos the position before which the item is to be inserted
+   * \param item the item to enqueue
+   * \return true if success, false if the packet has been dropped
+   */
+  bool DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item);
+  /**
+   * Dequeue the item at the given position, and remove it from the index.
+   *
+   * \param pos the position of the item to dequeue
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> DoDequeue (ConstIterator pos);
+  /**
+   * Drop the item at the given position, and remove it from the index.
+   *
+   * \param pos the position of the item to drop
+   * \return the item
+   */
+  Ptr<WifiMacQueueItem> DoRemove (ConstIterator pos);
+
+  /// The positions of the QoS Data frames of a (TID, receiver) pair, in the order of the queue
+  typedef std::list<ConstIterator> SubQueue;
+  /// The receiver address and the TID of a sub-queue
+  typedef std::pair<Mac48Address, uint8_t> SubQueueId;
+  /// Hash function of the identifiers of the sub-queues
+  struct SubQueueIdHash
+  {
+    /**
+     * \param id the identifier of a sub-queue
+     * \return the hash of the identifier
+     */
+    std::size_t operator() (const SubQueueId &id) const;
+  };
+  /// The items of the queue, in the order of their timestamps
+  typedef std::multimap<Time, ConstIterator> ExpiryIndex;
+  /// The positions of an item in the indexes
+  struct IndexPosition
+  {
+    ExpiryIndex::iterator expiry;             //!< the position of the item in the expiry index
+    SubQueue *subQueue;                       //!< the sub-queue of a QoS Data frame, or a null pointer
+    SubQueue::iterator item;                  //!< the position of a QoS Data frame in its sub-queue
+  };
+
+  /**
+   * Add the item at the given position to the expiry index and, if it is a
+   * QoS Data frame, to the sub-queue of its TID and receiver address.
+   *
+   * \param it the position of the item in the queue
+   */
+  void AddToIndex (ConstIterator it);
+  /**
+   * Remove the item at the given position from the indexes.
    *
-   * \param it an iterator pointing to the item
-   * \return true if the item is removed, false otherwise
+   * \param it the position of the item in the queue
+   */
+  void RemoveFromIndex (ConstIterator it);
+  /**
+   * \param it the position of an item in the queue
+   * \return the positions of the item in the indexes
    */
-  bool TtlExceeded (ConstIterator &it);
+  const IndexPosition & GetIndexPosition (ConstIterator it) const;
 
   QueueSize m_maxSize;                      //!< max queue size
   Time m_maxDelay;                          //!< Time to live for packets in the queue
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
-  mutable bool m_expiredPacketsPresent;     //!> True if expired packets are in the queue
+  ExpiryIndex m_expiryIndex;                //!< the items in the order of their timestamps
+  std::unordered_map<SubQueueId, SubQueue, SubQueueIdHash> m_subQueues;    //!< the sub-queues of the (TID, receiver) pairs
+  std::unordered_map<const WifiMacQueueItem *, IndexPosition> m_indexPositions; //!< the positions of the items in the indexes
 
   /// Traced callback: fired when a packet is dropped due to lifetime expiration
   TracedCallback<Ptr<const WifiMacQueueItem> > m_traceExpired;
+  /// Traced callback: fired when a packet is dropped due to lifetime expiration, with the expiry time
+  TracedCallback<Ptr<const WifiMacQueueItem>, Time> m_traceExpiredAt;
 
   NS_LOG_TEMPLATE_DECLARE;                  //!< redefinition of the log component
 };
@@ -26,8 +26,6 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/error-model.h"
 #include "wifi-phy.h"
-#include "wifi-phy-tag.h"
-#include "ampdu-tag.h"
 #include "wifi-utils.h"
 #include "frame-capture-model.h"
 #include "preamble-detection-model.h"
@@ -36,7 +34,9 @@
 #include "wifi-net-device.h"
 #include "ht-configuration.h"
 #include "he-configuration.h"
-#include "mpdu-aggregator.h"
+#include "wifi-psdu.h"
+#include "wifi-ppdu.h"
+#include "wifi-mac-queue-item.h"
 
 namespace ns3 {
 
@@ -2040,19 +2040,29 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
 Time
 WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t frequency,
                              MpduType mpdutype, uint8_t incFlag)
+{
+  return GetPayloadDuration (size, txVector.GetMode (), GetTxDurationParameters (txVector),
+                             frequency, mpdutype, incFlag);
+}
+
+WifiPhy::TxDurationParameters
+WifiPhy::CalculateTxDurationParameters (WifiTxVector txVector)
 {
   WifiMode payloadMode = txVector.GetMode ();
-  NS_LOG_FUNCTION (size << payloadMode);
+  NS_LOG_FUNCTION (payloadMode);
 
-  double stbc = 1;
+  TxDurationParameters params;
+  params.preambleAndHeader = CalculatePlcpPreambleAndHeaderDuration (txVector);
+
+  params.stbc = 1;
   if (txVector.IsStbc ()
       && (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT
           || payloadMode.GetModulationClass () == WIFI_MOD_CLASS_VHT))
     {
-      stbc = 2;
+      params.stbc = 2;
     }
 
-  double Nes = 1;
+  params.nes = 1;
   //todo: improve logic to reduce the number of if cases
   //todo: extend to NSS > 4 for VHT rates
   if (payloadMode == GetHtMcs21 ()
@@ -2063,7 +2073,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
       || payloadMode == GetHtMcs30 ()
       || payloadMode == GetHtMcs31 ())
     {
-      Nes = 2;
+      params.nes = 2;
     }
   if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_VHT)
     {
@@ -2071,100 +2081,100 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
           && txVector.GetNss () == 3
           && payloadMode.GetMcsValue () >= 8)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 80
           && txVector.GetNss () == 2
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 80
           && txVector.GetNss () == 3
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 80
           && txVector.GetNss () == 3
           && payloadMode.GetMcsValue () == 9)
         {
-          Nes = 3;
+          params.nes = 3;
         }
       if (txVector.GetChannelWidth () == 80
           && txVector.GetNss () == 4
           && payloadMode.GetMcsValue () >= 4)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 80
           && txVector.GetNss () == 4
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 3;
+          params.nes = 3;
         }
       if (txVector.GetChannelWidth () == 160
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 2
           && payloadMode.GetMcsValue () >= 4)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 2
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 3;
+          params.nes = 3;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 3
           && payloadMode.GetMcsValue () >= 3)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 3
           && payloadMode.GetMcsValue () >= 5)
         {
-          Nes = 3;
+          params.nes = 3;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 3
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 4;
+          params.nes = 4;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 4
           && payloadMode.GetMcsValue () >= 2)
         {
-          Nes = 2;
+          params.nes = 2;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 4
           && payloadMode.GetMcsValue () >= 4)
         {
-          Nes = 3;
+          params.nes = 3;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 4
           && payloadMode.GetMcsValue () >= 5)
         {
-          Nes = 4;
+          params.nes = 4;
         }
       if (txVector.GetChannelWidth () == 160
           && txVector.GetNss () == 4
           && payloadMode.GetMcsValue () >= 7)
         {
-          Nes = 6;
+          params.nes = 6;
         }
     }
 
-  Time symbolDuration = Seconds (0);
+  params.symbolDuration = Seconds (0);
   switch (payloadMode.GetModulationClass ())
     {
     case WIFI_MOD_CLASS_OFDM:
@@ -2176,13 +2186,13 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
           {
           case 20:
           default:
-            symbolDuration = MicroSeconds (4);
+            params.symbolDuration = MicroSeconds (4);
             break;
           case 10:
-            symbolDuration = MicroSeconds (8);
+            params.symbolDuration = MicroSeconds (8);
             break;
           case 5:
-            symbolDuration = MicroSeconds (16);
+            params.symbolDuration = MicroSeconds (16);
             break;
           }
         break;
@@ -2194,7 +2204,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
         //In the future has to create a stationmanager that only uses these data rates if sender and receiver support GI
         uint16_t gi = txVector.GetGuardInterval ();
         NS_ASSERT (gi == 400 || gi == 800);
-        symbolDuration = NanoSeconds (3200 + gi);
+        params.symbolDuration = NanoSeconds (3200 + gi);
       }
       break;
     case WIFI_MOD_CLASS_HE:
@@ -2203,20 +2213,47 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
         //In the future has to create a stationmanager that only uses these data rates if sender and receiver support GI
         uint16_t gi = txVector.GetGuardInterval ();
         NS_ASSERT (gi == 800 || gi == 1600 || gi == 3200);
-        symbolDuration = NanoSeconds (12800 + gi);
+        params.symbolDuration = NanoSeconds (12800 + gi);
       }
       break;
     default:
       break;
     }
 
-  double numDataBitsPerSymbol = payloadMode.GetDataRate (txVector) * symbolDuration.GetNanoSeconds () / 1e9;
+  params.numDataBitsPerSymbol = payloadMode.GetDataRate (txVector) * params.symbolDuration.GetNanoSeconds () / 1e9;
+  params.dsssDataRate = 0;
+  if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_DSSS
+      || payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS)
+    {
+      params.dsssDataRate = payloadMode.GetDataRate (22);
+    }
+  return params;
+}
+
+const WifiPhy::TxDurationParameters &
+WifiPhy::GetTxDurationParameters (WifiTxVector txVector)
+{
+  TxDurationKey key (txVector.GetMode ().GetUid (), txVector.GetPreambleType (), txVector.GetChannelWidth (),
+                     txVector.GetGuardInterval (), txVector.GetNss (), txVector.GetNess (), txVector.IsStbc ());
+  auto it = m_txDurationParameters.find (key);
+  if (it == m_txDurationParameters.end ())
+    {
+      it = m_txDurationParameters.insert (std::make_pair (key, CalculateTxDurationParameters (txVector))).first;
+    }
+  return it->second;
+}
+
+Time
+WifiPhy::GetPayloadDuration (uint32_t size, WifiMode payloadMode, const TxDurationParameters &params,
+                             uint16_t frequency, MpduType mpdutype, uint8_t incFlag)
+{
+  NS_LOG_FUNCTION (size << payloadMode);
 
   double numSymbols = 0;
   if (mpdutype == FIRST_MPDU_IN_AGGREGATE)
     {
       //First packet in an A-MPDU
-      numSymbols = (stbc * (16 + size * 8.0 + 6 * Nes) / (stbc * numDataBitsPerSymbol));
+      numSymbols = (params.stbc * (16 + size * 8.0 + 6 * params.nes) / (params.stbc * params.numDataBitsPerSymbol));
       if (incFlag == 1)
         {
           m_totalAmpduSize += size;
@@ -2226,7 +2263,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
   else if (mpdutype == MIDDLE_MPDU_IN_AGGREGATE)
     {
       //consecutive packets in an A-MPDU
-      numSymbols = (stbc * size * 8.0) / (stbc * numDataBitsPerSymbol);
+      numSymbols = (params.stbc * size * 8.0) / (params.stbc * params.numDataBitsPerSymbol);
       if (incFlag == 1)
         {
           m_totalAmpduSize += size;
@@ -2237,7 +2274,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
     {
       //last packet in an A-MPDU
       uint32_t totalAmpduSize = m_totalAmpduSize + size;
-      numSymbols = lrint (stbc * ceil ((16 + totalAmpduSize * 8.0 + 6 * Nes) / (stbc * numDataBitsPerSymbol)));
+      numSymbols = lrint (params.stbc * ceil ((16 + totalAmpduSize * 8.0 + 6 * params.nes) / (params.stbc * params.numDataBitsPerSymbol)));
       NS_ASSERT (m_totalAmpduNumSymbols <= numSymbols);
       numSymbols -= m_totalAmpduNumSymbols;
       if (incFlag == 1)
@@ -2251,7 +2288,7 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
       //Not an A-MPDU or single MPDU (i.e. the current payload contains both service and padding)
       //The number of OFDM symbols in the data field when BCC encoding
       //is used is given in equation 19-32 of the IEEE 802.11-2016 standard.
-      numSymbols = lrint (stbc * ceil ((16 + size * 8.0 + 6.0 * Nes) / (stbc * numDataBitsPerSymbol)));
+      numSymbols = lrint (params.stbc * ceil ((16 + size * 8.0 + 6.0 * params.nes) / (params.stbc * params.numDataBitsPerSymbol)));
     }
   else
     {
@@ -2266,11 +2303,11 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
         //Add signal extension for ERP PHY
         if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
           {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
           }
         else
           {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ()));
           }
       }
     case WIFI_MOD_CLASS_HT:
@@ -2279,11 +2316,11 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
         if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT && Is2_4Ghz (frequency)
             && (mpdutype == NORMAL_MPDU || mpdutype == SINGLE_MPDU || mpdutype == LAST_MPDU_IN_AGGREGATE)) //at 2.4 GHz
           {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
           }
         else //at 5 GHz
           {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ()));
           }
       }
     case WIFI_MOD_CLASS_HE:
@@ -2291,16 +2328,16 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
         if (Is2_4Ghz (frequency)
             && ((mpdutype == NORMAL_MPDU || mpdutype == SINGLE_MPDU || mpdutype == LAST_MPDU_IN_AGGREGATE))) //at 2.4 GHz
           {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
           }
         else //at 5 GHz
           {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ()));
           }
       }
     case WIFI_MOD_CLASS_DSSS:
     case WIFI_MOD_CLASS_HR_DSSS:
-      return MicroSeconds (lrint (ceil ((size * 8.0) / (payloadMode.GetDataRate (22) / 1.0e6))));
+      return MicroSeconds (lrint (ceil ((size * 8.0) / (params.dsssDataRate / 1.0e6))));
     default:
       NS_FATAL_ERROR ("unsupported modulation class");
       return MicroSeconds (0);
@@ -2325,8 +2362,9 @@ Time
 WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t frequency,
                               MpduType mpdutype, uint8_t incFlag)
 {
-  Time duration = CalculatePlcpPreambleAndHeaderDuration (txVector)
-    + GetPayloadDuration (size, txVector, frequency, mpdutype, incFlag);
+  const TxDurationParameters &params = GetTxDurationParameters (txVector);
+  Time duration = params.preambleAndHeader
+    + GetPayloadDuration (size, txVector.GetMode (), params, frequency, mpdutype, incFlag);
   return duration;
 }
 
@@ -2337,109 +2375,86 @@ WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t fre
 }
 
 void
-WifiPhy::NotifyTxBegin (Ptr<const Packet> packet, double txPowerW)
+WifiPhy::NotifyTxBegin (Ptr<const WifiPsdu> psdu, double txPowerW)
 {
-  if (IsAmpdu (packet))
+  if (m_phyTxBeginTrace.IsEmpty ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (packet);
-      for (auto & mpdu : mpdus)
-        {
-          m_phyTxBeginTrace (mpdu, txPowerW);
-        }
+      //Do not serialize the MPDUs if the trace is not connected
+      return;
     }
-  else
+  for (auto& mpdu : *PeekPointer (psdu))
     {
-      m_phyTxBeginTrace (packet, txPowerW);
+      m_phyTxBeginTrace (mpdu->GetProtocolDataUnit (), txPowerW);
     }
 }
 
 void
-WifiPhy::NotifyTxEnd (Ptr<const Packet> packet)
+WifiPhy::NotifyTxEnd (Ptr<const WifiPsdu> psdu)
 {
-  if (IsAmpdu (packet))
+  if (m_phyTxEndTrace.IsEmpty ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (packet);
-      for (auto & mpdu : mpdus)
-        {
-          m_phyTxEndTrace (mpdu);
-        }
+      return;
     }
-  else
+  for (auto& mpdu : *PeekPointer (psdu))
     {
-      m_phyTxEndTrace (packet);
+      m_phyTxEndTrace (mpdu->GetProtocolDataUnit ());
     }
 }
 
 void
-WifiPhy::NotifyTxDrop (Ptr<const Packet> packet)
+WifiPhy::NotifyTxDrop (Ptr<const WifiPsdu> psdu)
 {
-  if (IsAmpdu (packet))
+  if (m_phyTxDropTrace.IsEmpty ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (packet);
-      for (auto & mpdu : mpdus)
-        {
-          m_phyTxDropTrace (mpdu);
-        }
+      return;
     }
-  else
+  for (auto& mpdu : *PeekPointer (psdu))
     {
-      m_phyTxDropTrace (packet);
+      m_phyTxDropTrace (mpdu->GetProtocolDataUnit ());
     }
 }
 
 void
-WifiPhy::NotifyRxBegin (Ptr<const Packet> packet)
+WifiPhy::NotifyRxBegin (Ptr<const WifiPsdu> psdu)
 {
-  if (IsAmpdu (packet))
+  if (m_phyRxBeginTrace.IsEmpty ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (packet);
-      for (auto & mpdu : mpdus)
-        {
-          m_phyRxBeginTrace (mpdu);
-        }
+      return;
     }
-  else
+  for (auto& mpdu : *PeekPointer (psdu))
     {
-      m_phyRxBeginTrace (packet);
+      m_phyRxBeginTrace (mpdu->GetProtocolDataUnit ());
     }
 }
 
 void
-WifiPhy::NotifyRxEnd (Ptr<const Packet> packet)
+WifiPhy::NotifyRxEnd (Ptr<const WifiPsdu> psdu)
 {
-  if (IsAmpdu (packet))
+  if (m_phyRxEndTrace.IsEmpty ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (packet);
-      for (auto & mpdu : mpdus)
-        {
-          m_phyRxEndTrace (mpdu);
-        }
+      return;
     }
-  else
+  for (auto& mpdu : *PeekPointer (psdu))
     {
-      m_phyRxEndTrace (packet);
+      m_phyRxEndTrace (mpdu->GetProtocolDataUnit ());
     }
 }
 
 void
-WifiPhy::NotifyRxDrop (Ptr<const Packet> packet)
+WifiPhy::NotifyRxDrop (Ptr<const WifiPsdu> psdu)
 {
-  if (IsAmpdu (packet))
+  if (m_phyRxDropTrace.IsEmpty ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (packet);
-      for (auto & mpdu : mpdus)
-        {
-          m_phyRxDropTrace (mpdu);
-        }
+      return;
     }
-  else
+  for (auto& mpdu : *PeekPointer (psdu))
     {
-      m_phyRxDropTrace (packet);
+      m_phyRxDropTrace (mpdu->GetProtocolDataUnit ());
     }
 }
 
 void
-WifiPhy::NotifyMonitorSniffRx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector,
+WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector,
                                SignalNoiseDbm signalNoise, std::vector<bool> statusPerMpdu)
 {
   MpduInfo aMpdu;
@@ -2447,16 +2462,18 @@ WifiPhy::NotifyMonitorSniffRx (Ptr<const Packet> packet, uint16_t channelFreqMhz
     {
       //Expand A-MPDU
       aMpdu.mpduRefNumber = ++m_rxMpduReferenceNumber;
-      std::list<Ptr<const Packet>> ampduSubframes = MpduAggregator::PeekAmpduSubframes (packet);
-      size_t numberOfMpdus = ampduSubframes.size ();
+      if (m_phyMonitorSniffRxTrace.IsEmpty ())
+        {
+          return;
+        }
+      size_t numberOfMpdus = psdu->GetNMpdus ();
       NS_ABORT_MSG_IF (statusPerMpdu.size () != numberOfMpdus, "Should have one reception status per MPDU");
-      size_t i = 0;
       aMpdu.type = (numberOfMpdus == 1) ? SINGLE_MPDU: FIRST_MPDU_IN_AGGREGATE;
-      for (const auto & subframe : ampduSubframes)
+      for (size_t i = 0; i < numberOfMpdus; )
         {
           if (statusPerMpdu.at (i)) //packet received without error, hand over to sniffer
             {
-              m_phyMonitorSniffRxTrace (subframe, channelFreqMhz, txVector, aMpdu, signalNoise);
+              m_phyMonitorSniffRxTrace (psdu->GetAmpduSubframe (i), channelFreqMhz, txVector, aMpdu, signalNoise);
             }
           ++i;
           aMpdu.type = (i == (numberOfMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
@@ -2466,25 +2483,31 @@ WifiPhy::NotifyMonitorSniffRx (Ptr<const Packet> packet, uint16_t channelFreqMhz
     {
       aMpdu.type = NORMAL_MPDU;
       NS_ABORT_MSG_IF (statusPerMpdu.size () != 1, "Should have one reception status for normal MPDU");
-      m_phyMonitorSniffRxTrace (packet, channelFreqMhz, txVector, aMpdu, signalNoise);
+      if (m_phyMonitorSniffRxTrace.IsEmpty ())
+        {
+          return;
+        }
+      m_phyMonitorSniffRxTrace (psdu->GetPacket (), channelFreqMhz, txVector, aMpdu, signalNoise);
     }
 }
 
 void
-WifiPhy::NotifyMonitorSniffTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector)
+WifiPhy::NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector)
 {
   MpduInfo aMpdu;
   if (txVector.IsAggregation ())
     {
       //Expand A-MPDU
       aMpdu.mpduRefNumber = ++m_txMpduReferenceNumber;
-      std::list<Ptr<const Packet>> ampduSubframes = MpduAggregator::PeekAmpduSubframes (packet);
-      size_t numberOfMpdus = ampduSubframes.size ();
-      size_t i = 0;
+      if (m_phyMonitorSniffTxTrace.IsEmpty ())
+        {
+          return;
+        }
+      size_t numberOfMpdus = psdu->GetNMpdus ();
       aMpdu.type = (numberOfMpdus == 1) ? SINGLE_MPDU: FIRST_MPDU_IN_AGGREGATE;
-      for (const auto & subframe : ampduSubframes)
+      for (size_t i = 0; i < numberOfMpdus; )
         {
-          m_phyMonitorSniffTxTrace (subframe, channelFreqMhz, txVector, aMpdu);
+          m_phyMonitorSniffTxTrace (psdu->GetAmpduSubframe (i), channelFreqMhz, txVector, aMpdu);
           ++i;
           aMpdu.type = (i == (numberOfMpdus - 1)) ? LAST_MPDU_IN_AGGREGATE : MIDDLE_MPDU_IN_AGGREGATE;
         }
@@ -2492,7 +2515,11 @@ WifiPhy::NotifyMonitorSniffTx (Ptr<const Packet> packet, uint16_t channelFreqMhz
   else
     {
       aMpdu.type = NORMAL_MPDU;
-      m_phyMonitorSniffTxTrace (packet, channelFreqMhz, txVector, aMpdu);
+      if (m_phyMonitorSniffTxTrace.IsEmpty ())
+        {
+          return;
+        }
+      m_phyMonitorSniffTxTrace (psdu->GetPacket (), channelFreqMhz, txVector, aMpdu);
     }
 }
 
@@ -2503,9 +2530,9 @@ WifiPhy::NotifyEndOfHePreamble (HePreambleParameters params)
 }
 
 void
-WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector)
+WifiPhy::Send (Ptr<const WifiPsdu> psdu, WifiTxVector txVector)
 {
-  NS_LOG_FUNCTION (this << packet << txVector);
+  NS_LOG_FUNCTION (this << psdu << txVector);
   /* Transmission can happen if:
    *  - we are syncing on a packet. It is the responsibility of the
    *    MAC layer to avoid doing this but the PHY does nothing to
@@ -2522,11 +2549,11 @@ WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector)
   if (m_state->IsStateSleep ())
     {
       NS_LOG_DEBUG ("Dropping packet because in sleep mode");
-      NotifyTxDrop (packet);
+      NotifyTxDrop (psdu);
       return;
     }
 
-  Time txDuration = CalculateTxDuration (packet->GetSize (), txVector, GetFrequency ());
+  Time txDuration = CalculateTxDuration (psdu->GetSize (), txVector, GetFrequency ());
   NS_ASSERT (txDuration.IsStrictlyPositive ());
 
   if (m_endPreambleDetectionEvent.IsRunning ())
@@ -2555,27 +2582,25 @@ WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector)
       NS_LOG_DEBUG ("Transmitting without power restriction");
     }
 
-  NotifyTxBegin (packet, DbmToW (GetTxPowerForTransmission (txVector) + GetTxGain ()));
-  NotifyMonitorSniffTx (packet, GetFrequency (), txVector);
-  m_state->SwitchToTx (txDuration, packet, GetPowerDbm (txVector.GetTxPowerLevel ()), txVector);
+  NotifyTxBegin (psdu, DbmToW (GetTxPowerForTransmission (txVector) + GetTxGain ()));
+  NotifyMonitorSniffTx (psdu, GetFrequency (), txVector);
+  m_state->SwitchToTx (txDuration, psdu, GetPowerDbm (txVector.GetTxPowerLevel ()), txVector);
 
-  Ptr<Packet> newPacket = packet->Copy (); // obtain non-const Packet
-  WifiPhyTag oldtag;
-  newPacket->RemovePacketTag (oldtag);
   if (m_state->GetState () == WifiPhyState::OFF)
     {
       NS_LOG_DEBUG ("Transmission canceled because device is OFF");
       return;
     }
-  uint8_t isFrameComplete = 1;
+
+  //The MPDUs are not serialized: the PPDU carries copies of them, which share
+  //their payloads, so that the MAC may keep modifying the MPDUs it sent
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu->Copy (), txVector, txDuration);
   if (m_wifiRadioEnergyModel != 0 && m_wifiRadioEnergyModel->GetMaximumTimeInState (WifiPhyState::TX) < txDuration)
     {
-      isFrameComplete = 0;
+      ppdu->SetTruncatedTx ();
     }
-  WifiPhyTag tag (txVector, isFrameComplete);
-  newPacket->AddPacketTag (tag);
 
-  StartTx (newPacket, txVector, txDuration);
+  StartTx (ppdu);
 
   m_channelAccessRequested = false;
   m_powerRestricted = false;
@@ -2584,7 +2609,7 @@ WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector)
 void
 WifiPhy::StartReceiveHeader (Ptr<Event> event, Time rxDuration)
 {
-  NS_LOG_FUNCTION (this << event->GetPacket () << event->GetTxVector () << event << rxDuration);
+  NS_LOG_FUNCTION (this << event->GetPsdu () << event->GetTxVector () << event << rxDuration);
   NS_ASSERT (!IsStateRx ());
   NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
 
@@ -2595,7 +2620,7 @@ WifiPhy::StartReceiveHeader (Ptr<Event> event, Time rxDuration)
   if (!m_preambleDetectionModel || (m_preambleDetectionModel->IsPreambleDetected (snr, m_channelWidth)))
     {
       m_state->SwitchToRx (rxDuration);
-      NotifyRxBegin (event->GetPacket ());
+      NotifyRxBegin (event->GetPsdu ());
 
       WifiTxVector txVector = event->GetTxVector ();
       m_timeLastPreambleDetected = Simulator::Now ();
@@ -2619,7 +2644,7 @@ WifiPhy::StartReceiveHeader (Ptr<Event> event, Time rxDuration)
   else
     {
       NS_LOG_DEBUG ("Drop packet because PHY preamble detection failed");
-      NotifyRxDrop (event->GetPacket ());
+      NotifyRxDrop (event->GetPsdu ());
       m_plcpSuccess = false;
     }
 }
@@ -2627,7 +2652,7 @@ WifiPhy::StartReceiveHeader (Ptr<Event> event, Time rxDuration)
 void
 WifiPhy::ContinueReceiveHeader (Ptr<Event> event)
 {
-  NS_LOG_FUNCTION (this << event->GetPacket () << event->GetTxVector () << event);
+  NS_LOG_FUNCTION (this << event->GetPsdu () << event->GetTxVector () << event);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
 
@@ -2645,26 +2670,20 @@ WifiPhy::ContinueReceiveHeader (Ptr<Event> event)
   else //legacy PHY header reception failed
     {
       NS_LOG_DEBUG ("Drop packet because legacy PHY header reception failed");
-      NotifyRxDrop (event->GetPacket ());
+      NotifyRxDrop (event->GetPsdu ());
       m_plcpSuccess = false;
     }
 }
 
 void
-WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDuration)
+WifiPhy::StartReceivePreamble (Ptr<const WifiPpdu> ppdu, double rxPowerW)
 {
-  NS_LOG_FUNCTION (this << packet << rxPowerW << rxDuration);
-  WifiPhyTag tag;
-  bool found = packet->RemovePacketTag (tag);
-  if (!found)
-    {
-      NS_FATAL_ERROR ("Received Wi-Fi Signal with no WifiPhyTag");
-      return;
-    }
-
-  WifiTxVector txVector = tag.GetWifiTxVector ();
+  NS_LOG_FUNCTION (this << *ppdu << rxPowerW);
+  Ptr<const WifiPsdu> psdu = ppdu->GetPsdu ();
+  WifiTxVector txVector = ppdu->GetTxVector ();
+  Time rxDuration = ppdu->GetTxDuration ();
   Ptr<Event> event;
-  event = m_interference.Add (packet,
+  event = m_interference.Add (psdu,
                               txVector,
                               rxDuration,
                               rxPowerW);
@@ -2677,7 +2696,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
       return;
     }
 
-  if (tag.GetFrameComplete () == 0)
+  if (ppdu->IsTruncatedTx ())
     {
       NS_LOG_DEBUG ("Packet reception stopped because transmitter has been switched off");
       m_plcpSuccess = false;
@@ -2708,7 +2727,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
     {
     case WifiPhyState::SWITCHING:
       NS_LOG_DEBUG ("drop packet because of channel switching");
-      NotifyRxDrop (packet);
+      NotifyRxDrop (psdu);
       m_plcpSuccess = false;
       /*
        * Packets received on the upcoming channel are added to the event list
@@ -2740,7 +2759,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
         {
           NS_LOG_DEBUG ("Drop packet because already in Rx (power=" <<
                         rxPowerW << "W)");
-          NotifyRxDrop (packet);
+          NotifyRxDrop (psdu);
           if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
             {
               //that packet will be noise _after_ the reception of the
@@ -2753,7 +2772,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
     case WifiPhyState::TX:
       NS_LOG_DEBUG ("Drop packet because already in Tx (power=" <<
                     rxPowerW << "W)");
-      NotifyRxDrop (packet);
+      NotifyRxDrop (psdu);
       if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
         {
           //that packet will be noise _after_ the transmission of the
@@ -2768,7 +2787,7 @@ WifiPhy::StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDurat
       break;
     case WifiPhyState::SLEEP:
       NS_LOG_DEBUG ("Drop packet because in sleep mode");
-      NotifyRxDrop (packet);
+      NotifyRxDrop (psdu);
       m_plcpSuccess = false;
       break;
     default:
@@ -2795,7 +2814,7 @@ WifiPhy::MaybeCcaBusyDuration ()
 void
 WifiPhy::StartReceivePayload (Ptr<Event> event)
 {
-  NS_LOG_FUNCTION (this << event->GetPacket () << event->GetTxVector () << event);
+  NS_LOG_FUNCTION (this << event->GetPsdu () << event->GetTxVector () << event);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
   WifiMode txMode = event->GetTxVector ().GetMode ();
@@ -2828,20 +2847,20 @@ WifiPhy::StartReceivePayload (Ptr<Event> event)
       else //mode is not allowed
         {
           NS_LOG_DEBUG ("Drop packet because it was sent using an unsupported mode (" << txMode << ")");
-          NotifyRxDrop (event->GetPacket ());
+          NotifyRxDrop (event->GetPsdu ());
         }
     }
   else //plcp reception failed
     {
       NS_LOG_DEBUG ("Drop packet because non-legacy PHY header reception failed");
-      NotifyRxDrop (event->GetPacket ());
+      NotifyRxDrop (event->GetPsdu ());
     }
 }
 
 void
 WifiPhy::EndReceive (Ptr<Event> event, Time psduDuration)
 {
-  NS_LOG_FUNCTION (this << event->GetPacket () << event->GetTxVector () << event << psduDuration);
+  NS_LOG_FUNCTION (this << event->GetPsdu () << event->GetTxVector () << event << psduDuration);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
 
@@ -2849,7 +2868,7 @@ WifiPhy::EndReceive (Ptr<Event> event, Time psduDuration)
   std::vector<bool> statusPerMpdu;
   SignalNoiseDbm signalNoise;
 
-  Ptr<const Packet> packet = event->GetPacket ();
+  Ptr<const WifiPsdu> psdu = event->GetPsdu ();
   Time relativeStart = NanoSeconds (0);
   if (m_plcpSuccess == true)
     {
@@ -2858,24 +2877,23 @@ WifiPhy::EndReceive (Ptr<Event> event, Time psduDuration)
       WifiTxVector txVector = event->GetTxVector ();
       if (txVector.IsAggregation ())
         {
-          //Extract all MPDUs of the A-MPDU to compute per-MPDU PER stats
-          //TODO remove PLCP header first
-          std::list<Ptr<const Packet>> ampduSubframes = MpduAggregator::PeekAmpduSubframes (packet);
-          size_t nbOfRemainingMpdus = ampduSubframes.size ();
+          //Go through all MPDUs of the A-MPDU to compute per-MPDU PER stats
+          size_t nbOfRemainingMpdus = psdu->GetNMpdus ();
           Time remainingAmpduDuration = psduDuration;
 
           MpduType mpdutype = (nbOfRemainingMpdus == 1) ? SINGLE_MPDU : FIRST_MPDU_IN_AGGREGATE;
-          for (const auto & subframe : ampduSubframes)
+          std::size_t i = 0;
+          for (const auto & mpdu : *PeekPointer (psdu))
             {
-              Time mpduDuration = GetPayloadDuration (subframe->GetSize (), txVector, GetFrequency (), mpdutype, 1);
+              Time mpduDuration = GetPayloadDuration (psdu->GetAmpduSubframeSize (i++), txVector, GetFrequency (), mpdutype, 1);
               remainingAmpduDuration -= mpduDuration;
               --nbOfRemainingMpdus;
               if (nbOfRemainingMpdus == 0 && !remainingAmpduDuration.IsZero ()) //no more MPDU coming
                 {
                   mpduDuration += remainingAmpduDuration; //apply a correction just in case rounding had induced slight shift
                 }
-              rxInfo = GetReceptionStatus (MpduAggregator::PeekMpduInAmpduSubframe (subframe), event, relativeStart, mpduDuration);
-              NS_LOG_DEBUG ("Extracted MPDU #" << ampduSubframes.size () - nbOfRemainingMpdus - 1 << ": duration: " << mpduDuration.GetNanoSeconds () << "ns" <<
+              rxInfo = GetReceptionStatus (Create<WifiPsdu> (mpdu, false), event, relativeStart, mpduDuration);
+              NS_LOG_DEBUG ("Extracted MPDU #" << psdu->GetNMpdus () - nbOfRemainingMpdus - 1 << ": duration: " << mpduDuration.GetNanoSeconds () << "ns" <<
                             ", correct reception: " << rxInfo.first <<
                             ", Signal/Noise: " << rxInfo.second.signal << "/" << rxInfo.second.noise << "dBm");
               signalNoise = rxInfo.second; //same information for all MPDUs
@@ -2889,7 +2907,7 @@ WifiPhy::EndReceive (Ptr<Event> event, Time psduDuration)
       else
         {
           //Simple MPDU
-          rxInfo = GetReceptionStatus (packet, event, relativeStart, psduDuration);
+          rxInfo = GetReceptionStatus (psdu, event, relativeStart, psduDuration);
           signalNoise = rxInfo.second; //same information for all MPDUs
           statusPerMpdu.push_back (rxInfo.first);
           receptionOkAtLeastForOneMpdu = rxInfo.first;
@@ -2897,18 +2915,18 @@ WifiPhy::EndReceive (Ptr<Event> event, Time psduDuration)
 
       if (receptionOkAtLeastForOneMpdu)
         {
-          NotifyMonitorSniffRx (packet, GetFrequency (), txVector, signalNoise, statusPerMpdu);
-          m_state->SwitchFromRxEndOk (packet->Copy (), snr, txVector, statusPerMpdu);
+          NotifyMonitorSniffRx (psdu, GetFrequency (), txVector, signalNoise, statusPerMpdu);
+          m_state->SwitchFromRxEndOk (psdu, snr, txVector, statusPerMpdu);
         }
       else
         {
-          m_state->SwitchFromRxEndError (packet->Copy (), snr);
+          m_state->SwitchFromRxEndError (psdu, snr);
         }
     }
   else
     {
       /* failure of whole PSDU because of PLCP preamble/header error */
-      m_state->SwitchFromRxEndError (packet->Copy (), snr);
+      m_state->SwitchFromRxEndError (psdu, snr);
     }
 
   m_interference.NotifyRxEnd ();
@@ -2918,14 +2936,14 @@ WifiPhy::EndReceive (Ptr<Event> event, Time psduDuration)
 }
 
 std::pair<bool, SignalNoiseDbm>
-WifiPhy::GetReceptionStatus (Ptr<const Packet> mpdu, Ptr<Event> event, Time relativeMpduStart, Time mpduDuration)
+WifiPhy::GetReceptionStatus (Ptr<const WifiPsdu> psdu, Ptr<Event> event, Time relativeMpduStart, Time mpduDuration)
 {
-  NS_LOG_FUNCTION (this << mpdu << event->GetTxVector () << event << relativeMpduStart << mpduDuration);
+  NS_LOG_FUNCTION (this << psdu << event->GetTxVector () << event << relativeMpduStart << mpduDuration);
   InterferenceHelper::SnrPer snrPer;
   snrPer = m_interference.CalculatePayloadSnrPer (event, std::make_pair (relativeMpduStart, relativeMpduStart + mpduDuration));
 
   NS_LOG_DEBUG ("mode=" << (event->GetTxVector ().GetMode ().GetDataRate (event->GetTxVector ())) <<
-                ", snr(dB)=" << RatioToDb (snrPer.snr) << ", per=" << snrPer.per << ", size=" << mpdu->GetSize () <<
+                ", snr(dB)=" << RatioToDb (snrPer.snr) << ", per=" << snrPer.per << ", size=" << psdu->GetSize () <<
                 ", relativeStart = " << relativeMpduStart.GetNanoSeconds () << "ns, duration = " << mpduDuration.GetNanoSeconds () << "ns");
 
   // There are two error checks: PER and receive error model check.
@@ -2936,16 +2954,16 @@ WifiPhy::GetReceptionStatus (Ptr<const Packet> mpdu, Ptr<Event> event, Time rela
   signalNoise.signal = WToDbm (event->GetRxPowerW ());
   signalNoise.noise = WToDbm (event->GetRxPowerW () / snrPer.snr);
   if (m_random->GetValue () > snrPer.per &&
-      !(m_postReceptionErrorModel && m_postReceptionErrorModel->IsCorrupt (mpdu->Copy ())))
+      !(m_postReceptionErrorModel && m_postReceptionErrorModel->IsCorrupt (psdu->GetPacket ()->Copy ())))
     {
-      NS_LOG_DEBUG ("Reception succeeded: " << mpdu->ToString ());
-      NotifyRxEnd (mpdu);
+      NS_LOG_DEBUG ("Reception succeeded: " << psdu->GetPacket ()->ToString ());
+      NotifyRxEnd (psdu);
       return std::make_pair (true, signalNoise);
     }
   else
     {
-      NS_LOG_DEBUG ("Reception failed: " << mpdu->ToString ());
-      NotifyRxDrop (mpdu);
+      NS_LOG_DEBUG ("Reception failed: " << psdu->GetPacket ()->ToString ());
+      NotifyRxDrop (psdu);
       return std::make_pair (false, signalNoise);
     }
 }
@@ -3993,7 +4011,7 @@ WifiPhy::AbortCurrentReception ()
     {
       m_endRxEvent.Cancel ();
     }
-  NotifyRxDrop (m_currentEvent->GetPacket ());
+  NotifyRxDrop (m_currentEvent->GetPsdu ());
   m_interference.NotifyRxEnd ();
   m_state->SwitchFromRxAbort ();
   m_currentEvent = 0;
@@ -4036,7 +4054,7 @@ WifiPhy::GetTxPowerForTransmission (WifiTxVector txVector) const
 void
 WifiPhy::StartRx (Ptr<Event> event, double rxPowerW, Time rxDuration)
 {
-  NS_LOG_FUNCTION (this << event->GetPacket () << event->GetTxVector () << event << rxPowerW << rxDuration);
+  NS_LOG_FUNCTION (this << event->GetPsdu () << event->GetTxVector () << event << rxPowerW << rxDuration);
 
   NS_LOG_DEBUG ("sync to signal (power=" << rxPowerW << "W)");
   m_interference.NotifyRxStart (); //We need to notify it now so that it starts recording events
@@ -4051,7 +4069,7 @@ WifiPhy::StartRx (Ptr<Event> event, double rxPowerW, Time rxDuration)
   else if ((m_frameCaptureModel != 0) && (rxPowerW > m_currentEvent->GetRxPowerW ()))
     {
       NS_LOG_DEBUG ("Received a stronger signal during preamble detection: drop current packet and switch to new packet");
-      NotifyRxDrop (m_currentEvent->GetPacket ());
+      NotifyRxDrop (m_currentEvent->GetPsdu ());
       m_interference.NotifyRxEnd ();
       m_endPreambleDetectionEvent.Cancel ();
       m_plcpSuccess = false;
@@ -4064,7 +4082,7 @@ WifiPhy::StartRx (Ptr<Event> event, double rxPowerW, Time rxDuration)
   else
     {
       NS_LOG_DEBUG ("Drop packet because RX is already decoding preamble");
-      NotifyRxDrop (event->GetPacket ());
+      NotifyRxDrop (event->GetPsdu ());
     }
   m_currentEvent = event;
 }
@@ -29,6 +29,8 @@
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
 #include "wifi-phy-state-helper.h"
+#include <map>
+#include <tuple>
 
 namespace ns3 {
 
@@ -44,6 +46,8 @@ class FrameCaptureModel;
 class PreambleDetectionModel;
 class WifiRadioEnergyModel;
 class UniformRandomVariable;
+class WifiPsdu;
+class WifiPpdu;
 
 /// SignalNoiseDbm structure
 struct SignalNoiseDbm
@@ -122,13 +126,12 @@ public:
   void SetCapabilitiesChangedCallback (Callback<void> callback);
 
   /**
-   * Start receiving the PHY preamble of a packet (i.e. the first bit of the preamble has arrived).
+   * Start receiving the PHY preamble of a PPDU (i.e. the first bit of the preamble has arrived).
    *
-   * \param packet the arriving packet
+   * \param ppdu the arriving PPDU, which may be shared with the other receivers
    * \param rxPowerW the receive power in W
-   * \param rxDuration the duration needed for the reception of the packet
    */
-  void StartReceivePreamble (Ptr<Packet> packet, double rxPowerW, Time rxDuration);
+  void StartReceivePreamble (Ptr<const WifiPpdu> ppdu, double rxPowerW);
 
   /**
    * Start receiving the PHY header of a packet (i.e. after the end of receiving the preamble).
@@ -167,21 +170,17 @@ public:
   void EndReceiveInterBss (void);
 
   /**
-   * \param packet the packet to send
+   * \param psdu the PSDU to send
    * \param txVector the TXVECTOR that has tx parameters such as mode, the transmission mode to use to send
-   *        this packet, and txPowerLevel, a power level to use to send this packet. The real transmission
+   *        this PSDU, and txPowerLevel, a power level to use to send this PSDU. The real transmission
    *        power is calculated as txPowerMin + txPowerLevel * (txPowerMax - txPowerMin) / nTxLevels
    */
-  void SendPacket (Ptr<const Packet> packet, WifiTxVector txVector);
+  void Send (Ptr<const WifiPsdu> psdu, WifiTxVector txVector);
 
   /**
-   * \param packet the packet to send
-   * \param txVector the TXVECTOR that has tx parameters such as mode, the transmission mode to use to send
-   *        this packet, and txPowerLevel, a power level to use to send this packet. The real transmission
-   *        power is calculated as txPowerMin + txPowerLevel * (txPowerMax - txPowerMin) / nTxLevels
-   * \param txDuration duration of the transmission.
+   * \param ppdu the PPDU to send, holding the PSDU, the TXVECTOR and the duration of the transmission
    */
-  virtual void StartTx (Ptr<Packet> packet, WifiTxVector txVector, Time txDuration) = 0;
+  virtual void StartTx (Ptr<WifiPpdu> ppdu) = 0;
 
   /**
    * Put in sleep mode.
@@ -358,6 +357,31 @@ public:
   Time GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t frequency,
                            MpduType mpdutype, uint8_t incFlag);
 
+  /**
+   * The parameters of the duration of the PPDUs sent with a TXVECTOR,
+   * which do not depend on the size of the PPDU.
+   */
+  struct TxDurationParameters
+  {
+    Time preambleAndHeader;      ///< the duration of the PLCP preamble and PLCP header
+    Time symbolDuration;         ///< the duration of an OFDM symbol of the payload
+    double stbc;                 ///< 2 if STBC is used for a HT or VHT payload, 1 otherwise
+    double nes;                  ///< the number of BCC encoders
+    double numDataBitsPerSymbol; ///< the number of data bits per OFDM symbol
+    uint64_t dsssDataRate;       ///< the data rate of a DSSS or HR/DSSS payload (bps)
+  };
+
+  /**
+   * Compute the parameters of the duration of the PPDUs sent with a TXVECTOR.
+   * CalculateTxDuration and GetPayloadDuration use a copy of these
+   * parameters, computed the first time a TXVECTOR is used.
+   *
+   * \param txVector the TXVECTOR used for the transmission of the PPDUs
+   *
+   * \return the parameters of the duration of the PPDUs
+   */
+  static TxDurationParameters CalculateTxDurationParameters (WifiTxVector txVector);
+
   /**
    * The WifiPhy::GetNModes() and WifiPhy::GetMode() methods are used
    * (e.g., by a WifiRemoteStationManager) to determine the set of
@@ -1085,57 +1109,64 @@ public:
   static WifiMode GetHeMcs11 ();
 
   /**
-   * Public method used to fire a PhyTxBegin trace.
+   * Public method used to fire a PhyTxBegin trace for each MPDU of the PSDU.
    * Implemented for encapsulation purposes.
+   * The MPDUs are only serialized if the trace is connected.
    *
-   * \param packet the packet being transmitted
+   * \param psdu the PSDU being transmitted
    * \param txPowerW the transmit power in Watts
    */
-  void NotifyTxBegin (Ptr<const Packet> packet, double txPowerW);
+  void NotifyTxBegin (Ptr<const WifiPsdu> psdu, double txPowerW);
   /**
-   * Public method used to fire a PhyTxEnd trace.
+   * Public method used to fire a PhyTxEnd trace for each MPDU of the PSDU.
    * Implemented for encapsulation purposes.
+   * The MPDUs are only serialized if the trace is connected.
    *
-   * \param packet the packet that was transmitted
+   * \param psdu the PSDU that was transmitted
    */
-  void NotifyTxEnd (Ptr<const Packet> packet);
+  void NotifyTxEnd (Ptr<const WifiPsdu> psdu);
   /**
-   * Public method used to fire a PhyTxDrop trace.
+   * Public method used to fire a PhyTxDrop trace for each MPDU of the PSDU.
    * Implemented for encapsulation purposes.
+   * The MPDUs are only serialized if the trace is connected.
    *
-   * \param packet the packet that was failed to transmitted
+   * \param psdu the PSDU that was failed to transmitted
    */
-  void NotifyTxDrop (Ptr<const Packet> packet);
+  void NotifyTxDrop (Ptr<const WifiPsdu> psdu);
   /**
-   * Public method used to fire a PhyRxBegin trace.
+   * Public method used to fire a PhyRxBegin trace for each MPDU of the PSDU.
    * Implemented for encapsulation purposes.
+   * The MPDUs are only serialized if the trace is connected.
    *
-   * \param packet the packet being received
+   * \param psdu the PSDU being received
    */
-  void NotifyRxBegin (Ptr<const Packet> packet);
+  void NotifyRxBegin (Ptr<const WifiPsdu> psdu);
   /**
-   * Public method used to fire a PhyRxEnd trace.
+   * Public method used to fire a PhyRxEnd trace for each MPDU of the PSDU.
    * Implemented for encapsulation purposes.
+   * The MPDUs are only serialized if the trace is connected.
    *
-   * \param packet the packet received
+   * \param psdu the PSDU received
    */
-  void NotifyRxEnd (Ptr<const Packet> packet);
+  void NotifyRxEnd (Ptr<const WifiPsdu> psdu);
   /**
-   * Public method used to fire a PhyRxDrop trace.
+   * Public method used to fire a PhyRxDrop trace for each MPDU of the PSDU.
    * Implemented for encapsulation purposes.
+   * The MPDUs are only serialized if the trace is connected.
    *
-   * \param packet the packet that was not successfully received
+   * \param psdu the PSDU that was not successfully received
    */
-  void NotifyRxDrop (Ptr<const Packet> packet);
+  void NotifyRxDrop (Ptr<const WifiPsdu> psdu);
 
   /**
-   * Public method used to fire a MonitorSniffer trace for a wifi packet being received.
+   * Public method used to fire a MonitorSniffer trace for a wifi PSDU being received.
    * Implemented for encapsulation purposes.
-   * This method will extract all MPDUs if packet is an A-MPDU and will fire tracedCallback.
+   * This method will serialize each A-MPDU subframe if the PSDU is an A-MPDU and will fire
+   * tracedCallback. Nothing is serialized if the trace is not connected.
    * The A-MPDU reference number (RX side) is set within the method. It must be a different value
    * for each A-MPDU but the same for each subframe within one A-MPDU.
    *
-   * \param packet the packet being received
+   * \param psdu the PSDU being received
    * \param channelFreqMhz the frequency in MHz at which the packet is
    *        received. Note that in real devices this is normally the
    *        frequency to which  the receiver is tuned, and this can be
@@ -1147,7 +1178,7 @@ public:
    * \param signalNoise signal power and noise power in dBm (noise power includes the noise figure)
    * \param statusPerMpdu reception status per MPDU
    */
-  void NotifyMonitorSniffRx (Ptr<const Packet> packet,
+  void NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu,
                              uint16_t channelFreqMhz,
                              WifiTxVector txVector,
                              SignalNoiseDbm signalNoise,
@@ -1179,18 +1210,19 @@ public:
                                             SignalNoiseDbm signalNoise);
 
   /**
-   * Public method used to fire a MonitorSniffer trace for a wifi packet being transmitted.
+   * Public method used to fire a MonitorSniffer trace for a wifi PSDU being transmitted.
    * Implemented for encapsulation purposes.
-   * This method will extract all MPDUs if packet is an A-MPDU and will fire tracedCallback.
+   * This method will serialize each A-MPDU subframe if the PSDU is an A-MPDU and will fire
+   * tracedCallback. Nothing is serialized if the trace is not connected.
    * The A-MPDU reference number (RX side) is set within the method. It must be a different value
    * for each A-MPDU but the same for each subframe within one A-MPDU.
    *
-   * \param packet the packet being transmitted
+   * \param psdu the PSDU being transmitted
    * \param channelFreqMhz the frequency in MHz at which the packet is
    *        transmitted.
    * \param txVector the TXVECTOR that holds tx parameters
    */
-  void NotifyMonitorSniffTx (Ptr<const Packet> packet,
+  void NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu,
                              uint16_t channelFreqMhz,
                              WifiTxVector txVector);
 
@@ -1718,14 +1750,14 @@ private:
   /**
    * Get the reception status for the provided MPDU and notify.
    *
-   * \param mpdu the arriving MPDU
+   * \param psdu the arriving MPDU formatted as a PSDU
    * \param event the corresponding event of the first time the packet arrives (also storing packet and TxVector information)
    * \param relativeMpduStart the relative start time of the MPDU within the A-MPDU. 0 for normal MPDUs
    * \param mpduDuration the duration of the MPDU
    *
    * \return information on MPDU reception: status, signal power (dBm), and noise power (in dBm)
    */
-  std::pair<bool, SignalNoiseDbm> GetReceptionStatus (Ptr<const Packet> mpdu,
+  std::pair<bool, SignalNoiseDbm> GetReceptionStatus (Ptr<const WifiPsdu> psdu,
                                                       Ptr<Event> event,
                                                       Time relativeMpduStart,
                                                       Time mpduDuration);
@@ -1890,6 +1922,37 @@ private:
   uint8_t               m_channelNumber;            //!< Operating channel number
   uint8_t               m_initialChannelNumber;     //!< Initial channel number
 
+  /**
+   * Get the parameters of the duration of the PPDUs sent with a TXVECTOR,
+   * and compute them if the TXVECTOR has not been used yet.
+   *
+   * \param txVector the TXVECTOR used for the transmission of the PPDUs
+   *
+   * \return the parameters of the duration of the PPDUs
+   */
+  const TxDurationParameters & GetTxDurationParameters (WifiTxVector txVector);
+  /**
+   * \param size the number of bytes in the packet to send
+   * \param payloadMode the mode of the payload
+   * \param params the parameters of the duration of the PPDU
+   * \param frequency the channel center frequency (MHz)
+   * \param mpdutype the type of the MPDU as defined in WifiPhy::MpduType.
+   * \param incFlag this flag is used to indicate that the static variables need to be update or not.
+   *
+   * \return the duration of the payload
+   */
+  Time GetPayloadDuration (uint32_t size, WifiMode payloadMode, const TxDurationParameters &params,
+                           uint16_t frequency, MpduType mpdutype, uint8_t incFlag);
+
+  /**
+   * The UID of the mode, the preamble type, the channel width, the guard
+   * interval, the number of spatial streams, the number of extension
+   * spatial streams and the use of STBC of a TXVECTOR, on which the
+   * durations of the PPDUs depend.
+   */
+  typedef std::tuple<uint32_t, uint8_t, uint16_t, uint16_t, uint8_t, uint8_t, bool> TxDurationKey;
+  std::map<TxDurationKey, TxDurationParameters> m_txDurationParameters; //!< the parameters of the duration of the PPDUs of each TXVECTOR used
+
   Time m_channelSwitchDelay;     //!< Time required to switch between channel
   uint32_t m_totalAmpduSize;     //!< Total size of the previously transmitted MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
   double m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "wifi-ppdu.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiPpdu");
+
+WifiPpdu::WifiPpdu (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time txDuration)
+  : m_psdu (psdu),
+    m_txVector (txVector),
+    m_txDuration (txDuration),
+    m_truncatedTx (false)
+{
+  NS_LOG_FUNCTION (this << psdu << txVector << txDuration);
+}
+
+WifiPpdu::~WifiPpdu ()
+{
+}
+
+Ptr<const WifiPsdu>
+WifiPpdu::GetPsdu (void) const
+{
+  return m_psdu;
+}
+
+WifiTxVector
+WifiPpdu::GetTxVector (void) const
+{
+  return m_txVector;
+}
+
+Time
+WifiPpdu::GetTxDuration (void) const
+{
+  return m_txDuration;
+}
+
+void
+WifiPpdu::SetTruncatedTx (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_truncatedTx = true;
+}
+
+bool
+WifiPpdu::IsTruncatedTx (void) const
+{
+  return m_truncatedTx;
+}
+
+Ptr<WifiPpdu>
+WifiPpdu::DeepCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<WifiPpdu> copy = Create<WifiPpdu> (m_psdu->DeepCopy (), m_txVector, m_txDuration);
+  copy->m_truncatedTx = m_truncatedTx;
+  return copy;
+}
+
+void
+WifiPpdu::Print (std::ostream& os) const
+{
+  os << "size=" << m_psdu->GetSize ()
+     << ", nMpdus=" << m_psdu->GetNMpdus ()
+     << ", duration=" << m_txDuration.GetMicroSeconds () << "us"
+     << ", truncatedTx=" << (m_truncatedTx ? "Y" : "N")
+     << ", " << m_txVector;
+}
+
+std::ostream & operator << (std::ostream &os, const WifiPpdu &ppdu)
+{
+  ppdu.Print (os);
+  return os;
+}
+
+} //namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_PPDU_H
+#define WIFI_PPDU_H
+
+#include "ns3/nstime.h"
+#include "wifi-tx-vector.h"
+#include "wifi-psdu.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * WifiPpdu is the signal carried by the channels from a WifiPhy to the
+ * others: the PSDU, the TXVECTOR it is sent with and the duration of the
+ * transmission.
+ *
+ * The PSDU is not serialized: the receivers share it and only build the
+ * bytes of its MPDUs and A-MPDU subframes when they are needed, e.g., by
+ * the connected PHY traces.
+ */
+class WifiPpdu : public SimpleRefCount<WifiPpdu>
+{
+public:
+  /**
+   * Create a PPDU.
+   *
+   * \param psdu the PSDU
+   * \param txVector the TXVECTOR the PSDU is sent with
+   * \param txDuration the duration of the transmission
+   */
+  WifiPpdu (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time txDuration);
+
+  virtual ~WifiPpdu ();
+
+  /**
+   * \return the PSDU
+   */
+  Ptr<const WifiPsdu> GetPsdu (void) const;
+
+  /**
+   * \return the TXVECTOR the PSDU is sent with
+   */
+  WifiTxVector GetTxVector (void) const;
+
+  /**
+   * \return the duration of the transmission
+   */
+  Time GetTxDuration (void) const;
+
+  /**
+   * Indicate that the transmitter stops before the end of the PPDU, e.g.,
+   * because its energy source is depleted.
+   */
+  void SetTruncatedTx (void);
+
+  /**
+   * \return true if the transmitter stops before the end of the PPDU
+   */
+  bool IsTruncatedTx (void) const;
+
+  /**
+   * Copy the PPDU, and the payloads of its MPDUs with Packet::DeepCopy,
+   * for a receiver which runs in another thread.
+   *
+   * \return the copy
+   */
+  Ptr<WifiPpdu> DeepCopy (void) const;
+
+  /**
+   * \brief Print the PPDU contents.
+   * \param os output stream in which the data should be printed.
+   */
+  void Print (std::ostream &os) const;
+
+private:
+  Ptr<const WifiPsdu> m_psdu; //!< the PSDU
+  WifiTxVector m_txVector;    //!< the TXVECTOR
+  Time m_txDuration;          //!< the duration of the transmission
+  bool m_truncatedTx;         //!< whether the transmitter stops before the end of the PPDU
+};
+
+/**
+ * \brief Stream insertion operator.
+ *
+ * \param os the stream
+ * \param ppdu the PPDU
+ * \returns a reference to the stream
+ */
+std::ostream& operator<< (std::ostream& os, const WifiPpdu &ppdu);
+
+} //namespace ns3
+
+#endif /* WIFI_PPDU_H */
@@ -111,6 +111,54 @@ WifiPsdu::GetPacket (void) const
   return packet;
 }
 
+Ptr<WifiPsdu>
+WifiPsdu::Copy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<WifiPsdu> copy = Create<WifiPsdu> (*this);
+  for (auto& mpdu : copy->m_mpduList)
+    {
+      mpdu = Create<WifiMacQueueItem> (*mpdu);
+    }
+  return copy;
+}
+
+Ptr<WifiPsdu>
+WifiPsdu::DeepCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<WifiPsdu> copy = Create<WifiPsdu> (*this);
+  for (auto& mpdu : copy->m_mpduList)
+    {
+      mpdu = Create<WifiMacQueueItem> (mpdu->GetPacket ()->DeepCopy (), mpdu->GetHeader (),
+                                       mpdu->GetTimeStamp ());
+    }
+  return copy;
+}
+
+Ptr<Packet>
+WifiPsdu::GetAmpduSubframe (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  NS_ASSERT (IsAggregate ());
+  Ptr<Packet> subframe = m_mpduList.at (i)->GetProtocolDataUnit ();
+  MpduAggregator::AddHeaderAndPad (subframe, i == m_mpduList.size () - 1, m_isSingle);
+  return subframe;
+}
+
+uint32_t
+WifiPsdu::GetAmpduSubframeSize (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  NS_ASSERT (IsAggregate ());
+  uint32_t size = 4 + m_mpduList.at (i)->GetSize (); // A-MPDU Subframe header size
+  if (i != m_mpduList.size () - 1)
+    {
+      size += MpduAggregator::CalculatePadding (size);
+    }
+  return size;
+}
+
 Mac48Address
 WifiPsdu::GetAddr1 (void) const
 {
@@ -36,6 +36,10 @@ class Packet;
  *
  * WifiPsdu stores an MPDU, S-MPDU or A-MPDU, by keeping header(s) and
  * payload(s) separate for each constituent MPDU.
+ *
+ * The PHY transmits the WifiPsdu itself (see WifiPpdu): the MPDUs are only
+ * serialized, with their A-MPDU subframe headers and padding, when their
+ * bytes are needed (GetPacket, GetAmpduSubframe).
  */
 class WifiPsdu : public SimpleRefCount<WifiPsdu>
 {
@@ -95,6 +99,37 @@ public:
    */
   Ptr<const Packet> GetPacket (void) const;
 
+  /**
+   * \brief Copy the PSDU, i.e., the MPDUs with their headers. The payloads
+   *        of the MPDUs are shared with this PSDU.
+   * \return the copy of the PSDU.
+   */
+  Ptr<WifiPsdu> Copy (void) const;
+
+  /**
+   * \brief Copy the PSDU and the payloads of its MPDUs, the latter with
+   *        Packet::DeepCopy, so that the copy can be used in another thread.
+   * \return the copy of the PSDU.
+   */
+  Ptr<WifiPsdu> DeepCopy (void) const;
+
+  /**
+   * \brief Get the i-th A-MPDU subframe, i.e., the A-MPDU subframe header,
+   *        the i-th MPDU and the padding, if the MPDU is not the last one.
+   *        The PSDU must be an S-MPDU or A-MPDU.
+   * \param i the index of the MPDU
+   * \return the i-th A-MPDU subframe.
+   */
+  Ptr<Packet> GetAmpduSubframe (std::size_t i) const;
+
+  /**
+   * \brief Get the size of the i-th A-MPDU subframe (see GetAmpduSubframe)
+   *        without serializing it
+   * \param i the index of the MPDU
+   * \return the size of the i-th A-MPDU subframe.
+   */
+  uint32_t GetAmpduSubframeSize (std::size_t i) const;
+
   /**
    * \brief Get the header of the i-th MPDU
    * \return the header of the i-th MPDU.
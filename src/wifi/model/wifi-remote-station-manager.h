@@ -31,6 +31,7 @@
 #include "ht-capabilities.h"
 #include "vht-capabilities.h"
 #include "he-capabilities.h"
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -1317,6 +1318,21 @@ private:
   StationStates m_states;  //!< States of known stations
   Stations m_stations;     //!< Information for each known stations
 
+  /**
+   * The state and the stations of a remote station address.
+   */
+  struct StationIndexEntry
+  {
+    WifiRemoteStationState *state; //!< The state of the remote station
+    Stations stations;             //!< The stations of the remote station, one per TID
+  };
+  /**
+   * An index of the known stations by address, so that LookupState() and
+   * Lookup() do not scan all of them.
+   */
+  typedef std::unordered_map<Mac48Address, StationIndexEntry, Mac48AddressHash> StationIndex;
+  StationIndex m_stationIndex; //!< The known stations, by address
+
   WifiMode m_defaultTxMode; //!< The default transmission mode
   WifiMode m_defaultTxMcs;   //!< The default transmission modulation-coding scheme (MCS)
 
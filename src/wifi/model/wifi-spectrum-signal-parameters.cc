@@ -20,8 +20,8 @@
  */
 
 #include "ns3/log.h"
-#include "ns3/packet.h"
 #include "wifi-spectrum-signal-parameters.h"
+#include "wifi-ppdu.h"
 
 namespace ns3 {
 
@@ -36,7 +36,7 @@ WifiSpectrumSignalParameters::WifiSpectrumSignalParameters (const WifiSpectrumSi
   : SpectrumSignalParameters (p)
 {
   NS_LOG_FUNCTION (this << &p);
-  packet = p.packet;
+  ppdu = p.ppdu;
 }
 
 Ptr<SpectrumSignalParameters>
@@ -26,7 +26,7 @@
 
 namespace ns3 {
 
-class Packet;
+class WifiPpdu;
 
 /**
  * \ingroup wifi
@@ -52,9 +52,9 @@ struct WifiSpectrumSignalParameters : public SpectrumSignalParameters
   WifiSpectrumSignalParameters (const WifiSpectrumSignalParameters& p);
 
   /**
-   * The packet being transmitted with this signal
+   * The PPDU being transmitted with this signal
    */
-  Ptr<Packet> packet;
+  Ptr<WifiPpdu> ppdu;
 };
 
 }  // namespace ns3
@@ -22,6 +22,8 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -29,8 +31,9 @@ class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
-class Packet;
+class WifiPpdu;
 class Time;
+class MobilityModel;
 
 /**
  * \brief a channel to interconnect ns3::YansWifiPhy objects.
@@ -40,6 +43,25 @@ class Time;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * Send does not schedule the reception of a packet by the receivers
+ * whose received power is below their RX sensitivity, since they
+ * would drop it.  When the MaxRange attribute is set, the channel
+ * also keeps a uniform grid of the positions of the receivers, updated
+ * when their mobility models notify a course change, and Send skips
+ * the receivers further than MaxRange from the sender before computing
+ * the propagation loss.  The receivers with a non-zero velocity are not
+ * put in the grid but checked on each transmission.  The mobility models
+ * of the receivers are looked up on each transmission, so they can be
+ * replaced at any time.
+ *
+ * With a ns3::MultithreadedSimulatorImpl, which requires ns-3 to be
+ * configured with --enable-atomic-refcount, Send runs in the thread of the
+ * sender and hands a WifiPpdu::DeepCopy over to the receivers of the other
+ * partitions (see Simulator::IsConcurrent).  It reads the position and
+ * the configuration of all the receivers, so their mobility models and
+ * the propagation models must not change while the simulation runs, and
+ * the MaxRange grid, which the senders update, must not be used.
  */
 class YansWifiChannel : public Channel
 {
@@ -75,16 +97,15 @@ public:
 
   /**
    * \param sender the phy object from which the packet is originating.
-   * \param packet the packet to send
-   * \param txPowerDbm the tx power associated to the packet, in dBm
-   * \param duration the transmission duration associated with the packet
+   * \param ppdu the PPDU to send
+   * \param txPowerDbm the tx power associated to the PPDU, in dBm
    *
    * This method should not be invoked by normal users. It is
    * currently invoked only from YansWifiPhy::StartTx.  The channel
    * attempts to deliver the packet to all other YansWifiPhy objects
    * on the channel (except for the sender).
    */
-  void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
+  void Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm) const;
 
   /**
    * Assign a fixed random variable stream number to the random variables
@@ -97,12 +118,43 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \param maxRange the distance, in meters, beyond which receivers
+   *        are skipped, or 0 to consider all the receivers
+   */
+  void SetMaxRange (double maxRange);
+  /**
+   * \return the distance, in meters, beyond which receivers are skipped
+   */
+  double GetMaxRange (void) const;
+
 
 private:
+  virtual void DoDispose (void);
+
   /**
    * A vector of pointers to YansWifiPhy.
    */
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+  /**
+   * Deliver a packet to one receiver: compute the received power and
+   * the propagation delay, and schedule the reception if the received
+   * power is above the RX sensitivity of the receiver.
+   *
+   * \param sender the phy object from which the packet is originating
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the phy object to deliver the packet to
+   * \param ppdu the PPDU to send
+   * \param txPowerDbm the tx power associated to the PPDU, in dBm
+   */
+  void Deliver (Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu, double txPowerDbm) const;
+  /**
+   * \param senderMobility the mobility model of the sender
+   * \return the indexes in the PHY list of the receivers within
+   *         MaxRange of the sender, in increasing order
+   */
+  std::vector<uint32_t> GetReceiversInRange (Ptr<MobilityModel> senderMobility) const;
 
   /**
    * This method is scheduled by Send for each associated YansWifiPhy.
@@ -110,15 +162,18 @@ private:
    * bit of the packet has arrived.
    *
    * \param receiver the device to which the packet is destined
-   * \param packet the packet being sent
-   * \param txPowerDbm the tx power associated to the packet being sent (dBm)
-   * \param duration the transmission duration associated with the packet being sent
+   * \param ppdu the PPDU being sent
+   * \param txPowerDbm the tx power associated to the PPDU being sent (dBm)
    */
-  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<Packet> packet, double txPowerDbm, Time duration);
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Range beyond which receivers are skipped (m)
+
+  mutable MobilityGrid m_grid;         //!< The positions of the receivers, if MaxRange is set
+  mutable std::vector<Ptr<MobilityModel> > m_gridMobilities; //!< The model of each receiver in the grid
 };
 
 } //namespace ns3
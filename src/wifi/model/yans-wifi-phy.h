@@ -64,13 +64,11 @@ public:
   void SetChannel (const Ptr<YansWifiChannel> channel);
 
   /**
-   * \param packet the packet to send
-   * \param txVector the TXVECTOR that has tx parameters such as mode, the transmission mode to use to send
-   *        this packet, and txPowerLevel, a power level to use to send this packet. The real transmission
-   *        power is calculated as txPowerMin + txPowerLevel * (txPowerMax - txPowerMin) / nTxLevels
-   * \param txDuration duration of the transmission.
+   * \param ppdu the PPDU to send, whose TXVECTOR has tx parameters such as mode, the transmission mode
+   *        to use to send this PPDU, and txPowerLevel, a power level to use to send this PPDU. The real
+   *        transmission power is calculated as txPowerMin + txPowerLevel * (txPowerMax - txPowerMin) / nTxLevels
    */
-  void StartTx (Ptr<Packet> packet, WifiTxVector txVector, Time txDuration);
+  void StartTx (Ptr<WifiPpdu> ppdu);
 
   virtual Ptr<Channel> GetChannel (void) const;
 
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/packet.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/lookahead-helper.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Run an ad hoc network under the multithreaded simulator
+ *
+ * Two groups of nodes, 60 m apart, send unicast packets to each other
+ * over a YansWifiChannel, so that the nodes of different partitions
+ * exchange data frames and ACKs, and sense each other's transmissions.
+ * The receptions of each node, and the number of events, must be the
+ * same under the default and the multithreaded simulators, and the
+ * packet uids the same in two runs of the multithreaded simulator.
+ * The nodes take turns to transmit: simultaneous events of different
+ * partitions are not processed in the same order by both simulators,
+ * and would change the outcome of a contention for the channel.
+ */
+class MultithreadedWifiTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param threads The number of partitions of the multithreaded simulator.
+   */
+  MultithreadedWifiTestCase (uint32_t threads);
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  /// The receptions of a node
+  struct Receptions
+  {
+    uint32_t packets; //!< number of packets received
+    uint64_t bytes;   //!< number of bytes received
+    uint64_t time;    //!< sum of the reception times, in time steps
+    uint64_t uids;    //!< sum of the uids of the packets received
+  };
+
+  /**
+   * Run the scenario with a simulator implementation.
+   * \param simulatorType The simulator implementation.
+   * \return The number of events processed.
+   */
+  uint64_t RunScenario (std::string simulatorType);
+  /**
+   * Send a packet.
+   * \param device The sending device.
+   * \param destination The destination address.
+   * \param count The number of packets left to send.
+   */
+  void Send (Ptr<NetDevice> device, Address destination, uint32_t count);
+  /**
+   * Receive a packet.
+   * \param device The receiving device.
+   * \param packet The packet.
+   * \param protocol The protocol number.
+   * \param sender The sender address.
+   * \return true.
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &sender);
+
+  uint32_t m_threads;                   //!< The number of partitions
+  std::vector<Receptions> m_receptions; //!< Receptions of each node, only updated by its partition
+};
+
+/// The number of nodes in each group
+static const uint32_t N_NODES = 4;
+/// The number of packets sent by each node
+static const uint32_t N_PACKETS = 40;
+/// The interval between the packets of a node
+static const Time INTERVAL = MilliSeconds (20);
+
+MultithreadedWifiTestCase::MultithreadedWifiTestCase (uint32_t threads)
+  : TestCase ("Check a Wi-Fi network with " + std::to_string (threads) + " threads"),
+    m_threads (threads)
+{
+}
+
+void
+MultithreadedWifiTestCase::Send (Ptr<NetDevice> device, Address destination, uint32_t count)
+{
+  device->Send (Create<Packet> (500 + 10 * device->GetNode ()->GetId ()), destination, 0x88b5);
+  if (count > 1)
+    {
+      Simulator::Schedule (INTERVAL, &MultithreadedWifiTestCase::Send, this,
+                           device, destination, count - 1);
+    }
+}
+
+bool
+MultithreadedWifiTestCase::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                    uint16_t protocol, const Address &sender)
+{
+  Receptions &receptions = m_receptions[device->GetNode ()->GetId ()];
+  receptions.packets++;
+  receptions.bytes += packet->GetSize ();
+  receptions.time += Simulator::Now ().GetTimeStep ();
+  receptions.uids += packet->GetUid ();
+  return true;
+}
+
+uint64_t
+MultithreadedWifiTestCase::RunScenario (std::string simulatorType)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (m_threads));
+
+  NodeContainer nodes;
+  nodes.Create (2 * N_NODES);
+
+  // Even nodes on the left, odd nodes on the right
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < 2 * N_NODES; i++)
+    {
+      positions->Add (Vector ((i % 2) * 60.0 + (i / 2) * 3.0, (i / 2) * 2.0, 0.0));
+    }
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 0);
+
+  m_receptions.assign (2 * N_NODES, Receptions ());
+  for (uint32_t i = 0; i < 2 * N_NODES; i++)
+    {
+      devices.Get (i)->SetReceiveCallback (MakeCallback (&MultithreadedWifiTestCase::Receive, this));
+      // Send to the node at the same rank of the other group, in turn:
+      // a frame and its ACK take less than 1 ms.
+      Address destination = devices.Get (i ^ 1)->GetAddress ();
+      Simulator::ScheduleWithContext (i, MicroSeconds (100 + 2500 * i), &MultithreadedWifiTestCase::Send, this,
+                                      devices.Get (i), destination, N_PACKETS);
+    }
+
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      Time lookahead = LookaheadHelper::Calculate (MakeCallback (&MultithreadedSimulatorImpl::GetPartition, impl));
+      NS_TEST_EXPECT_MSG_GT (lookahead, Seconds (0), "The channel should give a lookahead");
+      impl->SetLookahead (lookahead);
+    }
+
+  Simulator::Run ();
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+  return events;
+}
+
+void
+MultithreadedWifiTestCase::DoRun (void)
+{
+  uint64_t referenceEvents = RunScenario ("ns3::DefaultSimulatorImpl");
+  std::vector<Receptions> reference = m_receptions;
+  uint64_t parallelEvents = RunScenario ("ns3::MultithreadedSimulatorImpl");
+  std::vector<Receptions> parallel = m_receptions;
+  RunScenario ("ns3::MultithreadedSimulatorImpl");
+  std::vector<Receptions> again = m_receptions;
+
+  NS_TEST_EXPECT_MSG_EQ (parallelEvents, referenceEvents, "Wrong number of events");
+  for (uint32_t i = 0; i < 2 * N_NODES; i++)
+    {
+      NS_TEST_EXPECT_MSG_GT (reference[i].packets, 0, "Node " << i << " should receive packets");
+      NS_TEST_EXPECT_MSG_EQ (parallel[i].packets, reference[i].packets, "Wrong number of packets for node " << i);
+      NS_TEST_EXPECT_MSG_EQ (parallel[i].bytes, reference[i].bytes, "Wrong number of bytes for node " << i);
+      NS_TEST_EXPECT_MSG_EQ (parallel[i].time, reference[i].time, "Wrong reception times for node " << i);
+      NS_TEST_EXPECT_MSG_EQ (again[i].uids, parallel[i].uids, "Packet uids not reproducible for node " << i);
+    }
+}
+
+void
+MultithreadedWifiTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Multithreaded simulator Wi-Fi test suite
+ */
+class MultithreadedWifiTestSuite : public TestSuite
+{
+public:
+  MultithreadedWifiTestSuite ();
+};
+
+MultithreadedWifiTestSuite::MultithreadedWifiTestSuite ()
+  : TestSuite ("multithreaded-wifi", UNIT)
+{
+  AddTestCase (new MultithreadedWifiTestCase (2), TestCase::QUICK);
+  AddTestCase (new MultithreadedWifiTestCase (4), TestCase::QUICK);
+}
+
+static MultithreadedWifiTestSuite g_multithreadedWifiTestSuite; ///< the test suite
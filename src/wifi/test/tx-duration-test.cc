@@ -19,6 +19,7 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/yans-wifi-phy.h"
@@ -43,6 +44,20 @@ public:
   virtual ~TxDurationTest ();
   virtual void DoRun (void);
 
+protected:
+  /**
+   * Constructor
+   *
+   * \param name the name of the test case
+   */
+  TxDurationTest (std::string name);
+  /**
+   * Check the durations of the PPDUs against the values computed by hand
+   * from the standards.
+   */
+  void CheckKnownDurations (void);
+
+  Ptr<YansWifiPhy> m_phy; ///< the PHY computing all the durations, if any
 
 private:
   /**
@@ -74,7 +89,12 @@ private:
    * @return true if values correspond, false otherwise
    */
   bool CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t channelWidth, uint16_t guardInterval, WifiPreamble preamble, Time knownDuration);
-
+  /**
+   * Get the PHY computing a duration.
+   *
+   * \return m_phy if set, a new PHY otherwise
+   */
+  Ptr<YansWifiPhy> GetPhy (void) const;
 };
 
 TxDurationTest::TxDurationTest ()
@@ -82,10 +102,25 @@ TxDurationTest::TxDurationTest ()
 {
 }
 
+TxDurationTest::TxDurationTest (std::string name)
+  : TestCase (name)
+{
+}
+
 TxDurationTest::~TxDurationTest ()
 {
 }
 
+Ptr<YansWifiPhy>
+TxDurationTest::GetPhy (void) const
+{
+  if (m_phy != 0)
+    {
+      return m_phy;
+    }
+  return CreateObject<YansWifiPhy> ();
+}
+
 bool
 TxDurationTest::CheckPayloadDuration (uint32_t size, WifiMode payloadMode, uint16_t channelWidth, uint16_t guardInterval, WifiPreamble preamble, Time knownDuration)
 {
@@ -98,7 +133,7 @@ TxDurationTest::CheckPayloadDuration (uint32_t size, WifiMode payloadMode, uint1
   txVector.SetStbc (0);
   txVector.SetNess (0);
   uint16_t testedFrequency = CHANNEL_1_MHZ;
-  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  Ptr<YansWifiPhy> phy = GetPhy ();
   if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
       || payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT
       || payloadMode.GetModulationClass () == WIFI_MOD_CLASS_VHT
@@ -153,7 +188,7 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t c
   txVector.SetStbc (0);
   txVector.SetNess (0);
   uint16_t testedFrequency = CHANNEL_1_MHZ;
-  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  Ptr<YansWifiPhy> phy = GetPhy ();
   if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
       || payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT
       || payloadMode.GetModulationClass () == WIFI_MOD_CLASS_VHT
@@ -200,6 +235,12 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t c
 
 void
 TxDurationTest::DoRun (void)
+{
+  CheckKnownDurations ();
+}
+
+void
+TxDurationTest::CheckKnownDurations (void)
 {
   bool retval = true;
 
@@ -426,6 +467,219 @@ TxDurationTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (retval, true, "an 802.11ax duration failed");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Tx Duration Parameters Cache Test
+ *
+ * WifiPhy computes the parameters of the durations of the PPDUs the first
+ * time a TXVECTOR is used.  This test computes the durations of the Wifi
+ * TX Duration test case, checked against the values computed by hand, twice
+ * with a single PHY, so that the second time all of them are computed from
+ * the cached parameters.  It then checks, for every mode and for each of its
+ * TXVECTORs, that the durations computed by a PHY which has seen all the
+ * TXVECTORs are the ones computed by a new PHY, so that no two TXVECTORs
+ * share their cached parameters.
+ */
+class TxDurationCacheTest : public TxDurationTest
+{
+public:
+  TxDurationCacheTest ();
+  virtual ~TxDurationCacheTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Check the durations of the PPDUs of a TXVECTOR.
+   *
+   * \param txVector the TXVECTOR
+   */
+  void Check (WifiTxVector txVector);
+  /**
+   * Compute the durations of PPDUs and A-MPDUs of several sizes.
+   *
+   * \param phy the PHY computing the durations
+   * \param txVector the TXVECTOR of the PPDUs
+   *
+   * \return the durations
+   */
+  std::vector<Time> GetDurations (Ptr<WifiPhy> phy, WifiTxVector txVector);
+};
+
+TxDurationCacheTest::TxDurationCacheTest ()
+  : TxDurationTest ("Wifi TX Duration cache")
+{
+}
+
+TxDurationCacheTest::~TxDurationCacheTest ()
+{
+}
+
+std::vector<Time>
+TxDurationCacheTest::GetDurations (Ptr<WifiPhy> phy, WifiTxVector txVector)
+{
+  std::vector<Time> durations;
+  uint16_t frequencies[] = {CHANNEL_1_MHZ, CHANNEL_36_MHZ};
+  uint32_t sizes[] = {1, 76, 1536, 65535};
+  for (uint16_t frequency : frequencies)
+    {
+      for (uint32_t size : sizes)
+        {
+          durations.push_back (phy->CalculateTxDuration (size, txVector, frequency));
+          durations.push_back (phy->GetPayloadDuration (size, txVector, frequency));
+          if (txVector.GetMode ().GetModulationClass () >= WIFI_MOD_CLASS_HT)
+            {
+              durations.push_back (phy->CalculateTxDuration (size, txVector, frequency, FIRST_MPDU_IN_AGGREGATE, 1));
+              durations.push_back (phy->CalculateTxDuration (size, txVector, frequency, MIDDLE_MPDU_IN_AGGREGATE, 1));
+              durations.push_back (phy->CalculateTxDuration (size, txVector, frequency, LAST_MPDU_IN_AGGREGATE, 1));
+            }
+        }
+    }
+  return durations;
+}
+
+void
+TxDurationCacheTest::Check (WifiTxVector txVector)
+{
+  std::vector<Time> expected = GetDurations (CreateObject<YansWifiPhy> (), txVector);
+  std::vector<Time> durations = GetDurations (m_phy, txVector);
+  NS_TEST_ASSERT_MSG_EQ (durations.size (), expected.size (), "Wrong number of durations");
+  for (std::size_t i = 0; i < durations.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (durations[i], expected[i], "Wrong duration " << i << " for " << txVector);
+    }
+  NS_TEST_ASSERT_MSG_EQ (WifiPhy::CalculateTxDurationParameters (txVector).preambleAndHeader,
+                         WifiPhy::CalculatePlcpPreambleAndHeaderDuration (txVector),
+                         "Wrong preamble and header duration for " << txVector);
+}
+
+void
+TxDurationCacheTest::DoRun (void)
+{
+  m_phy = CreateObject<YansWifiPhy> ();
+  CheckKnownDurations ();
+  CheckKnownDurations ();
+
+  std::vector<WifiMode> modes;
+  WifiPhyStandard standards[] = {WIFI_PHY_STANDARD_80211b, WIFI_PHY_STANDARD_80211g,
+                                 WIFI_PHY_STANDARD_80211_10MHZ, WIFI_PHY_STANDARD_80211_5MHZ,
+                                 WIFI_PHY_STANDARD_80211n_2_4GHZ, WIFI_PHY_STANDARD_80211n_5GHZ,
+                                 WIFI_PHY_STANDARD_80211ac, WIFI_PHY_STANDARD_80211ax_5GHZ};
+  for (WifiPhyStandard standard : standards)
+    {
+      Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+      phy->ConfigureStandard (standard);
+      for (uint8_t i = 0; i < phy->GetNModes () + phy->GetNMcs (); i++)
+        {
+          WifiMode mode = (i < phy->GetNModes ()) ? phy->GetMode (i) : phy->GetMcs (i - phy->GetNModes ());
+          if (std::find (modes.begin (), modes.end (), mode) == modes.end ())
+            {
+              modes.push_back (mode);
+            }
+        }
+    }
+
+  // m_phy keeps the parameters of all the TXVECTORs visited before the
+  // current one, which must not be used for it
+  for (const WifiMode &mode : modes)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (mode);
+      switch (mode.GetModulationClass ())
+        {
+        case WIFI_MOD_CLASS_DSSS:
+        case WIFI_MOD_CLASS_HR_DSSS:
+          txVector.SetChannelWidth (22);
+          for (WifiPreamble preamble : {WIFI_PREAMBLE_LONG, WIFI_PREAMBLE_SHORT})
+            {
+              txVector.SetPreambleType (preamble);
+              Check (txVector);
+            }
+          break;
+        case WIFI_MOD_CLASS_OFDM:
+        case WIFI_MOD_CLASS_ERP_OFDM:
+          txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+          for (uint16_t width : {20, 10, 5})
+            {
+              txVector.SetChannelWidth (width);
+              Check (txVector);
+            }
+          break;
+        case WIFI_MOD_CLASS_HT:
+          txVector.SetNss (1 + (mode.GetMcsValue () / 8));
+          for (WifiPreamble preamble : {WIFI_PREAMBLE_HT_MF, WIFI_PREAMBLE_HT_GF})
+            {
+              for (uint16_t width : {20, 40})
+                {
+                  for (uint16_t gi : {800, 400})
+                    {
+                      for (bool stbc : {false, true})
+                        {
+                          for (uint8_t ness = 0; ness < 2; ness++)
+                            {
+                              txVector.SetPreambleType (preamble);
+                              txVector.SetChannelWidth (width);
+                              txVector.SetGuardInterval (gi);
+                              txVector.SetStbc (stbc);
+                              txVector.SetNess (ness);
+                              Check (txVector);
+                            }
+                        }
+                    }
+                }
+            }
+          break;
+        case WIFI_MOD_CLASS_VHT:
+        case WIFI_MOD_CLASS_HE:
+          for (uint16_t width : {20, 40, 80, 160})
+            {
+              for (uint8_t nss = 1; nss <= 4; nss++)
+                {
+                  if (mode.GetModulationClass () == WIFI_MOD_CLASS_VHT)
+                    {
+                      if (!mode.IsAllowed (width, nss))
+                        {
+                          continue;
+                        }
+                      txVector.SetPreambleType (WIFI_PREAMBLE_VHT);
+                      for (uint16_t gi : {800, 400})
+                        {
+                          for (bool stbc : {false, true})
+                            {
+                              txVector.SetChannelWidth (width);
+                              txVector.SetNss (nss);
+                              txVector.SetGuardInterval (gi);
+                              txVector.SetStbc (stbc);
+                              Check (txVector);
+                            }
+                        }
+                    }
+                  else
+                    {
+                      for (WifiPreamble preamble : {WIFI_PREAMBLE_HE_SU, WIFI_PREAMBLE_HE_ER_SU, WIFI_PREAMBLE_HE_MU})
+                        {
+                          for (uint16_t gi : {3200, 1600, 800})
+                            {
+                              txVector.SetPreambleType (preamble);
+                              txVector.SetChannelWidth (width);
+                              txVector.SetNss (nss);
+                              txVector.SetGuardInterval (gi);
+                              Check (txVector);
+                            }
+                        }
+                    }
+                }
+            }
+          break;
+        default:
+          NS_FATAL_ERROR ("Unexpected modulation class");
+          break;
+        }
+    }
+  m_phy = 0;
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -442,6 +696,7 @@ TxDurationTestSuite::TxDurationTestSuite ()
   : TestSuite ("devices-wifi-tx-duration", UNIT)
 {
   AddTestCase (new TxDurationTest, TestCase::QUICK);
+  AddTestCase (new TxDurationCacheTest, TestCase::QUICK);
 }
 
 static TxDurationTestSuite g_txDurationTestSuite; ///< the test suite
@@ -21,8 +21,11 @@
 #include <cmath>
 #include "ns3/test.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
 #include "ns3/dsss-error-rate-model.h"
+#include "ns3/table-based-error-rate-model.h"
 #include "ns3/wifi-tx-vector.h"
+#include "ns3/wifi-phy.h"
 
 using namespace ns3;
 
@@ -291,6 +294,119 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case Table Based
+ *
+ * Compare the chunk success rates of the TableBasedErrorRateModel to the
+ * ones of its NIST and YANS reference models, over the SNRs of the
+ * waterfalls of all the OFDM, HT, VHT, HE and DSSS modes, and check the
+ * spot values of the NIST test case with the same tolerances.
+ */
+class WifiErrorRateModelsTestCaseTableBased : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTableBased ();
+  virtual ~WifiErrorRateModelsTestCaseTableBased ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare a table based model to its reference model.
+   *
+   * \param reference the reference model
+   */
+  void Compare (Ptr<ErrorRateModel> reference);
+};
+
+WifiErrorRateModelsTestCaseTableBased::WifiErrorRateModelsTestCaseTableBased ()
+  : TestCase ("WifiErrorRateModel test case table based")
+{
+}
+
+WifiErrorRateModelsTestCaseTableBased::~WifiErrorRateModelsTestCaseTableBased ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTableBased::Compare (Ptr<ErrorRateModel> reference)
+{
+  Ptr<TableBasedErrorRateModel> table = CreateObject<TableBasedErrorRateModel> ();
+  table->SetReferenceModel (reference);
+
+  WifiMode modes[] = {
+    WifiPhy::GetOfdmRate6Mbps (), WifiPhy::GetOfdmRate9Mbps (), WifiPhy::GetOfdmRate12Mbps (),
+    WifiPhy::GetOfdmRate18Mbps (), WifiPhy::GetOfdmRate24Mbps (), WifiPhy::GetOfdmRate36Mbps (),
+    WifiPhy::GetOfdmRate48Mbps (), WifiPhy::GetOfdmRate54Mbps (),
+    WifiPhy::GetHtMcs0 (), WifiPhy::GetHtMcs3 (), WifiPhy::GetHtMcs7 (),
+    WifiPhy::GetVhtMcs2 (), WifiPhy::GetVhtMcs6 (), WifiPhy::GetVhtMcs8 (),
+    WifiPhy::GetHeMcs1 (), WifiPhy::GetHeMcs5 (), WifiPhy::GetHeMcs10 (), WifiPhy::GetHeMcs11 (),
+    WifiPhy::GetDsssRate1Mbps (), WifiPhy::GetDsssRate2Mbps (),
+    WifiPhy::GetDsssRate5_5Mbps (), WifiPhy::GetDsssRate11Mbps ()
+  };
+  uint64_t sizes[] = {8, 100 * 8, 2000 * 8, 65535 * 8};
+  for (const WifiMode &mode : modes)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (mode);
+      txVector.SetChannelWidth (20);
+      for (double snrDb = -8; snrDb < 48; snrDb += 0.0137)
+        {
+          double snr = std::pow (10.0, snrDb / 10.0);
+          for (uint64_t nbits : sizes)
+            {
+              double expected = reference->GetChunkSuccessRate (mode, txVector, snr, nbits);
+              double ps = table->GetChunkSuccessRate (mode, txVector, snr, nbits);
+              NS_TEST_ASSERT_MSG_EQ_TOL (ps, expected, 1e-5, "Mode " << mode << ", SNR " << snrDb << " dB, " << nbits << " bits");
+              // The relative error of the exponent sets the one of the small success rates.
+              // Close to the SNRs at which the bit error rate reaches 1, the success rate
+              // of a bit falls too steeply to be interpolated, but the chunks are lost anyway.
+              if (expected < 0.5 && std::log (expected) / nbits > std::log (0.5))
+                {
+                  NS_TEST_ASSERT_MSG_EQ_TOL (std::log (ps) / std::log (expected), 1, 1e-3, "Mode " << mode << ", SNR " << snrDb << " dB, " << nbits << " bits");
+                }
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseTableBased::DoRun (void)
+{
+  Compare (CreateObject<NistErrorRateModel> ());
+  Compare (CreateObject<YansErrorRateModel> ());
+
+  // Spot test some values of the NIST test case, with a NIST reference model
+  uint32_t FrameSize = 2000;
+  WifiTxVector txVector;
+  Ptr<TableBasedErrorRateModel> table = CreateObject<TableBasedErrorRateModel> ();
+  double ps;
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate6Mbps"), txVector, std::pow (10.0, 2.5 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 2.04e-10, 1e-10, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate6Mbps"), txVector, std::pow (10.0, 4.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.885, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate9Mbps"), txVector, std::pow (10.0, 7.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.918, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate12Mbps"), txVector, std::pow (10.0, 7.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.881, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate18Mbps"), txVector, std::pow (10.0, 8.5 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 2.85e-6, 1e-6, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate18Mbps"), txVector, std::pow (10.0, 9.5 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.623, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate24Mbps"), txVector, std::pow (10.0, 13.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.495, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate36Mbps"), txVector, std::pow (10.0, 16.5 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.818, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate48Mbps"), txVector, std::pow (10.0, 21.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.649, 0.001, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate54Mbps"), txVector, std::pow (10.0, 21.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 5.44e-8, 1e-8, "Not equal within tolerance");
+  ps = table->GetChunkSuccessRate (WifiMode ("OfdmRate54Mbps"), txVector, std::pow (10.0, 22.0 / 10.0), FrameSize * 8);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.410, 0.001, "Not equal within tolerance");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -308,6 +424,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTableBased, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
@@ -30,14 +30,13 @@
 #include "ns3/wifi-mac-header.h"
 #include "ns3/wifi-mac-trailer.h"
 #include "ns3/ampdu-tag.h"
-#include "ns3/wifi-phy-tag.h"
+#include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/wifi-utils.h"
 #include "ns3/threshold-preamble-detection-model.h"
 #include "ns3/simple-frame-capture-model.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-mac-queue-item.h"
-#include "ns3/mpdu-aggregator.h"
 
 using namespace ns3;
 
@@ -70,17 +69,17 @@ protected:
   void SendPacket (double txPowerDbm);
   /**
    * Spectrum wifi receive success function
-   * \param p the packet
+   * \param psdu the PSDU
    * \param snr the SNR
    * \param txVector the transmit vector
    * \param statusPerMpdu reception status per MPDU
    */
-  void RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+  void RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
   /**
    * Spectrum wifi receive failure function
-   * \param p the packet
+   * \param psdu the PSDU
    */
-  void RxFailure (Ptr<Packet> p);
+  void RxFailure (Ptr<const WifiPsdu> psdu);
   uint32_t m_countRxSuccess; ///< count RX success
   uint32_t m_countRxFailure; ///< count RX failure
 
@@ -122,16 +121,14 @@ TestThresholdPreambleDetectionWithoutFrameCapture::SendPacket (double txPowerDbm
   Time txDuration = m_phy->CalculateTxDuration (size, txVector, m_phy->GetFrequency ());
   hdr.SetDuration (txDuration);
 
-  pkt->AddHeader (hdr);
-  pkt->AddTrailer (trailer);
-  WifiPhyTag tag (txVector, 1);
-  pkt->AddPacketTag (tag);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration);
   Ptr<SpectrumValue> txPowerSpectrum = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (FREQUENCY, CHANNEL_WIDTH, DbmToW (txPowerDbm), GUARD_WIDTH);
   Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
   txParams->psd = txPowerSpectrum;
   txParams->txPhy = 0;
   txParams->duration = txDuration;
-  txParams->packet = pkt;
+  txParams->ppdu = ppdu;
 
   m_phy->StartRx (txParams);
 }
@@ -155,16 +152,16 @@ TestThresholdPreambleDetectionWithoutFrameCapture::CheckRxPacketCount (uint32_t
 }
 
 void
-TestThresholdPreambleDetectionWithoutFrameCapture::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+TestThresholdPreambleDetectionWithoutFrameCapture::RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
 {
-  NS_LOG_FUNCTION (this << p << snr << txVector);
+  NS_LOG_FUNCTION (this << psdu << snr << txVector);
   m_countRxSuccess++;
 }
 
 void
-TestThresholdPreambleDetectionWithoutFrameCapture::RxFailure (Ptr<Packet> p)
+TestThresholdPreambleDetectionWithoutFrameCapture::RxFailure (Ptr<const WifiPsdu> psdu)
 {
-  NS_LOG_FUNCTION (this << p);
+  NS_LOG_FUNCTION (this << psdu);
   m_countRxFailure++;
 }
 
@@ -269,17 +266,17 @@ protected:
   void SendPacket (double txPowerDbm);
   /**
    * Spectrum wifi receive success function
-   * \param p the packet
+   * \param psdu the PSDU
    * \param snr the SNR
    * \param txVector the transmit vector
    * \param statusPerMpdu reception status per MPDU
    */
-  void RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+  void RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
   /**
    * Spectrum wifi receive failure function
-   * \param p the packet
+   * \param psdu the PSDU
    */
-  void RxFailure (Ptr<Packet> p);
+  void RxFailure (Ptr<const WifiPsdu> psdu);
   uint32_t m_countRxSuccess; ///< count RX success
   uint32_t m_countRxFailure; ///< count RX failure
   
@@ -321,16 +318,14 @@ TestThresholdPreambleDetectionWithFrameCapture::SendPacket (double txPowerDbm)
   Time txDuration = m_phy->CalculateTxDuration (size, txVector, m_phy->GetFrequency ());
   hdr.SetDuration (txDuration);
   
-  pkt->AddHeader (hdr);
-  pkt->AddTrailer (trailer);
-  WifiPhyTag tag (txVector, 1);
-  pkt->AddPacketTag (tag);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration);
   Ptr<SpectrumValue> txPowerSpectrum = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (FREQUENCY, CHANNEL_WIDTH, DbmToW (txPowerDbm), GUARD_WIDTH);
   Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
   txParams->psd = txPowerSpectrum;
   txParams->txPhy = 0;
   txParams->duration = txDuration;
-  txParams->packet = pkt;
+  txParams->ppdu = ppdu;
   
   m_phy->StartRx (txParams);
 }
@@ -354,16 +349,16 @@ TestThresholdPreambleDetectionWithFrameCapture::CheckRxPacketCount (uint32_t exp
 }
 
 void
-TestThresholdPreambleDetectionWithFrameCapture::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+TestThresholdPreambleDetectionWithFrameCapture::RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
 {
-  NS_LOG_FUNCTION (this << p << txVector);
+  NS_LOG_FUNCTION (this << psdu << txVector);
   m_countRxSuccess++;
 }
 
 void
-TestThresholdPreambleDetectionWithFrameCapture::RxFailure (Ptr<Packet> p)
+TestThresholdPreambleDetectionWithFrameCapture::RxFailure (Ptr<const WifiPsdu> psdu)
 {
-  NS_LOG_FUNCTION (this << p);
+  NS_LOG_FUNCTION (this << psdu);
   m_countRxFailure++;
 }
 
@@ -481,12 +476,12 @@ private:
   void SendPacket (double txPowerDbm, uint32_t packetSize);
   /**
    * Spectrum wifi receive success function
-   * \param p the packet
+   * \param psdu the PSDU
    * \param snr the SNR
    * \param txVector the transmit vector
    * \param statusPerMpdu reception status per MPDU
    */
-  void RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+  void RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
   /**
    * RX packet dropped function
    * \param p the packet
@@ -530,29 +525,27 @@ TestSimpleFrameCaptureModel::SendPacket (double txPowerDbm, uint32_t packetSize)
   Time txDuration = m_phy->CalculateTxDuration (size, txVector, m_phy->GetFrequency ());
   hdr.SetDuration (txDuration);
   
-  pkt->AddHeader (hdr);
-  pkt->AddTrailer (trailer);
-  WifiPhyTag tag (txVector, 1);
-  pkt->AddPacketTag (tag);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration);
   Ptr<SpectrumValue> txPowerSpectrum = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (FREQUENCY, CHANNEL_WIDTH, DbmToW (txPowerDbm), GUARD_WIDTH);
   Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
   txParams->psd = txPowerSpectrum;
   txParams->txPhy = 0;
   txParams->duration = txDuration;
-  txParams->packet = pkt;
+  txParams->ppdu = ppdu;
   
   m_phy->StartRx (txParams);
 }
 
 void
-TestSimpleFrameCaptureModel::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+TestSimpleFrameCaptureModel::RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
 {
-  NS_LOG_FUNCTION (this << p << snr << txVector);
-  if (p->GetSize () == 1030)
+  NS_LOG_FUNCTION (this << psdu << snr << txVector);
+  if (psdu->GetSize () == 1030)
     {
       m_rxSuccess1000B = true;
     }
-  else if (p->GetSize () == 1530)
+  else if (psdu->GetSize () == 1530)
     {
       m_rxSuccess1500B = true;
     }
@@ -692,17 +685,17 @@ private:
 
   /**
    * RX success function
-   * \param p the packet
+   * \param psdu the PSDU
    * \param snr the SNR
    * \param txVector the transmit vector
    * \param statusPerMpdu reception status per MPDU
    */
-  void RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+  void RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu);
   /**
    * RX failure function
-   * \param p the packet
+   * \param psdu the PSDU
    */
-  void RxFailure (Ptr<Packet> p);
+  void RxFailure (Ptr<const WifiPsdu> psdu);
   /**
    * RX dropped function
    * \param p the packet
@@ -808,15 +801,14 @@ TestAmpduReception::ResetBitmaps()
 }
 
 void
-TestAmpduReception::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+TestAmpduReception::RxSuccess (Ptr<const WifiPsdu> psdu, double snr, WifiTxVector txVector, std::vector<bool> statusPerMpdu)
 {
-  NS_LOG_FUNCTION (this << p << snr << txVector);
-  if (IsAmpdu (p))
+  NS_LOG_FUNCTION (this << psdu << snr << txVector);
+  if (psdu->IsAggregate ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (p);
-      NS_ABORT_MSG_IF (mpdus.size () != statusPerMpdu.size (), "Should have one receive status per MPDU");
+      NS_ABORT_MSG_IF (psdu->GetNMpdus () != statusPerMpdu.size (), "Should have one receive status per MPDU");
       auto rxOkForMpdu = statusPerMpdu.begin ();
-      for (const auto & mpdu : mpdus)
+      for (const auto & mpdu : *PeekPointer (psdu))
         {
           if (*rxOkForMpdu)
             {
@@ -831,7 +823,7 @@ TestAmpduReception::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector,
     }
   else
     {
-      IncrementSuccessBitmap (p->GetSize ());
+      IncrementSuccessBitmap (psdu->GetSize ());
     }
 }
 
@@ -865,20 +857,19 @@ TestAmpduReception::IncrementSuccessBitmap (uint32_t size)
 }
 
 void
-TestAmpduReception::RxFailure (Ptr<Packet> p)
+TestAmpduReception::RxFailure (Ptr<const WifiPsdu> psdu)
 {
-  NS_LOG_FUNCTION (this << p);
-  if (IsAmpdu (p))
+  NS_LOG_FUNCTION (this << psdu);
+  if (psdu->IsAggregate ())
     {
-      std::list<Ptr<const Packet>> mpdus = MpduAggregator::PeekMpdus (p);
-      for (const auto & mpdu : mpdus)
+      for (const auto & mpdu : *PeekPointer (psdu))
         {
           IncrementFailureBitmap (mpdu->GetSize ());
         }
     }
   else
     {
-      IncrementFailureBitmap (p->GetSize ());
+      IncrementFailureBitmap (psdu->GetSize ());
     }
 }
 
@@ -1007,16 +998,14 @@ TestAmpduReception::SendAmpduWithThreeMpdus (double txPowerDbm, uint32_t referen
   
   Time txDuration = m_phy->CalculateTxDuration (psdu->GetSize (), txVector, m_phy->GetFrequency ());
   psdu->SetDuration (txDuration);
-  Ptr<Packet> pkt = psdu->GetPacket ()->Copy ();
+  Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdu, txVector, txDuration);
 
-  WifiPhyTag tag (txVector, 1);
-  pkt->AddPacketTag (tag);
   Ptr<SpectrumValue> txPowerSpectrum = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (FREQUENCY, CHANNEL_WIDTH, DbmToW (txPowerDbm), GUARD_WIDTH);
   Ptr<WifiSpectrumSignalParameters> txParams = Create<WifiSpectrumSignalParameters> ();
   txParams->psd = txPowerSpectrum;
   txParams->txPhy = 0;
   txParams->duration = txDuration;
-  txParams->packet = pkt;
+  txParams->ppdu = ppdu;
   
   m_phy->StartRx (txParams);
 }
@@ -30,6 +30,7 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/test.h"
 #include "ns3/pointer.h"
 #include "ns3/rng-seed-manager.h"
@@ -41,10 +42,14 @@
 #include "ns3/spectrum-wifi-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
-#include "ns3/wifi-phy-tag.h"
+#include "ns3/wifi-ppdu.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/mgt-headers.h"
 #include "ns3/ht-configuration.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-psdu.h"
 
 using namespace ns3;
 
@@ -1387,14 +1392,7 @@ Bug2843TestCase::StoreDistinctTuple (std::string context,  Ptr<SpectrumSignalPar
 
   // Get channel bandwidth and modulation class
   Ptr<const WifiSpectrumSignalParameters> wifiTxParams = DynamicCast<WifiSpectrumSignalParameters> (txParams);
-  Ptr<Packet> packet = wifiTxParams->packet->Copy ();
-  WifiPhyTag tag;
-  if (!packet->RemovePacketTag (tag))
-    {
-      NS_FATAL_ERROR ("Received Wi-Fi Signal with no WifiPhyTag");
-      return;
-    }
-  WifiTxVector txVector = tag.GetWifiTxVector ();
+  WifiTxVector txVector = wifiTxParams->ppdu->GetTxVector ();
   uint16_t channelWidth = txVector.GetChannelWidth ();
   WifiModulationClass modulationClass = txVector.GetMode ().GetModulationClass ();
 
@@ -2158,6 +2156,444 @@ Bug2470TestCase::DoRun (void)
   // but before it does not enter RESET state. More tests should be written to verify all possible scenarios.
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the receivers beyond the MaxRange of a YansWifiChannel
+ * are skipped, and that the receivers in range, including those that
+ * moved into range, receive the same packets as without MaxRange.
+ *
+ * Node 0 broadcasts packets at 1s, 5s and 9.7s; node 1 is 30m away;
+ * node 2 is 1000m away until 4s, when it jumps 40m away; node 3 starts
+ * 1000m away and moves towards node 0 at 100m/s; node 4 is 150m away,
+ * within radio range but beyond a MaxRange of 100m; the PHY of node 5
+ * is given a mobility model 1000m away, which is replaced at 4s by a
+ * model 50m away.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+public:
+  YansWifiChannelMaxRangeTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Run the simulation.
+   * \param maxRange the MaxRange of the channel
+   * \returns the number of packets whose reception began at each node
+   */
+  std::vector<uint32_t> RunOne (double maxRange);
+  /**
+   * Send a broadcast packet.
+   * \param dev the sending device
+   */
+  void SendOnePacket (Ptr<NetDevice> dev);
+  /**
+   * Count a packet whose reception began.
+   * \param node the receiving node
+   * \param packet the packet
+   */
+  void RxBegin (uint32_t node, Ptr<const Packet> packet);
+
+  std::vector<uint32_t> m_received; ///< packets whose reception began at each node
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest ()
+  : TestCase ("Skip the receivers beyond the MaxRange of a YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelMaxRangeTest::SendOnePacket (Ptr<NetDevice> dev)
+{
+  dev->Send (Create<Packet> (100), dev->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelMaxRangeTest::RxBegin (uint32_t node, Ptr<const Packet> packet)
+{
+  m_received[node]++;
+}
+
+std::vector<uint32_t>
+YansWifiChannelMaxRangeTest::RunOne (double maxRange)
+{
+  NodeContainer nodes;
+  nodes.Create (6);
+  m_received.assign (nodes.GetN (), 0);
+
+  YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default ();
+  Ptr<YansWifiChannel> channel = channelHelper.Create ();
+  channel->SetMaxRange (maxRange);
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  // The mobility models are aggregated after the devices are created
+  double positions[] = {0, 30, 1000, 1000, 150, 1000};
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<MobilityModel> mobility;
+      Ptr<WifiNetDevice> dev = DynamicCast<WifiNetDevice> (devices.Get (i));
+      if (i == 3)
+        {
+          Ptr<ConstantVelocityMobilityModel> velocity = CreateObject<ConstantVelocityMobilityModel> ();
+          velocity->SetPosition (Vector (positions[i], 0.0, 0.0));
+          velocity->SetVelocity (Vector (-100.0, 0.0, 0.0));
+          mobility = velocity;
+        }
+      else
+        {
+          mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (Vector (positions[i], 0.0, 0.0));
+        }
+      if (i == 5)
+        {
+          dev->GetPhy ()->SetMobility (mobility);
+        }
+      else
+        {
+          nodes.Get (i)->AggregateObject (mobility);
+        }
+      dev->GetPhy ()->TraceConnectWithoutContext ("PhyRxBegin",
+                                                  MakeCallback (&YansWifiChannelMaxRangeTest::RxBegin, this).Bind (i));
+    }
+
+  Simulator::Schedule (Seconds (1.0), &YansWifiChannelMaxRangeTest::SendOnePacket, this, devices.Get (0));
+  Simulator::Schedule (Seconds (4.0), &MobilityModel::SetPosition,
+                       nodes.Get (2)->GetObject<MobilityModel> (), Vector (40.0, 0.0, 0.0));
+  Ptr<MobilityModel> replacement = CreateObject<ConstantPositionMobilityModel> ();
+  replacement->SetPosition (Vector (50.0, 0.0, 0.0));
+  Simulator::Schedule (Seconds (4.0), &WifiPhy::SetMobility,
+                       DynamicCast<WifiNetDevice> (devices.Get (5))->GetPhy (), replacement);
+  Simulator::Schedule (Seconds (5.0), &YansWifiChannelMaxRangeTest::SendOnePacket, this, devices.Get (0));
+  Simulator::Schedule (Seconds (9.7), &YansWifiChannelMaxRangeTest::SendOnePacket, this, devices.Get (0));
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_received;
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun (void)
+{
+  std::vector<uint32_t> all = RunOne (0);
+  std::vector<uint32_t> culled = RunOne (100);
+
+  NS_TEST_EXPECT_MSG_EQ (all[1], 3, "Node 1 should receive all the packets");
+  NS_TEST_EXPECT_MSG_EQ (all[2], 2, "Node 2 should receive the packets sent after it moved");
+  NS_TEST_EXPECT_MSG_EQ (all[3], 1, "Node 3 should only receive the last packet");
+  NS_TEST_EXPECT_MSG_EQ (all[5], 2, "Node 5 should receive the packets sent after its model was replaced");
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      if (i == 4)
+        {
+          continue;
+        }
+      NS_TEST_EXPECT_MSG_EQ (culled[i], all[i], "Node " << i << " should receive the same packets with MaxRange");
+    }
+  NS_TEST_EXPECT_MSG_EQ (culled[4], 0, "Node 4 should be beyond MaxRange");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the PER of the MPDU windows of an A-MPDU does not
+ * depend on the order in which the windows are evaluated.
+ *
+ * A 4ms HE PPDU is received with foreign signals starting and ending
+ * during its payload.  At the end of the PPDU, the PER of consecutive
+ * windows is computed in increasing order, which resumes from the
+ * position reached by the previous window, and in decreasing order,
+ * which walks the NI changes from the start of the event each time.
+ */
+class InterferenceHelperAmpduPerTest : public TestCase
+{
+public:
+  InterferenceHelperAmpduPerTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Compute the PER of the windows in both orders.
+   * \param event the received event
+   */
+  void CheckWindows (Ptr<Event> event);
+
+  InterferenceHelper m_interference; ///< the interference helper
+  double m_minPer; ///< the minimum PER of the windows
+  double m_maxPer; ///< the maximum PER of the windows
+};
+
+InterferenceHelperAmpduPerTest::InterferenceHelperAmpduPerTest ()
+  : TestCase ("Incremental PER of the MPDU windows of an A-MPDU"),
+    m_minPer (1),
+    m_maxPer (0)
+{
+}
+
+void
+InterferenceHelperAmpduPerTest::CheckWindows (Ptr<Event> event)
+{
+  const uint32_t nWindows = 40;
+  const Time windowDuration = MicroSeconds (90);
+  std::vector<double> increasing;
+  for (uint32_t i = 0; i < nWindows; i++)
+    {
+      std::pair<Time, Time> window (windowDuration * i, windowDuration * (i + 1));
+      increasing.push_back (m_interference.CalculatePayloadSnrPer (event, window).per);
+      // Evaluating a window twice resumes from the same position
+      NS_TEST_EXPECT_MSG_EQ (m_interference.CalculatePayloadSnrPer (event, window).per, increasing[i],
+                             "Different PER for window " << i << " evaluated twice");
+    }
+  for (uint32_t i = nWindows; i-- > 0; )
+    {
+      std::pair<Time, Time> window (windowDuration * i, windowDuration * (i + 1));
+      double per = m_interference.CalculatePayloadSnrPer (event, window).per;
+      NS_TEST_EXPECT_MSG_EQ (per, increasing[i], "Different PER for window " << i);
+      m_minPer = std::min (m_minPer, per);
+      m_maxPer = std::max (m_maxPer, per);
+    }
+}
+
+void
+InterferenceHelperAmpduPerTest::DoRun (void)
+{
+  m_interference.SetNoiseFigure (DbToRatio (7));
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  WifiTxVector txVector (WifiPhy::GetHeMcs7 (), 0, WIFI_PREAMBLE_HE_SU, 800, 1, 1, 0, 20, true, false);
+  Ptr<Event> event = m_interference.Add (Create<WifiPsdu> (Create<Packet> (1000), WifiMacHeader ()), txVector, MilliSeconds (4), DbmToW (-60));
+  m_interference.NotifyRxStart ();
+
+  // Foreign signals overlapping each other and the windows
+  double powers[] = {-85, -82, -88, -80, -84, -86};
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      Simulator::Schedule (MicroSeconds (100 + 550 * i), &InterferenceHelper::AddForeignSignal,
+                           &m_interference, MicroSeconds (300 + 150 * i), DbmToW (powers[i]));
+    }
+  Simulator::Schedule (MicroSeconds (2000), &InterferenceHelper::AddForeignSignal,
+                       &m_interference, MicroSeconds (90), DbmToW (-83));
+  Simulator::Schedule (MilliSeconds (4), &InterferenceHelperAmpduPerTest::CheckWindows, this, event);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_LT (m_minPer, m_maxPer, "The interference should change the PER of the windows");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the sub-queues of WifiMacQueue give the frames and the
+ * counts of a scan of the queue, and that the expired frames are dropped.
+ *
+ * Frames of several TIDs and receivers, and non-QoS frames, are enqueued,
+ * pushed to the front, inserted, dequeued and removed at random, and expire.
+ * After each operation, the frames peeked and counted for each (TID, receiver)
+ * pair are compared with the ones found by visiting the whole queue.  The
+ * frames dropped because their lifetime expired must be reported with the
+ * time at which it expired, and none must be left when the queue is counted.
+ */
+class WifiMacQueueSubQueuesTest : public TestCase
+{
+public:
+  WifiMacQueueSubQueuesTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /// Do a random operation on the queue, and check the sub-queues
+  void Step (void);
+  /**
+   * \param tid the TID of the frame
+   * \param receiver the receiver of the frame
+   * \param from the position the search starts from
+   * \return the first frame of the given TID and receiver which has not expired
+   */
+  WifiMacQueue::ConstIterator Find (uint8_t tid, Mac48Address receiver, WifiMacQueue::ConstIterator from) const;
+  /// \return the position of a random frame of the queue, or the end of the queue
+  WifiMacQueue::ConstIterator GetRandomPosition (void) const;
+  /// \return a new frame, of a random TID and receiver
+  Ptr<WifiMacQueueItem> CreateItem (void) const;
+  /**
+   * Notified when a frame is dropped because its lifetime expired.
+   * \param item the frame
+   * \param expiry the time at which the lifetime expired
+   */
+  void Expired (Ptr<const WifiMacQueueItem> item, Time expiry);
+
+  Ptr<WifiMacQueue> m_queue;            ///< the queue
+  Ptr<UniformRandomVariable> m_random;  ///< the random variable
+  std::vector<Mac48Address> m_receivers; ///< the receivers of the frames
+  uint32_t m_nSteps;                    ///< the number of remaining steps
+  uint32_t m_nExpired;                  ///< the number of expired frames
+};
+
+WifiMacQueueSubQueuesTest::WifiMacQueueSubQueuesTest ()
+  : TestCase ("Check the sub-queues and the expiry of WifiMacQueue"),
+    m_nSteps (3000),
+    m_nExpired (0)
+{
+}
+
+void
+WifiMacQueueSubQueuesTest::Expired (Ptr<const WifiMacQueueItem> item, Time expiry)
+{
+  NS_TEST_EXPECT_MSG_EQ (expiry, item->GetTimeStamp () + m_queue->GetMaxDelay (), "Wrong expiry time");
+  NS_TEST_EXPECT_MSG_LT (expiry, Simulator::Now (), "Frame dropped before its lifetime expired");
+  m_nExpired++;
+}
+
+Ptr<WifiMacQueueItem>
+WifiMacQueueSubQueuesTest::CreateItem (void) const
+{
+  WifiMacHeader hdr;
+  if (m_random->GetInteger (0, 9) == 0)
+    {
+      hdr.SetType (WIFI_MAC_DATA);
+    }
+  else
+    {
+      hdr.SetType (WIFI_MAC_QOSDATA);
+      hdr.SetQosTid (m_random->GetInteger (0, 3));
+    }
+  hdr.SetAddr1 (m_receivers[m_random->GetInteger (0, m_receivers.size () - 1)]);
+  return Create<WifiMacQueueItem> (Create<Packet> (100), hdr);
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueueSubQueuesTest::GetRandomPosition (void) const
+{
+  WifiMacQueue::ConstIterator it = m_queue->begin ();
+  for (uint32_t n = m_random->GetInteger (0, std::distance (m_queue->begin (), m_queue->end ())); n > 0; n--)
+    {
+      it++;
+    }
+  return it;
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueueSubQueuesTest::Find (uint8_t tid, Mac48Address receiver, WifiMacQueue::ConstIterator from) const
+{
+  for (WifiMacQueue::ConstIterator it = from; it != m_queue->end (); it++)
+    {
+      const WifiMacHeader &hdr = (*it)->GetHeader ();
+      if (hdr.IsQosData () && hdr.GetQosTid () == tid && hdr.GetAddr1 () == receiver
+          && Simulator::Now () <= (*it)->GetTimeStamp () + m_queue->GetMaxDelay ())
+        {
+          return it;
+        }
+    }
+  return m_queue->end ();
+}
+
+void
+WifiMacQueueSubQueuesTest::Step (void)
+{
+  uint8_t tid = m_random->GetInteger (0, 3);
+  Mac48Address receiver = m_receivers[m_random->GetInteger (0, m_receivers.size () - 1)];
+  switch (m_random->GetInteger (0, 9))
+    {
+    case 0:
+      m_queue->PushFront (CreateItem ());
+      break;
+    case 1:
+      m_queue->Insert (GetRandomPosition (), CreateItem ());
+      break;
+    case 2:
+      {
+        WifiMacQueue::ConstIterator expected = Find (tid, receiver, m_queue->begin ());
+        Ptr<const WifiMacQueueItem> item = (expected == m_queue->end () ? 0 : *expected);
+        NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (tid, receiver), item, "Wrong dequeued frame");
+        break;
+      }
+    case 3:
+      m_queue->Dequeue ();
+      break;
+    case 4:
+      {
+        WifiMacQueue::ConstIterator pos = GetRandomPosition ();
+        if (pos != m_queue->end ())
+          {
+            m_queue->Remove (pos, m_random->GetInteger (0, 1));
+          }
+        break;
+      }
+    default:
+      m_queue->Enqueue (CreateItem ());
+      break;
+    }
+
+  for (uint8_t t = 0; t < 4; t++)
+    {
+      for (Mac48Address address : m_receivers)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByTidAndAddress (t, address) == Find (t, address, m_queue->begin ())),
+                                 true, "Wrong peeked frame for TID " << +t << " and receiver " << address);
+          WifiMacQueue::ConstIterator from = GetRandomPosition ();
+          NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByTidAndAddress (t, address, from) == Find (t, address, from)),
+                                 true, "Wrong peeked frame from a position for TID " << +t << " and receiver " << address);
+          uint32_t count = 0;
+          for (WifiMacQueue::ConstIterator it = Find (t, address, m_queue->begin ()); it != m_queue->end ();
+               it = Find (t, address, ++it))
+            {
+              count++;
+            }
+          NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (t, address), count,
+                                 "Wrong number of frames for TID " << +t << " and receiver " << address);
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), std::distance (m_queue->begin (), m_queue->end ()),
+                         "Wrong number of frames");
+  for (WifiMacQueue::ConstIterator it = m_queue->begin (); it != m_queue->end (); it++)
+    {
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (Simulator::Now (), (*it)->GetTimeStamp () + m_queue->GetMaxDelay (),
+                                   "Expired frame left in the queue");
+    }
+
+  if (--m_nSteps > 0)
+    {
+      Simulator::Schedule (MicroSeconds (m_random->GetInteger (0, 100)), &WifiMacQueueSubQueuesTest::Step, this);
+    }
+}
+
+void
+WifiMacQueueSubQueuesTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxQueueSize (QueueSize ("100p"));
+  m_queue->SetMaxDelay (MilliSeconds (10));
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  for (uint8_t i = 1; i <= 5; i++)
+    {
+      m_receivers.push_back (Mac48Address::Allocate ());
+    }
+  m_queue->TraceConnectWithoutContext ("ExpiredAt", MakeCallback (&WifiMacQueueSubQueuesTest::Expired, this));
+  Simulator::ScheduleNow (&WifiMacQueueSubQueuesTest::Step, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_GT (m_nExpired, 0, "No frame expired");
+  m_queue = 0;
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2185,6 +2621,9 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug2831TestCase, TestCase::QUICK); //Bug 2831
   AddTestCase (new StaWifiMacScanningTestCase, TestCase::QUICK); //Bug 2399
   AddTestCase (new Bug2470TestCase, TestCase::QUICK); //Bug 2470
+  AddTestCase (new YansWifiChannelMaxRangeTest, TestCase::QUICK);
+  AddTestCase (new InterferenceHelperAmpduPerTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueSubQueuesTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -204,7 +204,7 @@ WifiOfdmMaskSlopesTestCase::DoRun (void)
   NS_LOG_FUNCTION (this);
   double currentPowerDbr = 0.0; //have to work in dBr so as to compare with expected slopes
   double maxPowerW = (*m_actualSpectrum)[0];
-  for (Values::const_iterator vit = m_actualSpectrum->ConstValuesBegin (); vit != m_actualSpectrum->ConstValuesEnd (); vit++)
+  for (SpectrumValue::ConstValuesIterator vit = m_actualSpectrum->ConstValuesBegin (); vit != m_actualSpectrum->ConstValuesEnd (); vit++)
     {
       maxPowerW = std::max (maxPowerW, *vit);
     }
@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+
+bool g_debug = false;
+
+std::string g_me;
+#define LOG(x)   std::cout << x << std::endl
+#define LOGME(x) LOG (g_me << x)
+#define DEB(x) if (g_debug) { LOGME (x); }
+
+// Output field width
+int g_fwidth = 6;
+
+/**
+ * The benchmark.  Reader threads, as the ones of a TapBridge or a
+ * FdNetDevice would, schedule events into a running simulation with
+ * Simulator::ScheduleWithContext, while the simulation thread runs a
+ * chain of local events.  The simulation stops when all the injected
+ * events have been run.
+ */
+class Bench
+{
+public:
+  /**
+   * Constructor
+   * \param threads the number of reader threads
+   * \param events the number of events scheduled by each reader thread
+   * \param work work iterations per local event
+   */
+  Bench (uint32_t threads, uint32_t events, uint32_t work)
+    : m_threads (threads),
+      m_events (events),
+      m_work (work),
+      m_received (0),
+      m_local (0),
+      m_sink (0)
+  {
+  }
+
+  /**
+   * Run the benchmark once.
+   * \param local whether to run a chain of local events
+   * \param inject the time taken by the slowest reader thread to
+   *        schedule its events, in seconds
+   * \return the run time, in seconds
+   */
+  double Run (bool local, double &inject);
+  /** \return the number of local events run */
+  uint64_t GetLocal (void) const
+  {
+    return m_local;
+  }
+
+private:
+  /** Start the reader threads, from the simulation. */
+  void Start (void);
+  /** Body of the reader threads. */
+  void Inject (void);
+  /** An injected event. */
+  void Received (void);
+  /** A local event. */
+  void Local (void);
+
+  uint32_t m_threads;    ///< number of reader threads
+  uint32_t m_events;     ///< events per reader thread
+  uint32_t m_work;       ///< work per local event
+  uint64_t m_received;   ///< injected events run
+  uint64_t m_local;      ///< local events run
+  uint32_t m_sink;       ///< result of the work
+  bool m_done;           ///< all the injected events have been run
+  std::vector<Ptr<SystemThread> > m_readers; ///< the reader threads
+  std::atomic<uint32_t> m_nextReader;        ///< index of the next reader thread
+  std::vector<double> m_injectTimes;         ///< time taken by each reader thread
+};
+
+double
+Bench::Run (bool local, double &inject)
+{
+  m_received = 0;
+  m_local = 0;
+  m_done = false;
+  m_nextReader = 0;
+  m_injectTimes.assign (m_threads, 0);
+  Simulator::Schedule (Seconds (0), &Bench::Start, this);
+  if (local)
+    {
+      Simulator::Schedule (Seconds (0), &Bench::Local, this);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  double simu = time.End () / 1000.0;
+
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_readers.begin (); i != m_readers.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_readers.clear ();
+  inject = *std::max_element (m_injectTimes.begin (), m_injectTimes.end ());
+  DEB ("run took " << simu << "s for " << m_received << " injected and "
+       << m_local << " local events");
+  return simu;
+}
+
+void
+Bench::Start (void)
+{
+  for (uint32_t i = 0; i < m_threads; ++i)
+    {
+      m_readers.push_back (Create<SystemThread> (MakeCallback (&Bench::Inject, this)));
+      m_readers.back ()->Start ();
+    }
+}
+
+void
+Bench::Inject (void)
+{
+  uint32_t reader = m_nextReader++;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < m_events; ++i)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (1), &Bench::Received, this);
+    }
+  m_injectTimes[reader] = time.End () / 1000.0;
+}
+
+void
+Bench::Received (void)
+{
+  if (++m_received == static_cast<uint64_t> (m_threads) * m_events)
+    {
+      m_done = true;
+      Simulator::Stop ();
+    }
+}
+
+void
+Bench::Local (void)
+{
+  if (m_done)
+    {
+      return;
+    }
+  ++m_local;
+  for (uint32_t i = 0; i < m_work; ++i)
+    {
+      m_sink = m_sink * 1664525 + 1013904223;
+    }
+  Simulator::Schedule (MicroSeconds (1), &Bench::Local, this);
+}
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t threads = 4;
+  uint32_t events  = 250000;
+  uint32_t work    = 100;
+  uint32_t runs    = 1;
+  bool realtime    = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the injection of events from other threads.\n"
+             "\n"
+             "Reader threads schedule events into the running simulation\n"
+             "with Simulator::ScheduleWithContext, as fast as they can,\n"
+             "while the simulation thread runs a chain of local events\n"
+             "(with the default simulator only).");
+  cmd.AddValue ("threads",  "number of reader threads",           threads);
+  cmd.AddValue ("events",   "events scheduled per reader thread", events);
+  cmd.AddValue ("work",     "work iterations per local event",    work);
+  cmd.AddValue ("runs",     "number of runs (default 1)",         runs);
+  cmd.AddValue ("realtime", "use the RealtimeSimulatorImpl",      realtime);
+  cmd.AddValue ("debug",    "enable debugging output",            g_debug);
+  cmd.AddValue ("prec",     "printed output precision",           g_fwidth);
+  cmd.Parse (argc, argv);
+  g_me = cmd.GetName () + ": ";
+  g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
+
+  if (realtime)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::RealtimeSimulatorImpl"));
+    }
+
+  LOGME (std::setprecision (g_fwidth - 6));
+  DEB ("debugging is ON");
+
+  LOGME ("simulator: " << (realtime ? "ns3::RealtimeSimulatorImpl" : "ns3::DefaultSimulatorImpl"));
+  LOGME ("reader threads: " << threads);
+  LOGME ("events per thread: " << events);
+  LOGME ("runs: " << runs);
+
+  LOG ("");
+  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+       std::left << std::setw (2 * g_fwidth) << "Injection:" <<
+       std::left << std::setw (3 * g_fwidth) << "Simulation:");
+  LOG (std::left << std::setw (g_fwidth) << "" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Local events");
+  LOG (std::setfill ('-') <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::setfill (' ')
+       );
+
+  Bench bench (threads, events, work);
+  double total = static_cast<double> (threads) * events;
+  for (uint32_t i = 0; i < runs; i++)
+    {
+      double inject;
+      double simu = bench.Run (!realtime, inject);
+      LOG (std::left << std::setw (g_fwidth) << i <<
+           std::left << std::setw (g_fwidth) << inject <<
+           std::left << std::setw (g_fwidth) << (total / inject) <<
+           std::left << std::setw (g_fwidth) << simu <<
+           std::left << std::setw (g_fwidth) << (total / simu) <<
+           std::left << std::setw (g_fwidth) << bench.GetLocal ());
+    }
+
+  LOG ("");
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+
+bool g_debug = false;
+
+std::string g_me;
+#define LOG(x)   std::cout << x << std::endl
+#define LOGME(x) LOG (g_me << x)
+#define DEB(x) if (g_debug) { LOGME (x); }
+
+// Output field width
+int g_fwidth = 6;
+
+/**
+ * A context (node) of the benchmark.  Each context runs a chain of
+ * events; each event burns some CPU and, with a given probability,
+ * hands the chain over to another context, as a transmission on a
+ * channel would.  All the state touched by an event belongs to the
+ * context which runs it.
+ */
+class BenchContext
+{
+public:
+  /**
+   * Constructor
+   * \param id the context id
+   * \param peers the number of contexts
+   */
+  BenchContext (uint32_t id, uint32_t peers)
+    : m_id (id),
+      m_peers (peers),
+      m_count (0),
+      m_sink (0)
+  {
+    m_interval = CreateObject<ExponentialRandomVariable> ();
+    m_interval->SetAttribute ("Mean", DoubleValue (100));
+    m_uniform = CreateObject<UniformRandomVariable> ();
+    // Same workload whatever the simulator implementation.
+    m_interval->SetStream (2 * id);
+    m_uniform->SetStream (2 * id + 1);
+  }
+
+  /**
+   * Start an event chain.
+   * \param at the time of the first event
+   */
+  void Start (Time at)
+  {
+    Simulator::ScheduleWithContext (m_id, at, &BenchContext::Cb, this);
+  }
+
+  /** \return the number of events processed by this context */
+  uint32_t GetCount (void) const
+  {
+    return m_count;
+  }
+
+  static std::vector<BenchContext *> g_contexts; ///< all the contexts
+  static uint32_t g_total;      ///< events to run per context
+  static uint32_t g_work;       ///< work per event
+  static double g_remote;       ///< probability of a remote event
+  static Time g_lookahead;      ///< delay of the remote events
+
+private:
+  /// callback function
+  void Cb (void)
+  {
+    if (m_count >= g_total)
+      {
+        return;
+      }
+    ++m_count;
+    for (uint32_t i = 0; i < g_work; ++i)
+      {
+        m_sink = m_sink * 1664525 + 1013904223;
+      }
+    Time after = NanoSeconds (m_interval->GetValue ());
+    if (m_uniform->GetValue () < g_remote)
+      {
+        uint32_t peer = m_uniform->GetInteger (0, m_peers - 1);
+        Simulator::ScheduleWithContext (peer, g_lookahead + after, &BenchContext::Cb, g_contexts[peer]);
+      }
+    else
+      {
+        Simulator::Schedule (after, &BenchContext::Cb, this);
+      }
+  }
+
+  uint32_t m_id;      ///< context id
+  uint32_t m_peers;   ///< number of contexts
+  uint32_t m_count;   ///< events processed
+  uint32_t m_sink;    ///< result of the work
+  Ptr<ExponentialRandomVariable> m_interval;  ///< event interval
+  Ptr<UniformRandomVariable> m_uniform;       ///< remote event draws
+};
+
+std::vector<BenchContext *> BenchContext::g_contexts;
+uint32_t BenchContext::g_total = 0;
+uint32_t BenchContext::g_work = 0;
+double BenchContext::g_remote = 0;
+Time BenchContext::g_lookahead;
+
+/**
+ * Run the benchmark once.
+ * \param simulatorType the simulator implementation
+ * \param threads the number of threads
+ * \param contexts the number of contexts
+ * \param chains the number of event chains per context
+ * \param events the number of events processed
+ * \return the run time, in seconds
+ */
+double
+RunBench (std::string simulatorType, uint32_t threads, uint32_t contexts, uint32_t chains, uint64_t &events)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (threads));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (BenchContext::g_lookahead));
+
+  for (uint32_t i = 0; i < contexts; ++i)
+    {
+      BenchContext::g_contexts.push_back (new BenchContext (i, contexts));
+    }
+  for (uint32_t i = 0; i < contexts; ++i)
+    {
+      for (uint32_t j = 0; j < chains; ++j)
+        {
+          BenchContext::g_contexts[i]->Start (NanoSeconds (j));
+        }
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  double simu = time.End () / 1000.0;
+
+  events = Simulator::GetEventCount ();
+  DEB ("run took " << simu << "s for " << events << " events");
+  Simulator::Destroy ();
+  for (uint32_t i = 0; i < contexts; ++i)
+    {
+      delete BenchContext::g_contexts[i];
+    }
+  BenchContext::g_contexts.clear ();
+  return simu;
+}
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t contexts = 256;
+  uint32_t chains   =   4;
+  uint32_t total    = 4000;
+  uint32_t work     = 1000;
+  uint32_t maxThreads = 8;
+  double remote     = 0.1;
+  double lookahead  = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the scaling of the multithreaded simulator.\n"
+             "\n"
+             "Each context runs event chains with exponential intervals\n"
+             "(mean 100 ns); each event performs a fixed amount of work and\n"
+             "hands its chain over to a random context with a given probability,\n"
+             "after at least the lookahead.  The same workload is run with the\n"
+             "default simulator and then with 1, 2, 4... threads.");
+  cmd.AddValue ("contexts",  "number of contexts (nodes)",             contexts);
+  cmd.AddValue ("chains",    "event chains per context",               chains);
+  cmd.AddValue ("total",     "events to run per context",              total);
+  cmd.AddValue ("work",      "work iterations per event",              work);
+  cmd.AddValue ("remote",    "probability of a remote event",          remote);
+  cmd.AddValue ("lookahead", "lookahead, in ns",                       lookahead);
+  cmd.AddValue ("threads",   "maximum number of threads",              maxThreads);
+  cmd.AddValue ("debug",     "enable debugging output",                g_debug);
+  cmd.AddValue ("prec",      "printed output precision",               g_fwidth);
+  cmd.Parse (argc, argv);
+  g_me = cmd.GetName () + ": ";
+  g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
+
+  BenchContext::g_total = total;
+  BenchContext::g_work = work;
+  BenchContext::g_remote = remote;
+  BenchContext::g_lookahead = NanoSeconds (lookahead);
+
+  LOGME (std::setprecision (g_fwidth - 6));
+  DEB ("debugging is ON");
+
+  LOGME ("contexts: " << contexts);
+  LOGME ("chains per context: " << chains);
+  LOGME ("events per context: " << total);
+  LOGME ("work per event: " << work);
+  LOGME ("remote probability: " << remote);
+  LOGME ("lookahead: " << BenchContext::g_lookahead);
+
+  LOG ("");
+  LOG (std::left << std::setw (g_fwidth) << "Threads" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Speedup");
+  LOG (std::setfill ('-') <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::setfill (' ')
+       );
+
+  uint64_t events;
+  double reference = RunBench ("ns3::DefaultSimulatorImpl", 1, contexts, chains, events);
+  LOG (std::left << std::setw (g_fwidth) << "default" <<
+       std::left << std::setw (g_fwidth) << reference <<
+       std::left << std::setw (g_fwidth) << (events / reference) <<
+       std::left << std::setw (g_fwidth) << 1.0);
+
+  for (uint32_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+      double simu = RunBench ("ns3::MultithreadedSimulatorImpl", threads, contexts, chains, events);
+      LOG (std::left << std::setw (g_fwidth) << threads <<
+           std::left << std::setw (g_fwidth) << simu <<
+           std::left << std::setw (g_fwidth) << (events / simu) <<
+           std::left << std::setw (g_fwidth) << (reference / simu));
+    }
+
+  LOG ("");
+  return 0;
+}
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of Object::GetObject on groups of
+// aggregated objects, as the nodes of a simulation are: each group holds
+// 'n' objects of distinct types, which are looked up through the
+// interface they implement, as Node::GetObject<Ipv4> finds the
+// Ipv4L3Protocol, in a pseudo-random order.  Lookups of a type which is
+// not aggregated, as GetObject<Ipv6> on an IPv4-only node, are measured
+// separately.
+//
+// Sample usage:  ./waf --run 'bench-object --lookups=10000000'
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/// The maximum number of objects in a group
+static const uint32_t MAX_AGGREGATES = 16;
+
+/**
+ * The interface looked up by the benchmark.
+ * \tparam N the index of the type
+ */
+template <int N>
+class BenchInterface : public Object
+{
+public:
+  /**
+   * Get the name of this type.
+   * \return the name.
+   */
+  static std::string GetName (void)
+  {
+    std::ostringstream oss;
+    oss << "anon::BenchInterface<" << N << ">";
+    return oss.str ();
+  }
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId (GetName ().c_str ())
+      .SetParent<Object> ()
+      .SetGroupName ("Utils")
+      .HideFromDocumentation ()
+    ;
+    return tid;
+  }
+};
+
+/**
+ * The aggregated objects, which implement the interface.
+ * \tparam N the index of the type
+ */
+template <int N>
+class BenchObject : public BenchInterface<N>
+{
+public:
+  /**
+   * Get the name of this type.
+   * \return the name.
+   */
+  static std::string GetName (void)
+  {
+    std::ostringstream oss;
+    oss << "anon::BenchObject<" << N << ">";
+    return oss.str ();
+  }
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId (GetName ().c_str ())
+      .template SetParent<BenchInterface<N> > ()
+      .SetGroupName ("Utils")
+      .HideFromDocumentation ()
+      .template AddConstructor<BenchObject<N> > ()
+    ;
+    return tid;
+  }
+};
+
+/// A function creating an object
+typedef Ptr<Object> (*Creator) (void);
+/// A function looking up an interface in a group of objects
+typedef Object * (*Finder) (Ptr<Object> object);
+
+/**
+ * Create an object.
+ * \tparam N the index of the type
+ * \returns the object
+ */
+template <int N>
+Ptr<Object>
+Create (void)
+{
+  return CreateObject<BenchObject<N> > ();
+}
+
+/**
+ * Look up an interface.
+ * \tparam N the index of the type
+ * \param object an object of the group
+ * \returns the object implementing the interface, if any
+ */
+template <int N>
+Object *
+Find (Ptr<Object> object)
+{
+  return PeekPointer (object->GetObject<BenchInterface<N> > ());
+}
+
+/// The functions creating the objects of each type
+static Creator g_creators[MAX_AGGREGATES] = {
+  &Create<0>, &Create<1>, &Create<2>, &Create<3>,
+  &Create<4>, &Create<5>, &Create<6>, &Create<7>,
+  &Create<8>, &Create<9>, &Create<10>, &Create<11>,
+  &Create<12>, &Create<13>, &Create<14>, &Create<15>
+};
+
+/// The functions looking up each interface
+static Finder g_finders[MAX_AGGREGATES] = {
+  &Find<0>, &Find<1>, &Find<2>, &Find<3>,
+  &Find<4>, &Find<5>, &Find<6>, &Find<7>,
+  &Find<8>, &Find<9>, &Find<10>, &Find<11>,
+  &Find<12>, &Find<13>, &Find<14>, &Find<15>
+};
+
+/**
+ * Run the lookups, and print their cost.
+ * \param groups the number of groups
+ * \param n the number of objects in each group
+ * \param lookups the number of lookups
+ * \param miss whether to look up an interface which is not aggregated
+ */
+static void
+RunBench (uint32_t groups, uint32_t n, uint32_t lookups, bool miss)
+{
+  std::vector<Ptr<Object> > objects;
+  for (uint32_t i = 0; i < groups; i++)
+    {
+      Ptr<Object> object = g_creators[0] ();
+      for (uint32_t j = 1; j < n; j++)
+        {
+          object->AggregateObject (g_creators[j] ());
+        }
+      objects.push_back (object);
+    }
+
+  uint32_t state = 1;
+  uint32_t found = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      state = state * 1103515245 + 12345;
+      Ptr<Object> object = objects[(state >> 8) % groups];
+      uint32_t type = miss ? n : (state >> 20) % n;
+      if (g_finders[type] (object) != 0)
+        {
+          found++;
+        }
+    }
+  int64_t ms = time.End ();
+  NS_ABORT_MSG_UNLESS (found == (miss ? 0 : lookups), "Unexpected lookup result");
+
+  for (uint32_t i = 0; i < groups; i++)
+    {
+      objects[i]->Dispose ();
+    }
+  std::cout << n << " aggregates, " << (miss ? "missing" : "aggregated") << " type: "
+            << static_cast<double> (ms) * 1e6 / lookups << " ns per GetObject"
+            << " (" << ms << " ms elapsed)" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t groups = 100;
+  uint32_t lookups = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Object::GetObject");
+  cmd.AddValue ("groups", "number of groups of aggregated objects", groups);
+  cmd.AddValue ("lookups", "number of lookups per measure", lookups);
+  cmd.Parse (argc, argv);
+
+  uint32_t sizes[] = {1, 5, 10, 15};
+  for (uint32_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++)
+    {
+      RunBench (groups, sizes[i], lookups, false);
+      RunBench (groups, sizes[i], lookups, true);
+    }
+  return 0;
+}
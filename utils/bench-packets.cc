@@ -32,6 +32,7 @@
 #include <stdlib.h> // for exit ()
 #include <limits>
 #include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -328,6 +329,61 @@ benchByteTags (uint32_t n)
     }
 }
 
+/// The size of the packets of benchAllocation
+static uint32_t g_allocationSize;
+
+static void
+benchAllocation (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  std::vector<uint8_t> payload (g_allocationSize);
+
+  for (uint32_t i = 0; i < n; i++) {
+    // The payload is stored in the buffers, and copied when the headers are added
+    Ptr<Packet> p = Create<Packet> (&payload[0], g_allocationSize);
+    Ptr<Packet> c = p->Copy ();
+    c->AddHeader (udp);
+    c->AddHeader (ipv4);
+    c->RemoveHeader (ipv4);
+    c->RemoveHeader (udp);
+    Ptr<Packet> q = Create<Packet> (&payload[0], g_allocationSize);
+    q->AddAtEnd (c);
+  }
+}
+
+static void
+benchWifiTags (uint32_t n)
+{
+  // The tags of a Wi-Fi MPDU, with their serialized sizes
+  BenchTag<4> flowId;
+  BenchTag<1> qos;
+  BenchTag<12> flowProbe;
+  BenchTag<9> ampdu;
+  BenchTag<25> wifiPhy;
+  BenchTag<8> snr;
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (1500);
+    p->AddPacketTag (flowId);
+    p->AddByteTag (flowProbe);
+    p->AddPacketTag (qos);
+    // The MAC keeps the MPDU for retransmission and sends a copy
+    Ptr<Packet> tx = p->Copy ();
+    tx->AddPacketTag (ampdu);
+    tx->AddPacketTag (wifiPhy);
+    // The receivers get a copy each
+    for (uint32_t j = 0; j < 2; j++) {
+      Ptr<Packet> rx = tx->Copy ();
+      rx->RemovePacketTag (wifiPhy);
+      rx->RemovePacketTag (ampdu);
+      rx->AddPacketTag (snr);
+      rx->RemovePacketTag (snr);
+      rx->RemovePacketTag (qos);
+    }
+  }
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -386,5 +442,29 @@ int main (int argc, char *argv[])
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
 
+  std::cout << "Allocation of packets with real payloads:" << std::endl;
+  uint32_t sizes[] = {64, 512, 1500, 9000, 65000};
+  for (uint32_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++)
+    {
+      g_allocationSize = sizes[i];
+      DataPool::Stats buffers = Buffer::GetPoolStats ();
+      DataPool::Stats metadata = PacketMetadata::GetPoolStats ();
+      std::ostringstream oss;
+      oss << g_allocationSize << " bytes";
+      runBench (&benchAllocation, n, minIterations, oss.str ().c_str ());
+      DataPool::Stats buffersEnd = Buffer::GetPoolStats ();
+      DataPool::Stats metadataEnd = PacketMetadata::GetPoolStats ();
+      buffersEnd.hits -= buffers.hits;
+      buffersEnd.misses -= buffers.misses;
+      metadataEnd.hits -= metadata.hits;
+      metadataEnd.misses -= metadata.misses;
+      std::cout << "  buffer pool: hit rate " << buffersEnd.GetHitRate ()
+                << ", " << buffersEnd.retainedBytes << " bytes retained"
+                << "; metadata pool: hit rate " << metadataEnd.GetHitRate ()
+                << ", " << metadataEnd.retainedBytes << " bytes retained" << std::endl;
+    }
+
+  runBench (&benchWifiTags, n, minIterations, "Add and remove Wi-Fi tags");
+
   return 0;
 }
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts a binary trace file, written by the default trace
+// sinks to a stream created by AsciiTraceHelper::CreateBinaryFileStream,
+// to text.
+//
+// With --format=ascii (the default), each event is printed on a line as in
+// the ASCII trace files: the type of the event, its time in seconds, the
+// trace context and the string describing the event if any, followed by
+// the UID and the size of the packet instead of its printed headers, and
+// its stored bytes in hexadecimal.
+//
+// With --format=csv, the events are printed as comma-separated values,
+// with the time in seconds, and the node and device parsed from the
+// context.
+//
+// Sample usage:  ./waf --run 'decode-binary-trace --input=trace.bt --format=csv'
+
+#include "ns3/command-line.h"
+#include "ns3/binary-trace-file.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Print the stored bytes of a packet in hexadecimal.
+ * \param os the output stream
+ * \param bytes the bytes
+ */
+static void
+PrintBytes (std::ostream &os, const std::vector<uint8_t> &bytes)
+{
+  std::ios::fmtflags flags = os.flags ();
+  char fill = os.fill ('0');
+  os << std::hex;
+  for (std::vector<uint8_t>::const_iterator it = bytes.begin (); it != bytes.end (); it++)
+    {
+      os << std::setw (2) << static_cast<uint32_t> (*it);
+    }
+  os.flags (flags);
+  os.fill (fill);
+}
+
+/**
+ * Print an index of a record, or nothing if it is absent.
+ * \param os the output stream
+ * \param index the index
+ */
+static void
+PrintIndex (std::ostream &os, uint32_t index)
+{
+  if (index != BinaryTraceFile::NONE)
+    {
+      os << index;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  std::string format = "ascii";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "The binary trace file", input);
+  cmd.AddValue ("output", "The text file (standard output if empty)", output);
+  cmd.AddValue ("format", "The output format: ascii or csv", format);
+  cmd.Parse (argc, argv);
+
+  if (format != "ascii" && format != "csv")
+    {
+      std::cerr << "Unknown format " << format << std::endl;
+      exit (1);
+    }
+  std::ifstream is (input.c_str (), std::ios::in | std::ios::binary);
+  if (!is.is_open ())
+    {
+      std::cerr << "Unable to open " << input << std::endl;
+      exit (1);
+    }
+  BinaryTraceFile file;
+  if (!file.ReadHeader (&is))
+    {
+      std::cerr << input << " is not a binary trace file of version "
+                << BinaryTraceFile::VERSION_MAJOR << " written on this host" << std::endl;
+      exit (1);
+    }
+  std::ofstream ofs;
+  if (!output.empty ())
+    {
+      ofs.open (output.c_str ());
+      if (!ofs.is_open ())
+        {
+          std::cerr << "Unable to open " << output << std::endl;
+          exit (1);
+        }
+    }
+  std::ostream &os = output.empty () ? std::cout : ofs;
+
+  if (format == "csv")
+    {
+      os << "type,time,node,device,context,info,uid,size,data" << std::endl;
+    }
+  BinaryTraceFile::Record record;
+  std::vector<uint8_t> bytes;
+  while (file.Read (&is, record, bytes))
+    {
+      double seconds = record.time / 1e9;
+      if (format == "ascii")
+        {
+          os << static_cast<char> (record.type) << " " << seconds << " ";
+          if (record.context != BinaryTraceFile::NONE)
+            {
+              os << file.GetString (record.context) << " ";
+            }
+          if (record.info != BinaryTraceFile::NONE)
+            {
+              os << file.GetString (record.info) << " ";
+            }
+          os << "uid=" << record.uid << " size=" << record.size;
+          if (!bytes.empty ())
+            {
+              os << " data=";
+              PrintBytes (os, bytes);
+            }
+        }
+      else
+        {
+          os << static_cast<char> (record.type) << ","
+             << std::fixed << std::setprecision (9) << seconds << ",";
+          PrintIndex (os, record.node);
+          os << ",";
+          PrintIndex (os, record.device);
+          os << "," << file.GetString (record.context)
+             << "," << file.GetString (record.info)
+             << "," << record.uid << "," << record.size << ",";
+          PrintBytes (os, bytes);
+        }
+      os << "\n";
+    }
+  if (is.gcount () != 0)
+    {
+      std::cerr << input << " is truncated" << std::endl;
+      exit (1);
+    }
+  os.flush ();
+  return 0;
+}